@@ -0,0 +1,80 @@
+#pragma once
+
+// Small helpers shared by the benchmarks: a wall clock, an arena over malloc, the fonts they
+// load and the recorded glyph sizes. Each benchmark is one program that prints a table and returns.
+
+#include "../src/ntext.h"
+#include "glyph_sizes.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef NTEXT_BENCH_FONT_DIR
+    #define NTEXT_BENCH_FONT_DIR "/usr/share/fonts/truetype/dejavu/"
+#endif
+
+namespace ntext
+{
+
+static double
+GetBenchSeconds(void)
+{
+    timespec Time = {};
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+
+    double Result = static_cast<double>(Time.tv_sec) + static_cast<double>(Time.tv_nsec) * 1e-9;
+    return Result;
+}
+
+
+static memory_arena *
+CreateBenchArena(uint64_t Size)
+{
+    memory_arena *Result = static_cast<memory_arena *>(malloc(Size));
+    if(Result)
+    {
+        Result->Reserved     = Size;
+        Result->BasePosition = 0;
+        Result->Position     = sizeof(memory_arena);
+    }
+
+    return Result;
+}
+
+
+// Keeps the optimizer from dropping work whose result is otherwise unused.
+
+static volatile uint64_t BenchSink;
+
+static void
+ConsumeBenchValue(uint64_t Value)
+{
+    BenchSink = BenchSink + Value;
+}
+
+// Draws Count atlas rectangles from the recorded glyph sizes (glyph_sizes.h), in the random
+// order text would ask for them. The same Seed gives the same rectangles.
+
+static void
+SampleGlyphSizes(packed_rectangle *Rectangles, uint32_t Count, uint64_t Seed)
+{
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        Seed ^= Seed << 13;
+        Seed ^= Seed >> 7;
+        Seed ^= Seed << 17;
+
+        uint32_t Target = static_cast<uint32_t>((Seed >> 11) % GlyphSizeGlyphCount);
+        uint32_t Bin    = 0;
+        while(Target >= GlyphSizeBins[Bin].Count)
+        {
+            Target -= GlyphSizeBins[Bin].Count;
+            Bin    += 1;
+        }
+
+        Rectangles[Idx] = {.Width = GlyphSizeBins[Bin].Width, .Height = GlyphSizeBins[Bin].Height};
+    }
+}
+
+} // namespace ntext
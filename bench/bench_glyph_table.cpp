@@ -0,0 +1,149 @@
+// Probe counts and lookup cost of the glyph table for each group width, at load factors up to
+// the table's capacity (7/8 of the slots). Hits look up keys that are in the table, misses keys
+// that are not. Probe counts are groups looked at per lookup (glyph_probe::GroupCount).
+// Usage: bench_glyph_table [slot count, a power of two, default 65536]
+
+#include "bench.h"
+
+using namespace ntext;
+
+struct probe_stats
+{
+    double   Mean;
+    uint32_t P99;
+    uint32_t Max;
+    double   Nanoseconds;
+};
+
+
+static probe_stats
+MeasureProbes(glyph_hash *Hashes, uint32_t Count, glyph_table *Table, bool ExpectHit, uint32_t *Histogram, uint32_t HistogramSize)
+{
+    probe_stats Result = {};
+
+    memset(Histogram, 0, HistogramSize * sizeof(uint32_t));
+
+    uint64_t Total = 0;
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        glyph_probe Probe = ProbeGlyphTable(Hashes[Idx], Table);
+        NTEXT_ASSERT((Probe.EntryIndex != GlyphTableInvalidEntry) == ExpectHit);
+
+        uint32_t Groups = Probe.GroupCount < HistogramSize ? Probe.GroupCount : HistogramSize - 1;
+        Histogram[Groups] += 1;
+        Total             += Probe.GroupCount;
+        Result.Max         = Probe.GroupCount > Result.Max ? Probe.GroupCount : Result.Max;
+    }
+
+    Result.Mean = static_cast<double>(Total) / Count;
+
+    uint32_t Seen = 0;
+    for(uint32_t Groups = 0; Groups < HistogramSize; ++Groups)
+    {
+        Seen += Histogram[Groups];
+        if(Seen * 100ull >= Count * 99ull)
+        {
+            Result.P99 = Groups;
+            break;
+        }
+    }
+
+    // Best of a few passes over the same keys.
+    Result.Nanoseconds = 1e30;
+    for(uint32_t Pass = 0; Pass < 5; ++Pass)
+    {
+        uint64_t Sink  = 0;
+        double   Start = GetBenchSeconds();
+
+        for(uint32_t Idx = 0; Idx < Count; ++Idx)
+        {
+            glyph_probe Probe = ProbeGlyphTable(Hashes[Idx], Table);
+            Sink += ExpectHit ? Probe.EntryIndex : Probe.FreeIndex;
+        }
+
+        double Elapsed = (GetBenchSeconds() - Start) * 1e9 / Count;
+        Result.Nanoseconds = Elapsed < Result.Nanoseconds ? Elapsed : Result.Nanoseconds;
+
+        ConsumeBenchValue(Sink);
+    }
+
+    return Result;
+}
+
+
+int main(int ArgCount, char **Args)
+{
+    uint32_t SlotCount = ArgCount > 1 ? static_cast<uint32_t>(atoi(Args[1])) : 65536;
+
+    GlyphTableWidth Widths[]      = {GlyphTableWidth::_128Bits, GlyphTableWidth::_256Bits, GlyphTableWidth::_512Bits};
+    float           LoadFactors[] = {0.5f, 0.75f, 0.8125f, 0.875f};
+
+    // Twice the largest load: the first half goes in the table, the second half misses.
+    uint32_t    KeyCount = SlotCount * 2;
+    glyph_hash *Hashes   = static_cast<glyph_hash *>(aligned_alloc(16, KeyCount * sizeof(glyph_hash)));
+    for(uint32_t Idx = 0; Idx < KeyCount; ++Idx)
+    {
+        Hashes[Idx] = ComputeSingleGlyphHash(0x20 + Idx, 0x0000000C00000001ull, DefaultSeed);
+    }
+
+    uint32_t Histogram[64];
+
+    printf("%u slots\n", SlotCount);
+    printf("%6s %5s | %6s %4s %4s %8s | %6s %4s %4s %8s | %8s\n", "load", "width",
+           "hit", "p99", "max", "ns", "miss", "p99", "max", "ns", "ns/find");
+
+    for(float Load : LoadFactors)
+    {
+        for(GlyphTableWidth Width : Widths)
+        {
+            if(!IsGlyphTableWidthSupported(Width))
+            {
+                printf("%6.3f %5u | not supported by this CPU\n", Load, static_cast<uint32_t>(Width) * 8);
+                continue;
+            }
+
+            glyph_table_params Params = {.GroupWidth = Width, .GroupCount = SlotCount / static_cast<uint64_t>(Width)};
+
+            void        *Memory = aligned_alloc(64, NTEXT_ALIGNPOW2(GetGlyphTableFootprint(Params), 64));
+            glyph_table *Table  = PlaceGlyphTableInMemory(Params, Memory);
+
+            uint32_t Count = static_cast<uint32_t>(SlotCount * Load);
+            Count = Count < Table->Capacity ? Count : Table->Capacity;
+
+            for(uint32_t Idx = 0; Idx < Count; ++Idx)
+            {
+                FindGlyphEntryByHash(Hashes[Idx], Table);
+            }
+
+            probe_stats Hit  = MeasureProbes(Hashes, Count, Table, true, Histogram, 64);
+            probe_stats Miss = MeasureProbes(Hashes + SlotCount, Count, Table, false, Histogram, 64);
+
+            // The full lookup a hit in FillAtlas pays, LRU update included.
+            double Find = 1e30;
+            for(uint32_t Pass = 0; Pass < 5; ++Pass)
+            {
+                uint64_t Sink  = 0;
+                double   Start = GetBenchSeconds();
+
+                for(uint32_t Idx = 0; Idx < Count; ++Idx)
+                {
+                    Sink += FindGlyphEntryByHash(Hashes[Idx], Table).Id;
+                }
+
+                double Elapsed = (GetBenchSeconds() - Start) * 1e9 / Count;
+                Find = Elapsed < Find ? Elapsed : Find;
+
+                ConsumeBenchValue(Sink);
+            }
+
+            printf("%6.3f %5u | %6.3f %4u %4u %8.2f | %6.3f %4u %4u %8.2f | %8.2f\n", Load, static_cast<uint32_t>(Width) * 8,
+                   Hit.Mean, Hit.P99, Hit.Max, Hit.Nanoseconds, Miss.Mean, Miss.P99, Miss.Max, Miss.Nanoseconds, Find);
+
+            free(Memory);
+        }
+    }
+
+    free(Hashes);
+
+    return 0;
+}
@@ -0,0 +1,328 @@
+// Cache lines a hit touches with the split slot arrays (metadata, hashes, LRU links, payload)
+// against the single 64-byte entry they replaced, which held the hash, the links and the payload.
+// The workload is all hits, keys drawn with a Zipf distribution the way text reuses glyphs.
+//
+// The lines come from replaying each lookup on the live table: the probe's groups and tag
+// candidates, the LRU relink (entry, both neighbours, sentinel, old head) and the payload read.
+// The old layout is laid out over the same slots at a 64-byte aligned virtual base, so every
+// entry sits on exactly one line. Per hit is distinct lines within one lookup, working set is
+// distinct lines over the whole run.
+// Usage: bench_hot_cold [lookup count, default 1000000]
+
+#include "bench.h"
+
+#include <stddef.h>
+#include <math.h>
+
+using namespace ntext;
+
+// The slot before the split.
+
+struct combined_glyph_entry
+{
+    glyph_hash        Hash;
+
+    uint32_t          PrevLRU;
+    uint32_t          NextLRU;
+
+    uint16_t          GlyphIndex;
+    rectangle         Source;
+    glyph_layout_info Layout;
+    bool              IsRasterized;
+};
+
+constexpr uint64_t CacheLineSize = 64;
+
+
+struct line_set
+{
+    uint64_t *Bits;
+    uint64_t  Base;
+    uint64_t  LineCount;
+    uint64_t  WorkingSet;
+
+    uint64_t  Recent[32];
+    uint32_t  RecentCount;
+};
+
+
+static line_set
+CreateLineSet(uint64_t Base, uint64_t Size)
+{
+    line_set Result = {};
+    Result.Base      = Base & ~(CacheLineSize - 1);
+    Result.LineCount = (Base + Size - Result.Base) / CacheLineSize + 1;
+    Result.Bits      = static_cast<uint64_t *>(calloc((Result.LineCount + 63) / 64, sizeof(uint64_t)));
+
+    return Result;
+}
+
+
+static void
+TouchLines(line_set *Set, uint64_t Address, uint64_t Size)
+{
+    uint64_t First = (Address - Set->Base) / CacheLineSize;
+    uint64_t Last  = (Address + Size - 1 - Set->Base) / CacheLineSize;
+
+    for(uint64_t Line = First; Line <= Last; ++Line)
+    {
+        NTEXT_ASSERT(Line < Set->LineCount);
+
+        uint64_t Bit = 1ull << (Line & 63);
+        if(!(Set->Bits[Line / 64] & Bit))
+        {
+            Set->Bits[Line / 64] |= Bit;
+            Set->WorkingSet      += 1;
+        }
+
+        bool IsRecent = false;
+        for(uint32_t Idx = 0; Idx < Set->RecentCount; ++Idx)
+        {
+            IsRecent = IsRecent || Set->Recent[Idx] == Line;
+        }
+
+        if(!IsRecent && Set->RecentCount < 32)
+        {
+            Set->Recent[Set->RecentCount++] = Line;
+        }
+    }
+}
+
+
+static void
+TouchAddress(line_set *Set, const void *Address, uint64_t Size)
+{
+    TouchLines(Set, reinterpret_cast<uint64_t>(Address), Size);
+}
+
+
+// Lines of the old layout: metadata stays where it is, entries start at a virtual base past it.
+
+struct combined_layout
+{
+    uint64_t EntryBase;
+};
+
+
+static void
+TouchCombinedEntry(line_set *Set, combined_layout Layout, uint32_t Index, uint64_t Offset, uint64_t Size)
+{
+    TouchLines(Set, Layout.EntryBase + Index * sizeof(combined_glyph_entry) + Offset, Size);
+}
+
+
+struct hit_lines
+{
+    uint64_t Probe;
+    uint64_t Links;
+    uint64_t Payload;
+    uint64_t Total;
+};
+
+
+// Replays the accesses FindGlyphEntryByHash makes for a hit, on both layouts, before doing it.
+
+static void
+ReplayGlyphHit(glyph_hash Hash, glyph_table *Table, combined_layout Combined, line_set *Split, line_set *Old,
+               hit_lines *SplitLines, hit_lines *OldLines)
+{
+    Split->RecentCount = 0;
+    Old->RecentCount   = 0;
+
+    // Probe: metadata groups and the hashes behind matching tags.
+    glyph_tag Tag        = GetGlyphTagFromHash(Hash);
+    uint32_t  GroupIndex = GetGlyphGroupIndexFromHash(Hash, Table);
+    uint32_t  Found      = GlyphTableInvalidEntry;
+
+    for(uint32_t ProbeCount = 0; ProbeCount < Table->GroupCount && Found == GlyphTableInvalidEntry; ++ProbeCount)
+    {
+        uint8_t *Meta = Table->Metadata + (GroupIndex * Table->GroupWidth);
+        TouchAddress(Split, Meta, Table->GroupWidth);
+        TouchAddress(Old, Meta, Table->GroupWidth);
+
+        uint64_t TagMask = MatchGlyphGroup(Meta, Tag.Value, Table->GroupWidth).Tags;
+        while(TagMask && Found == GlyphTableInvalidEntry)
+        {
+            uint32_t EntryIndex = FindFirstBit64(TagMask) + (GroupIndex * Table->GroupWidth);
+
+            TouchAddress(Split, Table->Hashes + EntryIndex, sizeof(glyph_hash));
+            TouchCombinedEntry(Old, Combined, EntryIndex, offsetof(combined_glyph_entry, Hash), sizeof(glyph_hash));
+
+            if(GlyphHashesAreEqual(Hash, Table->Hashes[EntryIndex]))
+            {
+                Found = EntryIndex;
+            }
+
+            TagMask &= TagMask - 1;
+        }
+
+        GroupIndex = (GroupIndex + ProbeCount + 1) & Table->HashMask;
+    }
+
+    NTEXT_ASSERT(Found != GlyphTableInvalidEntry);
+
+    SplitLines->Probe += Split->RecentCount;
+    OldLines->Probe   += Old->RecentCount;
+
+    // LRU: unlink (entry and both neighbours), then link at the head (sentinel, entry, old head).
+    uint32_t SplitMark = Split->RecentCount;
+    uint32_t OldMark   = Old->RecentCount;
+
+    uint32_t Sentinel = Table->SentinelIndex;
+    uint32_t Prev     = Table->Links[Found].PrevLRU;
+    uint32_t Next     = Table->Links[Found].NextLRU;
+    uint32_t Head     = (Prev == Sentinel) ? Next : Table->Links[Sentinel].NextLRU;
+    uint32_t Linked[] = {Found, Prev, Next, Sentinel, Head};
+
+    for(uint32_t Index : Linked)
+    {
+        TouchAddress(Split, Table->Links + Index, sizeof(glyph_lru_link));
+        TouchCombinedEntry(Old, Combined, Index, offsetof(combined_glyph_entry, PrevLRU), 2 * sizeof(uint32_t));
+    }
+
+    SplitLines->Links += Split->RecentCount - SplitMark;
+    OldLines->Links   += Old->RecentCount - OldMark;
+
+    // Payload, copied into the glyph_state.
+    SplitMark = Split->RecentCount;
+    OldMark   = Old->RecentCount;
+
+    TouchAddress(Split, Table->Buckets + Found, sizeof(glyph_entry));
+    TouchCombinedEntry(Old, Combined, Found, offsetof(combined_glyph_entry, GlyphIndex),
+                       sizeof(combined_glyph_entry) - offsetof(combined_glyph_entry, GlyphIndex));
+
+    SplitLines->Payload += Split->RecentCount - SplitMark;
+    OldLines->Payload   += Old->RecentCount - OldMark;
+
+    SplitLines->Total += Split->RecentCount;
+    OldLines->Total   += Old->RecentCount;
+}
+
+
+int main(int ArgCount, char **Args)
+{
+    uint32_t LookupCount = ArgCount > 1 ? static_cast<uint32_t>(atoi(Args[1])) : 1000000;
+
+    // A Latin UI, a CJK document and a table far bigger than the caches, all at 3/4 load.
+    uint32_t SlotCounts[] = {4096, 65536, 1u << 20};
+
+    printf("%u hits, Zipf(1) over 3/4 of the slots, 128-bit groups\n", LookupCount);
+    printf("%8s %6s | %26s | %26s | %17s | %8s %8s\n", "slots", "layout",
+           "lines/hit probe+lru+data", "lines/hit distinct", "working set KB", "ns/hit", "batched");
+
+    for(uint32_t SlotCount : SlotCounts)
+    {
+        glyph_table_params Params = {.GroupWidth = GlyphTableWidth::_128Bits, .GroupCount = SlotCount / 16};
+
+        uint64_t     Footprint = GetGlyphTableFootprint(Params);
+        void        *Memory    = aligned_alloc(64, NTEXT_ALIGNPOW2(Footprint, 64));
+        glyph_table *Table     = PlaceGlyphTableInMemory(Params, Memory);
+
+        uint32_t    KeyCount = SlotCount / 4 * 3;
+        glyph_hash *Keys     = static_cast<glyph_hash *>(aligned_alloc(16, KeyCount * sizeof(glyph_hash)));
+        for(uint32_t Idx = 0; Idx < KeyCount; ++Idx)
+        {
+            Keys[Idx] = ComputeSingleGlyphHash(0x20 + Idx, 0x0000000C00000001ull, DefaultSeed);
+            FindGlyphEntryByHash(Keys[Idx], Table);
+        }
+
+        // Zipf(1) ranks, mapped to keys in a shuffled order so hot glyphs are spread over the table.
+        double *Cumulative = static_cast<double *>(malloc(KeyCount * sizeof(double)));
+        double  Total      = 0.0;
+        for(uint32_t Rank = 0; Rank < KeyCount; ++Rank)
+        {
+            Total            += 1.0 / (Rank + 1);
+            Cumulative[Rank]  = Total;
+        }
+
+        uint64_t    State  = 0x2545F4914F6CDD1Dull;
+        glyph_hash *Lookup = static_cast<glyph_hash *>(aligned_alloc(16, LookupCount * sizeof(glyph_hash)));
+        for(uint32_t Idx = 0; Idx < LookupCount; ++Idx)
+        {
+            State ^= State << 13;
+            State ^= State >> 7;
+            State ^= State << 17;
+
+            double   Target = static_cast<double>(State >> 11) / static_cast<double>(1ull << 53) * Total;
+            uint32_t Low    = 0;
+            uint32_t High   = KeyCount - 1;
+            while(Low < High)
+            {
+                uint32_t Mid = (Low + High) / 2;
+                if(Cumulative[Mid] < Target) Low = Mid + 1; else High = Mid;
+            }
+
+            Lookup[Idx] = Keys[(Low * 2654435761u) % KeyCount];
+        }
+
+        // Line counts are replayed on a twin of the table, filled the same way, so the timed runs
+        // below start from the same state.
+        void        *CopyMemory = aligned_alloc(64, NTEXT_ALIGNPOW2(Footprint, 64));
+        glyph_table *Copy       = PlaceGlyphTableInMemory(Params, CopyMemory);
+        for(uint32_t Idx = 0; Idx < KeyCount; ++Idx)
+        {
+            FindGlyphEntryByHash(Keys[Idx], Copy);
+        }
+
+        uint64_t        MetadataSize = static_cast<uint64_t>(SlotCount);
+        combined_layout Combined     = {.EntryBase = NTEXT_ALIGNPOW2(reinterpret_cast<uint64_t>(Copy->Metadata) + MetadataSize, CacheLineSize)};
+
+        line_set Split = CreateLineSet(reinterpret_cast<uint64_t>(CopyMemory), Footprint);
+        line_set Old   = CreateLineSet(reinterpret_cast<uint64_t>(Copy->Metadata),
+                                       Combined.EntryBase + (SlotCount + 1) * sizeof(combined_glyph_entry) - reinterpret_cast<uint64_t>(Copy->Metadata));
+
+        hit_lines SplitLines = {};
+        hit_lines OldLines   = {};
+
+        for(uint32_t Idx = 0; Idx < LookupCount; ++Idx)
+        {
+            ReplayGlyphHit(Lookup[Idx], Copy, Combined, &Split, &Old, &SplitLines, &OldLines);
+            FindGlyphEntryByHash(Lookup[Idx], Copy);
+        }
+
+        // Timing, on the split table only.
+        glyph_state *States = static_cast<glyph_state *>(malloc(LookupCount * sizeof(glyph_state)));
+        double       Single = 1e30;
+        double       Batch  = 1e30;
+
+        for(uint32_t Pass = 0; Pass < 3; ++Pass)
+        {
+            double Start = GetBenchSeconds();
+            for(uint32_t Idx = 0; Idx < LookupCount; ++Idx)
+            {
+                States[Idx] = FindGlyphEntryByHash(Lookup[Idx], Table);
+            }
+            double Middle = GetBenchSeconds();
+            for(uint32_t Idx = 0; Idx < LookupCount; Idx += 256)
+            {
+                uint32_t Count = LookupCount - Idx < 256 ? LookupCount - Idx : 256;
+                FindGlyphEntriesByHashBatch(Lookup + Idx, Count, States + Idx, Table);
+            }
+            double End = GetBenchSeconds();
+
+            Single = (Middle - Start) < Single ? (Middle - Start) : Single;
+            Batch  = (End - Middle)   < Batch  ? (End - Middle)   : Batch;
+            ConsumeBenchValue(States[LookupCount / 2].Id);
+        }
+
+        double Hits = static_cast<double>(LookupCount);
+
+        printf("%8u %6s | %8.2f %8.2f %8.2f | %26.2f | %17.1f | %8.1f %8.1f\n", SlotCount, "split",
+               SplitLines.Probe / Hits, SplitLines.Links / Hits, SplitLines.Payload / Hits, SplitLines.Total / Hits,
+               Split.WorkingSet * CacheLineSize / 1024.0, Single * 1e9 / Hits, Batch * 1e9 / Hits);
+        printf("%8u %6s | %8.2f %8.2f %8.2f | %26.2f | %17.1f | %8s %8s\n", SlotCount, "64B",
+               OldLines.Probe / Hits, OldLines.Links / Hits, OldLines.Payload / Hits, OldLines.Total / Hits,
+               Old.WorkingSet * CacheLineSize / 1024.0, "-", "-");
+
+        free(Split.Bits);
+        free(Old.Bits);
+        free(States);
+        free(Lookup);
+        free(Cumulative);
+        free(Keys);
+        free(CopyMemory);
+        free(Memory);
+    }
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+// Packs the recorded glyph sizes (glyph_sizes.h) with each atlas packer, one page after the other
+// the way the atlas opens pages, and prints occupancy and rectangles/sec. Text order offers the
+// rectangles one at a time as they come (PackRectangle), batch hands the whole list to each page
+// in turn (PackRectangles, tallest first). Occupancy is glyph area over page area, on the pages
+// that were closed because the next glyph did not fit. The last page is only partly filled and
+// shown apart, so use enough glyphs for a few pages.
+// Usage: bench_packers [glyph count, default 20000] [page side, default 1024]
+
+#include "bench.h"
+
+using namespace ntext;
+
+struct packer_run
+{
+    uint32_t PageCount;
+    uint64_t ClosedArea;
+    uint64_t LastArea;
+    double   Seconds;
+};
+
+
+// Placed keeps, per rectangle, whether an earlier page took it. Only the batch needs it.
+
+static packer_run
+PackGlyphSizes(RectanglePacker Kind, bool Batch, packed_rectangle *Rectangles, uint32_t Count, uint16_t Side,
+               void *Memory, bool *Placed, memory_arena *Scratch)
+{
+    packer_run Result = {.PageCount = 1};
+
+    rectangle_packer *Packer = PlaceRectanglePackerInMemory(Kind, Side, Side, Memory);
+    double            Start  = GetBenchSeconds();
+
+    if(Batch)
+    {
+        // Timed without the bookkeeping, which walks the whole list after every page.
+        double Bookkeeping = 0.0;
+
+        memset(Placed, 0, Count * sizeof(bool));
+
+        for(;;)
+        {
+            PackRectangles(Rectangles, Count, Packer, Scratch);
+
+            double Pause = GetBenchSeconds();
+            bool   Done  = true;
+
+            Result.LastArea = 0;
+
+            for(uint32_t Idx = 0; Idx < Count; ++Idx)
+            {
+                packed_rectangle &Rectangle = Rectangles[Idx];
+
+                if(Rectangle.WasPacked && !Placed[Idx])
+                {
+                    Result.LastArea += static_cast<uint64_t>(Rectangle.Width) * Rectangle.Height;
+                    Placed[Idx]      = true;
+                }
+
+                Done = Done && Rectangle.WasPacked;
+            }
+
+            Bookkeeping += GetBenchSeconds() - Pause;
+
+            if(Done || Result.LastArea == 0)
+            {
+                break;
+            }
+
+            Result.ClosedArea += Result.LastArea;
+            Result.PageCount  += 1;
+
+            ResetRectanglePacker(Packer);
+        }
+
+        Start += Bookkeeping;
+    }
+    else
+    {
+        for(uint32_t Idx = 0; Idx < Count; ++Idx)
+        {
+            PackRectangle(Rectangles[Idx], Packer);
+
+            if(!Rectangles[Idx].WasPacked)
+            {
+                Result.ClosedArea += Result.LastArea;
+                Result.LastArea    = 0;
+                Result.PageCount  += 1;
+
+                ResetRectanglePacker(Packer);
+                PackRectangle(Rectangles[Idx], Packer);
+            }
+
+            Result.LastArea += static_cast<uint64_t>(Rectangles[Idx].Width) * Rectangles[Idx].Height;
+        }
+    }
+
+    Result.Seconds = GetBenchSeconds() - Start;
+
+    return Result;
+}
+
+
+int main(int ArgCount, char **Args)
+{
+    uint32_t Count = ArgCount > 1 ? static_cast<uint32_t>(atoi(Args[1])) : 20000;
+    uint16_t Side  = ArgCount > 2 ? static_cast<uint16_t>(atoi(Args[2])) : 1024;
+
+    packed_rectangle *Sizes      = static_cast<packed_rectangle *>(malloc(Count * sizeof(packed_rectangle)));
+    packed_rectangle *Rectangles = static_cast<packed_rectangle *>(malloc(Count * sizeof(packed_rectangle)));
+    bool             *Placed     = static_cast<bool *>(malloc(Count * sizeof(bool)));
+    memory_arena     *Scratch    = CreateBenchArena(64ull << 20);
+
+    SampleGlyphSizes(Sizes, Count, 0x9E3779B97F4A7C15ull);
+
+    uint64_t GlyphArea = 0;
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        GlyphArea += static_cast<uint64_t>(Sizes[Idx].Width) * Sizes[Idx].Height;
+    }
+
+    printf("%u glyphs from %u recorded sizes, %.2f Mpx, %ux%u pages\n", Count, GlyphSizeGlyphCount, GlyphArea * 1e-6, Side, Side);
+    printf("%-10s %-5s | %5s %9s %9s | %10s %9s\n", "packer", "order", "pages", "occupancy", "last page", "Mrects/s", "ms");
+
+    RectanglePacker Kinds[] = {RectanglePacker::Skyline, RectanglePacker::Shelf, RectanglePacker::Guillotine, RectanglePacker::MaxRects};
+    const char     *Names[] = {"skyline", "shelf", "guillotine", "maxrects"};
+
+    for(uint32_t Batch = 0; Batch < 2; ++Batch)
+    {
+        for(uint32_t KindIdx = 0; KindIdx < 4; ++KindIdx)
+        {
+            RectanglePacker Kind   = Kinds[KindIdx];
+            void           *Memory = malloc(GetRectanglePackerFootprint(Kind, Side, Side));
+
+            packer_run Best = {};
+            for(uint32_t Pass = 0; Pass < 3; ++Pass)
+            {
+                memcpy(Rectangles, Sizes, Count * sizeof(packed_rectangle));
+
+                packer_run Run = PackGlyphSizes(Kind, Batch, Rectangles, Count, Side, Memory, Placed, Scratch);
+                if(!Pass || Run.Seconds < Best.Seconds)
+                {
+                    Best = Run;
+                }
+            }
+
+            double PageArea = static_cast<double>(Side) * Side;
+            double LastFill = Best.LastArea / PageArea;
+
+            if(Best.PageCount > 1)
+            {
+                printf("%-10s %-5s | %5u %9.3f %9.3f | %10.2f %9.2f\n", Names[KindIdx], Batch ? "batch" : "text", Best.PageCount,
+                       Best.ClosedArea / (PageArea * (Best.PageCount - 1)), LastFill, Count / Best.Seconds * 1e-6, Best.Seconds * 1e3);
+            }
+            else
+            {
+                printf("%-10s %-5s | %5u %9s %9.3f | %10.2f %9.2f\n", Names[KindIdx], Batch ? "batch" : "text", Best.PageCount,
+                       "-", LastFill, Count / Best.Seconds * 1e-6, Best.Seconds * 1e3);
+            }
+
+            free(Memory);
+        }
+    }
+
+    free(Scratch);
+    free(Placed);
+    free(Rectangles);
+    free(Sizes);
+
+    return 0;
+}
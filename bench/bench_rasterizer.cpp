@@ -0,0 +1,79 @@
+// Rasterizes every glyph of a face at 12/24/48/72px through RasterizeGlyphToAlphaTexture and
+// prints glyphs/sec and covered megapixels/sec, best of a few passes.
+// Usage: bench_rasterizer [font.ttf]
+
+#include "bench.h"
+
+using namespace ntext;
+
+int main(int ArgCount, char **Args)
+{
+    const char *Path = ArgCount > 1 ? Args[1] : NTEXT_BENCH_FONT_DIR "DejaVuSans.ttf";
+
+    memory_arena *Arena = CreateBenchArena(64ull << 20);
+    if(!Arena)
+    {
+        return 1;
+    }
+
+    backend_context Backend = InitializeBackendContext();
+    float           Sizes[] = {12.f, 24.f, 48.f, 72.f};
+    uint32_t        Passes  = 5;
+
+#if defined(__AVX2__)
+    printf("%s, resolve: avx2\n", Path);
+#else
+    printf("%s, resolve: sse2\n", Path);
+#endif
+    printf("%6s %8s %12s %12s %10s\n", "size", "glyphs", "glyphs/s", "Mpix/s", "ns/glyph");
+
+    for(float Size : Sizes)
+    {
+        memory_region FontRegion = EnterMemoryRegion(Arena);
+
+        system_font Font = LoadFontFromFile(Path, Size, Arena, Backend);
+        if(!IsValidSystemFont(&Font))
+        {
+            printf("could not load %s\n", Path);
+            return 1;
+        }
+
+        uint32_t GlyphCount = Font.FontFace->GlyphCount;
+        uint64_t PixelCount = 0;
+        double   Best       = 1e30;
+
+        for(uint32_t Pass = 0; Pass < Passes; ++Pass)
+        {
+            uint64_t Pixels = 0;
+            double   Start  = GetBenchSeconds();
+
+            for(uint32_t GlyphIndex = 0; GlyphIndex < GlyphCount; ++GlyphIndex)
+            {
+                memory_region Region = EnterMemoryRegion(Arena);
+
+                rasterized_buffer Buffer = RasterizeGlyphToAlphaTexture(static_cast<uint16_t>(GlyphIndex), 0.f, 0.f, Font, Backend, Arena);
+                if(Buffer.Data)
+                {
+                    Pixels += static_cast<uint64_t>(Buffer.Width) * Buffer.Height;
+                    ConsumeBenchValue(static_cast<uint8_t *>(Buffer.Data)[(Buffer.Height / 2) * Buffer.Stride + Buffer.Width / 2]);
+                }
+
+                LeaveMemoryRegion(Region);
+            }
+
+            double Elapsed = GetBenchSeconds() - Start;
+            Best       = Elapsed < Best ? Elapsed : Best;
+            PixelCount = Pixels;
+        }
+
+        printf("%6.0f %8u %12.0f %12.1f %10.0f\n", Size, GlyphCount, GlyphCount / Best,
+               static_cast<double>(PixelCount) / Best * 1e-6, Best * 1e9 / GlyphCount);
+
+        ReleaseFont(&Font, Backend);
+        LeaveMemoryRegion(FontRegion);
+    }
+
+    free(Arena);
+
+    return 0;
+}
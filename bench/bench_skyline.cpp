@@ -0,0 +1,163 @@
+// The skyline packer on 10k mixed glyphs (recorded sizes, see glyph_sizes.h) in text order, into
+// 4096x4096 atlases opened one after the other. The sizes are also scaled 2x and 4x, which makes
+// for longer skylines and more pages. Occupancy is glyph area over page area, leaving out the
+// last page when more than one was opened. Segments is the mean skyline length at insertion.
+//
+// Next to the timing of PackRectangle, every placement is checked against a plain scalar search
+// with the same rule (lowest spot, leftmost on ties; rest on the highest segment underneath),
+// run on the same skyline just before. Its time is the search alone, without the skyline update.
+// Usage: bench_skyline [glyph count, default 10000]
+
+#include "bench.h"
+
+using namespace ntext;
+
+struct skyline_spot
+{
+    uint16_t X;
+    uint16_t Y;
+    bool     Found;
+};
+
+
+static skyline_spot
+FindSkylineSpotScalar(uint16_t Width, uint16_t Height, rectangle_packer *Packer)
+{
+    skyline_spot Result = {UINT16_MAX, UINT16_MAX, false};
+
+    for(uint32_t Idx = 0; Idx < Packer->SkylineCount; ++Idx)
+    {
+        uint32_t Left  = Packer->SkylineX[Idx];
+        uint32_t Right = Left + Width;
+        if(Right > Packer->Width)
+        {
+            break;
+        }
+
+        uint32_t Top = 0;
+        for(uint32_t Under = Idx; Under < Packer->SkylineCount && Packer->SkylineX[Under] < Right; ++Under)
+        {
+            Top = Packer->SkylineY[Under] > Top ? Packer->SkylineY[Under] : Top;
+        }
+
+        if(Top + Height <= Packer->Height && Top < Result.Y)
+        {
+            Result = {static_cast<uint16_t>(Left), static_cast<uint16_t>(Top), true};
+        }
+    }
+
+    return Result;
+}
+
+
+int main(int ArgCount, char **Args)
+{
+    uint32_t Count = ArgCount > 1 ? static_cast<uint32_t>(atoi(Args[1])) : 10000;
+    uint16_t Side  = 4096;
+
+    packed_rectangle *Sizes      = static_cast<packed_rectangle *>(malloc(Count * sizeof(packed_rectangle)));
+    packed_rectangle *Rectangles = static_cast<packed_rectangle *>(malloc(Count * sizeof(packed_rectangle)));
+    void             *Memory     = malloc(GetRectanglePackerFootprint(RectanglePacker::Skyline, Side, Side));
+    void             *Twin       = malloc(GetRectanglePackerFootprint(RectanglePacker::Skyline, Side, Side));
+
+    printf("%u glyphs, %ux%u skyline pages\n", Count, Side, Side);
+    printf("%5s | %5s %9s %9s | %8s %10s | %10s %10s\n", "scale", "pages", "occupancy", "segments",
+           "ms", "Mrects/s", "scalar ms", "mismatch");
+
+    for(uint16_t Scale = 1; Scale <= 4; Scale *= 2)
+    {
+        SampleGlyphSizes(Sizes, Count, 0x9E3779B97F4A7C15ull);
+
+        uint64_t GlyphArea = 0;
+        for(uint32_t Idx = 0; Idx < Count; ++Idx)
+        {
+            Sizes[Idx].Width  = static_cast<uint16_t>(Sizes[Idx].Width  * Scale);
+            Sizes[Idx].Height = static_cast<uint16_t>(Sizes[Idx].Height * Scale);
+            GlyphArea        += static_cast<uint64_t>(Sizes[Idx].Width) * Sizes[Idx].Height;
+        }
+
+        // PackRectangle alone, best of a few passes.
+        double   Best      = 1e30;
+        uint32_t PageCount = 0;
+        uint64_t LastArea  = 0;
+
+        for(uint32_t Pass = 0; Pass < 5; ++Pass)
+        {
+            memcpy(Rectangles, Sizes, Count * sizeof(packed_rectangle));
+
+            rectangle_packer *Packer = PlaceRectanglePackerInMemory(RectanglePacker::Skyline, Side, Side, Memory);
+            double            Start  = GetBenchSeconds();
+
+            PageCount = 1;
+            LastArea  = 0;
+
+            for(uint32_t Idx = 0; Idx < Count; ++Idx)
+            {
+                PackRectangle(Rectangles[Idx], Packer);
+                if(!Rectangles[Idx].WasPacked)
+                {
+                    ResetRectanglePacker(Packer);
+                    PackRectangle(Rectangles[Idx], Packer);
+
+                    PageCount += 1;
+                    LastArea   = 0;
+                }
+
+                LastArea += static_cast<uint64_t>(Rectangles[Idx].Width) * Rectangles[Idx].Height;
+            }
+
+            double Elapsed = GetBenchSeconds() - Start;
+            Best = Elapsed < Best ? Elapsed : Best;
+        }
+
+        // Same sequence again, with the scalar search timed and compared before every placement.
+        double   ScalarTime   = 0.0;
+        uint64_t SegmentTotal = 0;
+        uint32_t Mismatches   = 0;
+        {
+            memcpy(Rectangles, Sizes, Count * sizeof(packed_rectangle));
+
+            rectangle_packer *Packer = PlaceRectanglePackerInMemory(RectanglePacker::Skyline, Side, Side, Twin);
+
+            for(uint32_t Idx = 0; Idx < Count; ++Idx)
+            {
+                packed_rectangle &Rectangle = Rectangles[Idx];
+
+                double       Start = GetBenchSeconds();
+                skyline_spot Spot  = FindSkylineSpotScalar(Rectangle.Width, Rectangle.Height, Packer);
+                ScalarTime += GetBenchSeconds() - Start;
+
+                SegmentTotal += Packer->SkylineCount;
+
+                PackRectangle(Rectangle, Packer);
+                if(!Rectangle.WasPacked)
+                {
+                    Mismatches += Spot.Found;
+
+                    ResetRectanglePacker(Packer);
+
+                    Start = GetBenchSeconds();
+                    Spot  = FindSkylineSpotScalar(Rectangle.Width, Rectangle.Height, Packer);
+                    ScalarTime += GetBenchSeconds() - Start;
+
+                    PackRectangle(Rectangle, Packer);
+                }
+
+                Mismatches += !Spot.Found || Spot.X != Rectangle.X || Spot.Y != Rectangle.Y;
+            }
+        }
+
+        double PageArea  = static_cast<double>(Side) * Side;
+        double Occupancy = PageCount > 1 ? (GlyphArea - LastArea) / (PageArea * (PageCount - 1)) : GlyphArea / PageArea;
+
+        printf("%4ux | %5u %9.3f %9.1f | %8.2f %10.2f | %10.2f %10u\n", Scale, PageCount, Occupancy,
+               static_cast<double>(SegmentTotal) / Count, Best * 1e3, Count / Best * 1e-6, ScalarTime * 1e3, Mismatches);
+    }
+
+    free(Twin);
+    free(Memory);
+    free(Rectangles);
+    free(Sizes);
+
+    return 0;
+}
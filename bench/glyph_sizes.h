@@ -0,0 +1,211 @@
+#pragma once
+
+// Recorded by record_glyph_sizes.cpp: atlas rectangles of U+0021..U+024F in DejaVu Sans, Serif,
+// Sans Mono and Sans Bold at 11, 13, 16, 20, 24, 32 and 48px. 14504 glyphs.
+
+#include <stdint.h>
+
+struct glyph_size_bin
+{
+    uint16_t Width;
+    uint16_t Height;
+    uint32_t Count;
+};
+
+constexpr uint32_t GlyphSizeBinCount   = 1143;
+constexpr uint32_t GlyphSizeGlyphCount = 14504;
+
+static const glyph_size_bin GlyphSizeBins[GlyphSizeBinCount] =
+{
+    {  1,   4,   2}, {  2,   2,   7}, {  2,   3,   5}, {  2,   4,   3}, {  2,   5,   7}, {  2,   6,   4},
+    {  2,   7,   3}, {  2,   8,   1}, {  2,   9,  12}, {  2,  10,  17}, {  2,  11,   2}, {  2,  12,  14},
+    {  2,  13,   6}, {  2,  14,   3}, {  2,  15,   8}, {  2,  17,   4}, {  2,  18,   1}, {  2,  21,   1},
+    {  2,  22,   1}, {  2,  25,   1}, {  3,   2,   1}, {  3,   3,  15}, {  3,   4,   9}, {  3,   5,   1},
+    {  3,   6,   3}, {  3,   7,   4}, {  3,   8,   8}, {  3,   9,  11}, {  3,  10,  10}, {  3,  11,  13},
+    {  3,  12,  14}, {  3,  13,   8}, {  3,  14,   3}, {  3,  15,   7}, {  3,  16,   3}, {  3,  17,   1},
+    {  3,  18,  12}, {  3,  19,   5}, {  3,  20,   1}, {  3,  21,   3}, {  3,  22,   4}, {  3,  23,   1},
+    {  3,  24,   2}, {  3,  25,   5}, {  3,  29,   3}, {  3,  33,   3}, {  4,   2,  22}, {  4,   3,  19},
+    {  4,   4,  22}, {  4,   5,  10}, {  4,   6,  15}, {  4,   7,   1}, {  4,   8,   2}, {  4,   9,  32},
+    {  4,  10,  19}, {  4,  11,  38}, {  4,  12,  27}, {  4,  13,  21}, {  4,  14,   1}, {  4,  15,   4},
+    {  4,  16,  12}, {  4,  17,   3}, {  4,  19,   2}, {  4,  21,   1}, {  4,  24,   8}, {  4,  29,   1},
+    {  4,  30,   1}, {  4,  31,   1}, {  4,  33,   1}, {  4,  35,   2}, {  4,  43,   1}, {  4,  49,   1},
+    {  5,   2,   9}, {  5,   3,   8}, {  5,   4,   7}, {  5,   5,  15}, {  5,   6,  20}, {  5,   7,  16},
+    {  5,   8,   8}, {  5,   9,  58}, {  5,  10,  60}, {  5,  11,  79}, {  5,  12,  42}, {  5,  13,  36},
+    {  5,  14,  13}, {  5,  15,  12}, {  5,  16,  14}, {  5,  17,   6}, {  5,  18,   3}, {  5,  19,  13},
+    {  5,  20,   2}, {  5,  21,   2}, {  5,  23,   4}, {  5,  24,   1}, {  5,  25,   2}, {  5,  27,   1},
+    {  5,  33,   1}, {  5,  35,   4}, {  5,  36,   2}, {  5,  37,   2}, {  5,  43,   2}, {  5,  49,   2},
+    {  6,   1,   1}, {  6,   2,   7}, {  6,   3,  13}, {  6,   4,   8}, {  6,   5,   6}, {  6,   6,  23},
+    {  6,   7,  34}, {  6,   8,  31}, {  6,   9, 117}, {  6,  10, 186}, {  6,  11, 110}, {  6,  12, 145},
+    {  6,  13,  73}, {  6,  14,  17}, {  6,  15,  32}, {  6,  16,  18}, {  6,  17,   5}, {  6,  18,   3},
+    {  6,  19,  17}, {  6,  20,   5}, {  6,  21,   2}, {  6,  22,   1}, {  6,  23,   9}, {  6,  24,   3},
+    {  6,  25,   2}, {  6,  35,   2}, {  6,  43,   1}, {  6,  44,   1}, {  6,  45,   1}, {  6,  49,   1},
+    {  7,   1,   1}, {  7,   2,   2}, {  7,   3,  10}, {  7,   4,   7}, {  7,   6,  11}, {  7,   7,  45},
+    {  7,   8,  41}, {  7,   9, 121}, {  7,  10, 284}, {  7,  11, 160}, {  7,  12, 161}, {  7,  13,  94},
+    {  7,  14,  46}, {  7,  15,   8}, {  7,  16,  34}, {  7,  17,  11}, {  7,  18,   4}, {  7,  19,  20},
+    {  7,  20,   3}, {  7,  21,   6}, {  7,  23,  11}, {  7,  24,   6}, {  7,  25,   4}, {  7,  30,   6},
+    {  7,  31,   2}, {  7,  32,   3}, {  7,  36,   2}, {  8,   1,   1}, {  8,   2,   7}, {  8,   3,   7},
+    {  8,   4,  16}, {  8,   5,   2}, {  8,   6,   2}, {  8,   7,  32}, {  8,   8,  46}, {  8,   9, 111},
+    {  8,  10, 143}, {  8,  11, 193}, {  8,  12, 240}, {  8,  13, 208}, {  8,  14, 130}, {  8,  15,  52},
+    {  8,  16,  70}, {  8,  17,  22}, {  8,  18,  11}, {  8,  19,  26}, {  8,  20,  13}, {  8,  21,   1},
+    {  8,  22,   5}, {  8,  23,  16}, {  8,  24,   3}, {  8,  25,   2}, {  8,  26,   2}, {  8,  30,   8},
+    {  8,  31,   1}, {  8,  49,   1}, {  9,   3,   3}, {  9,   4,   9}, {  9,   5,   7}, {  9,   6,   2},
+    {  9,   7,   5}, {  9,   8,  35}, {  9,   9,  52}, {  9,  10, 125}, {  9,  11,  88}, {  9,  12, 151},
+    {  9,  13, 189}, {  9,  14, 124}, {  9,  15,  46}, {  9,  16,  84}, {  9,  17,  55}, {  9,  18,   8},
+    {  9,  19,  14}, {  9,  20,  16}, {  9,  21,  14}, {  9,  22,   3}, {  9,  23,  14}, {  9,  24,   3},
+    {  9,  25,   5}, {  9,  27,   2}, {  9,  30,   4}, {  9,  31,   2}, {  9,  32,   2}, {  9,  37,   2},
+    {  9,  45,   1}, { 10,   1,   1}, { 10,   2,   2}, { 10,   3,   3}, { 10,   4,   2}, { 10,   5,   3},
+    { 10,   6,   1}, { 10,   7,   5}, { 10,   8,   1}, { 10,   9,  29}, { 10,  10,  82}, { 10,  11,  71},
+    { 10,  12,  71}, { 10,  13, 125}, { 10,  14, 117}, { 10,  15,  81}, { 10,  16, 134}, { 10,  17, 127},
+    { 10,  18,  18}, { 10,  19,  63}, { 10,  20,  54}, { 10,  21,  35}, { 10,  22,   3}, { 10,  23,  12},
+    { 10,  24,   8}, { 10,  25,   7}, { 10,  26,   6}, { 10,  28,   1}, { 10,  29,   3}, { 10,  30,  10},
+    { 10,  31,   3}, { 10,  32,   3}, { 10,  35,   3}, { 10,  36,   1}, { 10,  37,   1}, { 10,  45,   5},
+    { 10,  47,   2}, { 11,   3,   1}, { 11,   4,   4}, { 11,   5,   5}, { 11,   6,   7}, { 11,   7,   3},
+    { 11,   8,   7}, { 11,   9,  11}, { 11,  10,  74}, { 11,  11,  43}, { 11,  12,  68}, { 11,  13,  76},
+    { 11,  14,  72}, { 11,  15,  97}, { 11,  16,  98}, { 11,  17,  72}, { 11,  18,  16}, { 11,  19,  64},
+    { 11,  20,  50}, { 11,  21,  38}, { 11,  22,  10}, { 11,  23,  27}, { 11,  24,  12}, { 11,  25,   8},
+    { 11,  26,  12}, { 11,  27,   4}, { 11,  28,   2}, { 11,  30,  12}, { 11,  31,   1}, { 11,  32,   3},
+    { 11,  33,   2}, { 11,  34,   1}, { 11,  44,   6}, { 11,  48,   1}, { 12,   2,   2}, { 12,   3,   1},
+    { 12,   4,   1}, { 12,   6,   2}, { 12,   7,   2}, { 12,   8,   4}, { 12,   9,   6}, { 12,  10,  19},
+    { 12,  11,  33}, { 12,  12,  56}, { 12,  13,  36}, { 12,  14,  23}, { 12,  15,  71}, { 12,  16,  86},
+    { 12,  17,  79}, { 12,  18,  46}, { 12,  19, 115}, { 12,  20, 101}, { 12,  21,  41}, { 12,  22,  14},
+    { 12,  23,  49}, { 12,  24,  30}, { 12,  25,  16}, { 12,  26,  14}, { 12,  27,   3}, { 12,  28,   2},
+    { 12,  30,   9}, { 12,  31,   2}, { 12,  32,   1}, { 12,  37,   2}, { 12,  39,   2}, { 12,  44,   4},
+    { 12,  45,   1}, { 13,   2,   1}, { 13,   4,   4}, { 13,   5,   6}, { 13,   6,   3}, { 13,   7,   7},
+    { 13,   8,   2}, { 13,   9,   6}, { 13,  10,   8}, { 13,  11,  23}, { 13,  12,  37}, { 13,  13,  41},
+    { 13,  14,  20}, { 13,  15,  78}, { 13,  16,  86}, { 13,  17,  58}, { 13,  18,  44}, { 13,  19,  72},
+    { 13,  20,  59}, { 13,  21,  64}, { 13,  22,   5}, { 13,  23,  38}, { 13,  24,  34}, { 13,  25,  13},
+    { 13,  26,   3}, { 13,  27,   2}, { 13,  28,   1}, { 13,  29,   1}, { 13,  30,   2}, { 13,  31,   7},
+    { 13,  33,   1}, { 13,  35,   1}, { 13,  37,   3}, { 13,  45,   4}, { 13,  47,   2}, { 14,   3,   1},
+    { 14,   6,   1}, { 14,   8,   1}, { 14,   9,   4}, { 14,  10,  10}, { 14,  11,   6}, { 14,  12,  16},
+    { 14,  13,  22}, { 14,  14,  13}, { 14,  15,  44}, { 14,  16,  32}, { 14,  17,  13}, { 14,  18,  37},
+    { 14,  19,  78}, { 14,  20,  76}, { 14,  21,  16}, { 14,  22,  12}, { 14,  23,  31}, { 14,  24,  30},
+    { 14,  25,  31}, { 14,  26,  27}, { 14,  27,  21}, { 14,  28,   4}, { 14,  29,   2}, { 14,  30,  12},
+    { 14,  31,   2}, { 14,  32,   6}, { 14,  33,   3}, { 14,  34,   1}, { 14,  35,   2}, { 14,  36,   1},
+    { 14,  37,   4}, { 14,  45,   3}, { 14,  46,   1}, { 14,  47,   2}, { 15,   2,   1}, { 15,   4,   1},
+    { 15,   6,   1}, { 15,   9,   7}, { 15,  10,   3}, { 15,  11,   5}, { 15,  12,   3}, { 15,  13,  15},
+    { 15,  14,  13}, { 15,  15,  41}, { 15,  16,  19}, { 15,  17,  14}, { 15,  18,  51}, { 15,  19,  60},
+    { 15,  20,  72}, { 15,  21,  30}, { 15,  22,  13}, { 15,  23,  60}, { 15,  24,  40}, { 15,  25,  34},
+    { 15,  26,  23}, { 15,  27,  14}, { 15,  28,   3}, { 15,  29,   1}, { 15,  30,  21}, { 15,  31,  28},
+    { 15,  32,   5}, { 15,  33,   4}, { 15,  34,   2}, { 15,  35,   4}, { 15,  36,   1}, { 15,  37,   4},
+    { 15,  38,   3}, { 15,  39,   3}, { 15,  44,   8}, { 15,  45,  10}, { 15,  47,   1}, { 15,  48,   1},
+    { 16,   2,   1}, { 16,   4,   3}, { 16,   5,   4}, { 16,   6,   1}, { 16,   7,   3}, { 16,   8,   8},
+    { 16,   9,   2}, { 16,  10,   3}, { 16,  11,   2}, { 16,  12,   3}, { 16,  13,  14}, { 16,  14,   8},
+    { 16,  15,  36}, { 16,  16,  20}, { 16,  17,   8}, { 16,  18,  31}, { 16,  19,  53}, { 16,  20,  33},
+    { 16,  21,   5}, { 16,  22,  10}, { 16,  23,  33}, { 16,  24,  54}, { 16,  25,  37}, { 16,  26,  34},
+    { 16,  27,  29}, { 16,  28,   6}, { 16,  29,   5}, { 16,  30,  31}, { 16,  31,   9}, { 16,  32,   3},
+    { 16,  33,   8}, { 16,  34,   2}, { 16,  36,   1}, { 16,  37,   1}, { 16,  38,   3}, { 16,  39,   5},
+    { 16,  44,   1}, { 16,  45,   7}, { 16,  47,   1}, { 16,  49,   2}, { 17,   6,   1}, { 17,   9,   2},
+    { 17,  10,   5}, { 17,  11,   5}, { 17,  12,   7}, { 17,  13,   3}, { 17,  14,   4}, { 17,  15,  13},
+    { 17,  16,  16}, { 17,  17,   8}, { 17,  18,  28}, { 17,  19,  24}, { 17,  20,  19}, { 17,  21,   8},
+    { 17,  22,   7}, { 17,  23,  24}, { 17,  24,  36}, { 17,  25,  53}, { 17,  26,  30}, { 17,  27,  45},
+    { 17,  28,   3}, { 17,  29,   3}, { 17,  30,   8}, { 17,  31,  28}, { 17,  32,  11}, { 17,  33,   8},
+    { 17,  34,   3}, { 17,  35,   1}, { 17,  36,   2}, { 17,  37,   3}, { 17,  38,   6}, { 17,  39,   3},
+    { 17,  40,   5}, { 17,  44,   2}, { 17,  45,   3}, { 17,  46,   1}, { 18,   3,   1}, { 18,  10,   1},
+    { 18,  11,   1}, { 18,  12,   2}, { 18,  13,   4}, { 18,  14,   3}, { 18,  15,   3}, { 18,  16,  10},
+    { 18,  17,   8}, { 18,  18,  32}, { 18,  19,  14}, { 18,  20,  12}, { 18,  21,   4}, { 18,  22,   3},
+    { 18,  23,  15}, { 18,  24,  38}, { 18,  25,  21}, { 18,  26,   8}, { 18,  27,   7}, { 18,  28,   1},
+    { 18,  29,   1}, { 18,  30,  26}, { 18,  31,  19}, { 18,  32,   7}, { 18,  33,   8}, { 18,  34,   2},
+    { 18,  37,   1}, { 18,  39,   5}, { 18,  40,   2}, { 18,  41,   2}, { 18,  43,   1}, { 18,  44,   2},
+    { 18,  45,   5}, { 18,  49,   1}, { 18,  55,   1}, { 19,  10,   2}, { 19,  11,   1}, { 19,  12,   3},
+    { 19,  13,   4}, { 19,  14,   2}, { 19,  15,   2}, { 19,  16,   7}, { 19,  17,   2}, { 19,  18,  20},
+    { 19,  19,  18}, { 19,  20,   8}, { 19,  21,   6}, { 19,  22,   5}, { 19,  23,  39}, { 19,  24,  57},
+    { 19,  25,  40}, { 19,  26,  36}, { 19,  27,  25}, { 19,  28,   2}, { 19,  29,   6}, { 19,  30,  28},
+    { 19,  31,  30}, { 19,  32,   8}, { 19,  33,   3}, { 19,  34,   7}, { 19,  35,   4}, { 19,  36,   1},
+    { 19,  37,   1}, { 19,  38,   1}, { 19,  39,   1}, { 19,  45,   6}, { 19,  47,   1}, { 19,  49,   1},
+    { 19,  50,   1}, { 20,   2,   1}, { 20,  13,   1}, { 20,  14,   3}, { 20,  15,   4}, { 20,  16,   6},
+    { 20,  17,   3}, { 20,  18,  10}, { 20,  19,  12}, { 20,  20,   8}, { 20,  21,   3}, { 20,  22,   1},
+    { 20,  23,   3}, { 20,  24,  32}, { 20,  25,  24}, { 20,  26,  21}, { 20,  27,  27}, { 20,  28,   2},
+    { 20,  29,   2}, { 20,  30,  25}, { 20,  31,  15}, { 20,  32,   8}, { 20,  33,   4}, { 20,  35,   1},
+    { 20,  36,   2}, { 20,  37,   8}, { 20,  38,   3}, { 20,  39,   5}, { 20,  41,   2}, { 20,  45,   1},
+    { 20,  47,   1}, { 20,  48,   1}, { 20,  50,   2}, { 21,   6,   2}, { 21,   8,   1}, { 21,  10,   7},
+    { 21,  11,   1}, { 21,  12,   4}, { 21,  13,   4}, { 21,  14,   1}, { 21,  15,   4}, { 21,  16,   3},
+    { 21,  17,   4}, { 21,  18,  13}, { 21,  19,   8}, { 21,  20,   4}, { 21,  21,  10}, { 21,  22,   1},
+    { 21,  23,   2}, { 21,  24,  22}, { 21,  25,   9}, { 21,  26,   1}, { 21,  27,   5}, { 21,  28,   7},
+    { 21,  29,   1}, { 21,  30,   8}, { 21,  31,   8}, { 21,  32,   4}, { 21,  33,   2}, { 21,  35,   5},
+    { 21,  36,   2}, { 21,  37,  15}, { 21,  38,   6}, { 21,  39,  13}, { 21,  40,  19}, { 21,  41,   1},
+    { 21,  42,   2}, { 21,  43,   1}, { 21,  44,   3}, { 21,  45,  14}, { 21,  46,   1}, { 21,  47,   4},
+    { 21,  50,   1}, { 21,  55,   1}, { 22,  14,   2}, { 22,  15,   2}, { 22,  16,   2}, { 22,  18,   2},
+    { 22,  19,  10}, { 22,  20,   5}, { 22,  21,   3}, { 22,  22,  10}, { 22,  23,   3}, { 22,  24,  16},
+    { 22,  25,   8}, { 22,  26,   6}, { 22,  27,   4}, { 22,  28,   2}, { 22,  29,   2}, { 22,  30,  24},
+    { 22,  31,  38}, { 22,  32,   5}, { 22,  33,   2}, { 22,  34,   4}, { 22,  35,  11}, { 22,  36,   4},
+    { 22,  37,  20}, { 22,  38,  11}, { 22,  39,  15}, { 22,  40,   9}, { 22,  41,   1}, { 22,  44,   8},
+    { 22,  45,  14}, { 22,  46,   1}, { 22,  47,   4}, { 22,  48,   1}, { 22,  50,   1}, { 23,  13,   1},
+    { 23,  14,   1}, { 23,  15,   2}, { 23,  16,   1}, { 23,  17,   2}, { 23,  18,   2}, { 23,  19,   5},
+    { 23,  20,   1}, { 23,  21,   2}, { 23,  22,   3}, { 23,  23,   6}, { 23,  24,  16}, { 23,  25,  10},
+    { 23,  26,   5}, { 23,  27,   7}, { 23,  28,   3}, { 23,  29,   3}, { 23,  30,   8}, { 23,  31,  23},
+    { 23,  32,   3}, { 23,  34,   3}, { 23,  35,  12}, { 23,  36,  10}, { 23,  37,  15}, { 23,  38,  16},
+    { 23,  39,  13}, { 23,  40,  17}, { 23,  42,   1}, { 23,  43,   1}, { 23,  44,   3}, { 23,  45,  23},
+    { 23,  46,  20}, { 23,  47,   4}, { 23,  48,   2}, { 23,  49,   6}, { 23,  50,   3}, { 23,  55,   1},
+    { 24,   3,   1}, { 24,   6,   1}, { 24,  12,   2}, { 24,  15,   3}, { 24,  16,   1}, { 24,  18,   3},
+    { 24,  19,   2}, { 24,  21,   1}, { 24,  22,   4}, { 24,  23,   3}, { 24,  24,  15}, { 24,  25,   8},
+    { 24,  26,   6}, { 24,  27,   4}, { 24,  28,   2}, { 24,  30,   9}, { 24,  31,  17}, { 24,  32,   1},
+    { 24,  34,   3}, { 24,  35,   9}, { 24,  36,   9}, { 24,  37,  18}, { 24,  38,  12}, { 24,  39,   5},
+    { 24,  40,   9}, { 24,  41,   1}, { 24,  42,   1}, { 24,  43,   1}, { 24,  44,   5}, { 24,  45,  14},
+    { 24,  46,   5}, { 24,  47,   5}, { 24,  48,   1}, { 24,  49,   1}, { 24,  50,   5}, { 25,   8,   1},
+    { 25,  13,   1}, { 25,  14,   1}, { 25,  15,   2}, { 25,  16,   1}, { 25,  17,   2}, { 25,  18,   3},
+    { 25,  19,   1}, { 25,  20,   3}, { 25,  21,   2}, { 25,  22,   1}, { 25,  23,   4}, { 25,  24,  15},
+    { 25,  25,  10}, { 25,  26,   4}, { 25,  27,   7}, { 25,  28,  10}, { 25,  29,   2}, { 25,  30,  30},
+    { 25,  31,  33}, { 25,  32,   1}, { 25,  33,   2}, { 25,  34,   3}, { 25,  35,  14}, { 25,  36,   6},
+    { 25,  37,  32}, { 25,  38,  19}, { 25,  39,  13}, { 25,  40,  34}, { 25,  43,   3}, { 25,  44,   3},
+    { 25,  45,   9}, { 25,  46,  16}, { 25,  47,   7}, { 25,  48,   6}, { 25,  49,   3}, { 25,  54,   1},
+    { 26,   5,   1}, { 26,  18,   1}, { 26,  19,   2}, { 26,  22,   1}, { 26,  23,   1}, { 26,  24,   7},
+    { 26,  25,   5}, { 26,  27,   5}, { 26,  28,   1}, { 26,  30,   2}, { 26,  31,  11}, { 26,  35,  18},
+    { 26,  36,   2}, { 26,  37,  13}, { 26,  38,   3}, { 26,  39,   3}, { 26,  40,   5}, { 26,  42,   2},
+    { 26,  44,   4}, { 26,  45,  19}, { 26,  46,   9}, { 26,  47,   3}, { 26,  48,   2}, { 26,  49,   4},
+    { 27,  14,   1}, { 27,  15,   2}, { 27,  16,   1}, { 27,  17,   1}, { 27,  18,   1}, { 27,  19,   2},
+    { 27,  20,   1}, { 27,  21,   1}, { 27,  24,   8}, { 27,  25,   6}, { 27,  26,   4}, { 27,  27,   5},
+    { 27,  28,   2}, { 27,  31,   3}, { 27,  32,   7}, { 27,  35,  14}, { 27,  36,   4}, { 27,  37,  10},
+    { 27,  38,   9}, { 27,  39,   9}, { 27,  40,   7}, { 27,  42,   2}, { 27,  44,   1}, { 27,  45,  10},
+    { 27,  46,  14}, { 27,  47,   3}, { 27,  48,   1}, { 27,  50,   1}, { 27,  51,   1}, { 27,  52,   3},
+    { 28,  18,   2}, { 28,  19,   1}, { 28,  20,   1}, { 28,  24,   1}, { 28,  25,   6}, { 28,  26,   2},
+    { 28,  27,   2}, { 28,  28,   5}, { 28,  29,   3}, { 28,  31,   2}, { 28,  32,   1}, { 28,  33,   1},
+    { 28,  35,   9}, { 28,  36,   8}, { 28,  37,   7}, { 28,  38,  14}, { 28,  39,   4}, { 28,  40,   6},
+    { 28,  41,   2}, { 28,  42,   1}, { 28,  44,   3}, { 28,  45,  19}, { 28,  46,   2}, { 28,  47,   5},
+    { 28,  48,   2}, { 28,  49,   1}, { 28,  50,   5}, { 29,   3,   1}, { 29,  15,   1}, { 29,  18,   2},
+    { 29,  19,   2}, { 29,  20,   1}, { 29,  21,   1}, { 29,  23,   1}, { 29,  25,   7}, { 29,  26,   3},
+    { 29,  27,   4}, { 29,  28,   6}, { 29,  30,   3}, { 29,  31,   2}, { 29,  34,   1}, { 29,  35,  21},
+    { 29,  36,   9}, { 29,  37,  25}, { 29,  38,  18}, { 29,  39,  17}, { 29,  40,  18}, { 29,  43,   2},
+    { 29,  44,   7}, { 29,  45,  25}, { 29,  46,  12}, { 29,  47,   5}, { 29,  48,   7}, { 29,  49,   1},
+    { 29,  50,   3}, { 30,  15,   1}, { 30,  19,   2}, { 30,  24,   3}, { 30,  25,   6}, { 30,  26,   1},
+    { 30,  27,   1}, { 30,  29,   1}, { 30,  30,   2}, { 30,  32,   3}, { 30,  35,  17}, { 30,  37,   3},
+    { 30,  38,   1}, { 30,  41,   1}, { 30,  42,   1}, { 30,  44,   2}, { 30,  45,  15}, { 30,  46,   1},
+    { 30,  47,   2}, { 31,   8,   1}, { 31,  10,   2}, { 31,  14,   4}, { 31,  15,   2}, { 31,  16,   1},
+    { 31,  18,   4}, { 31,  19,   2}, { 31,  20,   2}, { 31,  23,   1}, { 31,  24,   3}, { 31,  25,   2},
+    { 31,  26,   5}, { 31,  27,   5}, { 31,  28,   2}, { 31,  31,   7}, { 31,  35,  15}, { 31,  36,   1},
+    { 31,  37,   4}, { 31,  38,   2}, { 31,  44,   2}, { 31,  45,  11}, { 31,  46,  17}, { 31,  47,   1},
+    { 31,  48,   1}, { 31,  49,   1}, { 31,  50,   2}, { 31,  51,   1}, { 31,  55,   3}, { 32,  14,   1},
+    { 32,  24,   2}, { 32,  25,   1}, { 32,  29,   1}, { 32,  30,   2}, { 32,  31,   2}, { 32,  35,   7},
+    { 32,  36,   2}, { 32,  37,   6}, { 32,  38,   1}, { 32,  45,  18}, { 32,  46,  17}, { 32,  47,   3},
+    { 32,  48,   1}, { 33,  19,   1}, { 33,  24,   3}, { 33,  25,   1}, { 33,  26,   1}, { 33,  27,   1},
+    { 33,  30,   3}, { 33,  31,   1}, { 33,  32,   1}, { 33,  35,   9}, { 33,  37,   4}, { 33,  38,   3},
+    { 33,  40,   1}, { 33,  43,   1}, { 33,  44,   4}, { 33,  45,  12}, { 33,  46,   7}, { 33,  47,   2},
+    { 33,  50,   2}, { 34,  18,   1}, { 34,  23,   1}, { 34,  26,   1}, { 34,  27,   1}, { 34,  31,   2},
+    { 34,  32,   2}, { 34,  35,  14}, { 34,  36,   1}, { 34,  37,   7}, { 34,  38,   2}, { 34,  39,   4},
+    { 34,  43,   1}, { 34,  44,   1}, { 34,  45,  11}, { 34,  46,  14}, { 34,  47,   2}, { 34,  51,   3},
+    { 34,  54,   1}, { 35,  18,   1}, { 35,  23,   1}, { 35,  24,   1}, { 35,  25,   2}, { 35,  30,   1},
+    { 35,  35,   8}, { 35,  36,   3}, { 35,  37,   5}, { 35,  38,   2}, { 35,  39,   2}, { 35,  44,   1},
+    { 35,  45,   5}, { 35,  46,  14}, { 35,  47,   1}, { 35,  51,   3}, { 35,  54,   1}, { 36,  24,   1},
+    { 36,  25,   1}, { 36,  26,   2}, { 36,  27,   2}, { 36,  31,   1}, { 36,  35,  11}, { 36,  36,   1},
+    { 36,  37,   1}, { 36,  38,   2}, { 36,  39,   2}, { 36,  41,   1}, { 36,  43,   1}, { 36,  45,   4},
+    { 36,  46,   1}, { 37,  35,   9}, { 37,  36,   5}, { 37,  37,   3}, { 37,  38,   1}, { 37,  39,   1},
+    { 37,  41,   1}, { 37,  44,   4}, { 37,  45,  33}, { 37,  46,  25}, { 37,  47,   1}, { 37,  50,   4},
+    { 37,  51,   4}, { 37,  52,   3}, { 37,  54,   1}, { 38,  35,   6}, { 38,  36,   2}, { 38,  37,   3},
+    { 38,  38,   2}, { 38,  41,   1}, { 38,  45,   3}, { 38,  46,   7}, { 39,  26,   1}, { 39,  27,   2},
+    { 39,  31,   1}, { 39,  32,   1}, { 39,  35,   1}, { 39,  36,   2}, { 39,  37,   1}, { 39,  38,   1},
+    { 39,  39,   4}, { 39,  45,   1}, { 39,  46,   1}, { 39,  47,   2}, { 40,  35,   5}, { 40,  36,   1},
+    { 40,  37,   1}, { 40,  38,   1}, { 40,  46,   1}, { 40,  48,   1}, { 41,  24,   2}, { 41,  25,   1},
+    { 41,  26,   1}, { 41,  27,   1}, { 41,  30,   1}, { 41,  35,   2}, { 41,  37,   5}, { 41,  39,   1},
+    { 41,  40,   1}, { 41,  45,   1}, { 41,  46,   1}, { 41,  47,   2}, { 42,  24,   1}, { 42,  26,   1},
+    { 42,  27,   1}, { 42,  36,   1}, { 42,  37,   1}, { 42,  38,   2}, { 42,  39,   1}, { 42,  40,   2},
+    { 42,  43,   3}, { 43,  28,   1}, { 43,  37,   3}, { 43,  40,   1}, { 43,  46,   1}, { 43,  48,   1},
+    { 44,  26,   1}, { 44,  27,   2}, { 44,  35,   2}, { 44,  36,   1}, { 44,  37,   6}, { 44,  38,   1},
+    { 44,  44,   1}, { 44,  45,   1}, { 45,  28,   1}, { 45,  35,   2}, { 45,  45,   2}, { 46,  24,   1},
+    { 46,  28,   1}, { 46,  30,   1}, { 46,  36,   1}, { 46,  37,   2}, { 46,  38,   1}, { 46,  40,   2},
+    { 47,  24,   1}, { 47,  30,   1}, { 47,  35,   2}, { 47,  37,   1}, { 47,  44,   2}, { 47,  45,   2},
+    { 49,  28,   1}, { 49,  35,   2}, { 49,  37,   1}, { 49,  38,   1}, { 49,  44,   1}, { 49,  45,   1},
+    { 49,  48,   1}, { 50,  35,   1}, { 50,  38,   1}, { 50,  40,   1}, { 50,  45,   2}, { 51,  35,   1},
+    { 51,  37,   1}, { 51,  45,   1}, { 51,  47,   1}, { 52,  36,   1}, { 53,  36,   1}, { 53,  38,   1},
+    { 53,  40,   1}, { 55,  35,   1}, { 55,  39,   1}, { 58,  38,   1}, { 58,  40,   1}, { 58,  45,   1},
+    { 61,  35,   2}, { 61,  39,   1}, { 61,  45,   1}, { 62,  35,   1}, { 62,  39,   1}, { 68,  35,   1},
+    { 68,  45,   1}, { 69,  35,   1}, { 69,  45,   1},
+};
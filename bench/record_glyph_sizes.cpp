@@ -0,0 +1,106 @@
+// Prints bench/glyph_sizes.h: the atlas rectangle (rasterized buffer size) of every glyph of
+// U+0021..U+024F in four DejaVu faces at seven UI sizes, as a (width, height, count) histogram.
+// Usage: record_glyph_sizes > bench/glyph_sizes.h
+
+#include "bench.h"
+
+using namespace ntext;
+
+int main()
+{
+    const char *Faces[] = {"DejaVuSans.ttf", "DejaVuSerif.ttf", "DejaVuSansMono.ttf", "DejaVuSans-Bold.ttf"};
+    float       Sizes[] = {11.f, 13.f, 16.f, 20.f, 24.f, 32.f, 48.f};
+
+    memory_arena *Arena = CreateBenchArena(16ull << 20);
+    if(!Arena)
+    {
+        return 1;
+    }
+
+    static uint32_t Histogram[256][256];
+
+    backend_context Backend = InitializeBackendContext();
+    uint32_t        Total   = 0;
+
+    for(const char *Face : Faces)
+    {
+        char Path[512];
+        snprintf(Path, sizeof(Path), "%s%s", NTEXT_BENCH_FONT_DIR, Face);
+
+        for(float Size : Sizes)
+        {
+            memory_region FontRegion = EnterMemoryRegion(Arena);
+
+            system_font Font = LoadFontFromFile(Path, Size, Arena, Backend);
+            if(!IsValidSystemFont(&Font))
+            {
+                fprintf(stderr, "could not load %s\n", Path);
+                return 1;
+            }
+
+            for(uint32_t Codepoint = 0x21; Codepoint < 0x250; ++Codepoint)
+            {
+                uint16_t GlyphIndex = FindGlyphIndex(Codepoint, Font);
+                if((Codepoint >= 0x7F && Codepoint < 0xA1) || !GlyphIndex)
+                {
+                    continue;
+                }
+
+                memory_region Region = EnterMemoryRegion(Arena);
+
+                rasterized_buffer Buffer = RasterizeGlyphToAlphaTexture(GlyphIndex, 0.f, 0.f, Font, Backend, Arena);
+                if(Buffer.Data && Buffer.Width < 256 && Buffer.Height < 256)
+                {
+                    Histogram[Buffer.Width][Buffer.Height] += 1;
+                    Total                                  += 1;
+                }
+
+                LeaveMemoryRegion(Region);
+            }
+
+            ReleaseFont(&Font, Backend);
+            LeaveMemoryRegion(FontRegion);
+        }
+    }
+
+    uint32_t BinCount = 0;
+    for(uint32_t Width = 0; Width < 256; ++Width)
+    {
+        for(uint32_t Height = 0; Height < 256; ++Height)
+        {
+            BinCount += Histogram[Width][Height] != 0;
+        }
+    }
+
+    printf("#pragma once\n\n");
+    printf("// Recorded by record_glyph_sizes.cpp: atlas rectangles of U+0021..U+024F in DejaVu Sans, Serif,\n");
+    printf("// Sans Mono and Sans Bold at 11, 13, 16, 20, 24, 32 and 48px. %u glyphs.\n\n", Total);
+    printf("#include <stdint.h>\n\n");
+    printf("struct glyph_size_bin\n{\n    uint16_t Width;\n    uint16_t Height;\n    uint32_t Count;\n};\n\n");
+    printf("constexpr uint32_t GlyphSizeBinCount   = %u;\n", BinCount);
+    printf("constexpr uint32_t GlyphSizeGlyphCount = %u;\n\n", Total);
+    printf("static const glyph_size_bin GlyphSizeBins[GlyphSizeBinCount] =\n{\n");
+
+    uint32_t Column = 0;
+    for(uint32_t Width = 0; Width < 256; ++Width)
+    {
+        for(uint32_t Height = 0; Height < 256; ++Height)
+        {
+            if(Histogram[Width][Height])
+            {
+                printf("%s{%3u, %3u, %3u},", Column ? " " : "    ", Width, Height, Histogram[Width][Height]);
+                if(++Column == 6)
+                {
+                    printf("\n");
+                    Column = 0;
+                }
+            }
+        }
+    }
+
+    printf("%s};\n", Column ? "\n" : "");
+
+    free(Arena);
+
+    return 0;
+}
@@ -5,8 +5,7 @@
 #include <d3dcompiler.h>
 #include <dxgi1_3.h>
 #include <dxgidebug.h>
-#include "./d3d11_ps.h"
-#include "./d3d11_vs.h"
+#include "./d3d11_shader.h"
 #pragma comment (lib, "d3d11")
 #pragma comment (lib, "dxgi")
 #pragma comment (lib, "dxguid")
@@ -63,6 +62,7 @@ private:
         ntext::rectangle Bounds;
         ntext::rectangle Source;
         float            R, G, B, A;
+        float            AtlasPage;
     };
 };
 
@@ -126,8 +126,21 @@ void d3d11_renderer::Init(void *WindowHandle, int Width, int Height)
 
     ASSERT(this->SwapChain);
 
-    this->Device->CreateVertexShader(D3D11VtxShaderBytes, sizeof(D3D11VtxShaderBytes), 0, &this->VtxShader);
-    this->Device->CreatePixelShader(D3D11PxlShaderBytes, sizeof(D3D11PxlShaderBytes), 0, &this->PxlShader);
+    ID3DBlob *VtxBlob = nullptr;
+    ID3DBlob *PxlBlob = nullptr;
+    {
+        UINT Flags = D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_ENABLE_STRICTNESS;
+
+        D3DCompile(D3D11ShaderSource, sizeof(D3D11ShaderSource) - 1, "d3d11_shader", nullptr, nullptr,
+                   "VertexMain", "vs_5_0", Flags, 0, &VtxBlob, nullptr);
+        D3DCompile(D3D11ShaderSource, sizeof(D3D11ShaderSource) - 1, "d3d11_shader", nullptr, nullptr,
+                   "PixelMain", "ps_5_0", Flags, 0, &PxlBlob, nullptr);
+
+        ASSERT(VtxBlob && PxlBlob);
+    }
+
+    this->Device->CreateVertexShader(VtxBlob->GetBufferPointer(), VtxBlob->GetBufferSize(), 0, &this->VtxShader);
+    this->Device->CreatePixelShader(PxlBlob->GetBufferPointer(), PxlBlob->GetBufferSize(), 0, &this->PxlShader);
 
     ASSERT(this->VtxShader);
     ASSERT(this->PxlShader);
@@ -180,17 +193,18 @@ void d3d11_renderer::Init(void *WindowHandle, int Width, int Height)
     this->Device->CreateRasterizerState(&RasterizerDesc, &this->RasterState);
     ASSERT(this->RasterState);
 
+    // One slice per atlas page. Dynamic textures cannot be arrays, glyphs are copied in with UpdateSubresource.
     {
         D3D11_TEXTURE2D_DESC AtlasDesc = {};
         AtlasDesc.Width          = this->AtlasWidth;
         AtlasDesc.Height         = this->AtlasHeight;
         AtlasDesc.MipLevels      = 1;
-        AtlasDesc.ArraySize      = 1;
-        AtlasDesc.Format         = DXGI_FORMAT_R8G8B8A8_UNORM;
+        AtlasDesc.ArraySize      = ntext::GlyphAtlasMaxPages;
+        AtlasDesc.Format         = DXGI_FORMAT_R8_UNORM;
         AtlasDesc.SampleDesc.Count = 1;
-        AtlasDesc.Usage          = D3D11_USAGE_DYNAMIC;
+        AtlasDesc.Usage          = D3D11_USAGE_DEFAULT;
         AtlasDesc.BindFlags      = D3D11_BIND_SHADER_RESOURCE;
-        AtlasDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        AtlasDesc.CPUAccessFlags = 0;
         AtlasDesc.MiscFlags      = 0;
 
         HRESULT hr = this->Device->CreateTexture2D(&AtlasDesc, nullptr, &this->AtlasTexture);
@@ -198,9 +212,11 @@ void d3d11_renderer::Init(void *WindowHandle, int Width, int Height)
 
         D3D11_SHADER_RESOURCE_VIEW_DESC SRVDesc = {};
         SRVDesc.Format = AtlasDesc.Format;
-        SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-        SRVDesc.Texture2D.MostDetailedMip = 0;
-        SRVDesc.Texture2D.MipLevels = 1;
+        SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+        SRVDesc.Texture2DArray.MostDetailedMip = 0;
+        SRVDesc.Texture2DArray.MipLevels       = 1;
+        SRVDesc.Texture2DArray.FirstArraySlice = 0;
+        SRVDesc.Texture2DArray.ArraySize       = AtlasDesc.ArraySize;
 
         hr = this->Device->CreateShaderResourceView(this->AtlasTexture, &SRVDesc, &this->AtlasSRV);
         ASSERT(SUCCEEDED(hr) && this->AtlasSRV);
@@ -212,13 +228,17 @@ void d3d11_renderer::Init(void *WindowHandle, int Width, int Height)
             { "POS",  0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0,  0, D3D11_INPUT_PER_INSTANCE_DATA, 1 }, // Bounds
             { "FONT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 }, // Source
             { "COL",  0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 }, // Color (R,G,B,A)
+            { "PAGE", 0, DXGI_FORMAT_R32_FLOAT,          0, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 }, // Atlas page
         };
 
-        HRESULT hr = this->Device->CreateInputLayout(LayoutDesc, ARRAYSIZE(LayoutDesc), D3D11VtxShaderBytes, sizeof(D3D11VtxShaderBytes), &this->InputLayout);
+        HRESULT hr = this->Device->CreateInputLayout(LayoutDesc, ARRAYSIZE(LayoutDesc), VtxBlob->GetBufferPointer(), VtxBlob->GetBufferSize(), &this->InputLayout);
 
         ASSERT(SUCCEEDED(hr) && this->InputLayout);
     }
 
+    VtxBlob->Release();
+    PxlBlob->Release();
+
     {
         D3D11_BUFFER_DESC BufferDesc = {};
         BufferDesc.Usage          = D3D11_USAGE_DYNAMIC;
@@ -268,58 +288,38 @@ void d3d11_renderer::Clear(float R, float G, float B, float A)
 
 void d3d11_renderer::UpdateTextCache(const ntext::rasterized_glyph_list &List)
 {
-    D3D11_MAPPED_SUBRESOURCE Mapped = {};
-    HRESULT HR = this->DeviceContext->Map(this->AtlasTexture, 0, D3D11_MAP_WRITE_DISCARD, 0, &Mapped);
-    ASSERT(SUCCEEDED(HR) && Mapped.pData);
-
-    // Atlas is forced to RGBA8 for now.
-    uint32_t AtlasBPP      = 4;
-    uint8_t *AtlasBase     = (uint8_t *)Mapped.pData;
-    uint32_t AtlasRowPitch = (uint32_t)Mapped.RowPitch;
-
     for (ntext::rasterized_glyph_node *Node = List.First; Node != 0; Node = Node->Next)
     {
         ntext::rasterized_glyph  &Glyph  = Node->Value;
         ntext::rasterized_buffer &Buffer = Glyph.Buffer;
 
-        // Assume alpha-only source for now.
+        // Assume alpha-only source for now, the atlas slices are R8.
         ASSERT(Buffer.BytesPerPixel == 1);
+        ASSERT(Glyph.AtlasPage < ntext::GlyphAtlasMaxPages);
 
         uint32_t DstLeft   = (uint32_t)Glyph.Source.Left;
         uint32_t DstTop    = (uint32_t)Glyph.Source.Top;
         uint32_t DstRight  = (uint32_t)Glyph.Source.Right;
         uint32_t DstBottom = (uint32_t)Glyph.Source.Bottom;
 
-        uint32_t CopyWidth  = (DstRight  > DstLeft) ? (DstRight - DstLeft) : 0;
-        uint32_t CopyHeight = (DstBottom > DstTop)  ? (DstBottom - DstTop) : 0;
-        if (CopyWidth == 0 || CopyHeight == 0) continue;
-
-        // Assert the glyph rectangle fits inside mapped texture memory (caller guarantee)
-        // We can't get exact atlas width/height from Mapped, but assume caller ensures this.
-        ASSERT(AtlasRowPitch >= CopyWidth * AtlasBPP);
+        if (DstRight <= DstLeft || DstBottom <= DstTop) continue;
 
-        uint8_t *SrcBase   = (uint8_t *)Buffer.Data;
-        uint32_t SrcStride = Buffer.Stride ? Buffer.Stride : CopyWidth;
+        // The caller guarantees the glyph rectangle fits inside the atlas.
+        ASSERT(DstRight <= (uint32_t)this->AtlasWidth && DstBottom <= (uint32_t)this->AtlasHeight);
 
-        for (uint32_t y = 0; y < Buffer.Height; ++y)
-        {
-            uint8_t *SrcRow = SrcBase   + (size_t)y * SrcStride;
-            uint8_t *DstRow = AtlasBase + (size_t)(DstTop + y) * AtlasRowPitch + (size_t)DstLeft * AtlasBPP;
+        D3D11_BOX Box = {};
+        Box.left   = DstLeft;
+        Box.top    = DstTop;
+        Box.front  = 0;
+        Box.right  = DstLeft + Buffer.Width;
+        Box.bottom = DstTop  + Buffer.Height;
+        Box.back   = 1;
 
-            for (uint32_t x = 0; x < Buffer.Width; ++x)
-            {
-                uint8_t  Alpha    = SrcRow[x];
-                uint8_t *DstPixel = DstRow + (size_t)x * AtlasBPP;
+        UINT Subresource = Glyph.AtlasPage; // Mip 0 of that slice, there is one mip.
+        UINT SrcStride   = Buffer.Stride ? Buffer.Stride : Buffer.Width;
 
-                DstPixel[0] = 0xFF;
-                DstPixel[1] = 0xFF;
-                DstPixel[2] = 0xFF;
-                DstPixel[3] = Alpha;
-            }
-        }
+        this->DeviceContext->UpdateSubresource(this->AtlasTexture, Subresource, &Box, Buffer.Data, SrcStride, 0);
     }
-
-    this->DeviceContext->Unmap(this->AtlasTexture, 0);
 }
 
 void d3d11_renderer::DrawTextToScreen(void)
@@ -346,12 +346,13 @@ void d3d11_renderer::DrawTextToScreen(void)
 
     glyph_vertex Glyph =
     {
-        .Bounds = Bounds,
-        .Source = Source,
-        .R      = 1.f,
-        .G      = 0.f,
-        .B      = 0.f,
-        .A      = 1.f,
+        .Bounds    = Bounds,
+        .Source    = Source,
+        .R         = 1.f,
+        .G         = 0.f,
+        .B         = 0.f,
+        .A         = 1.f,
+        .AtlasPage = 0.f,
     };
 
     D3D11_MAPPED_SUBRESOURCE Mapped = {};
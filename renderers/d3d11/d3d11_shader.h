@@ -1,3 +1,9 @@
+#pragma once
+
+// Compiled by d3d11_renderer::Init with D3DCompile, entry points VertexMain (vs_5_0) and PixelMain (ps_5_0).
+// The atlas is a Texture2DArray with one R8 slice per atlas page.
+
+static const char D3D11ShaderSource[] = R"hlsl(
 // [Inputs/Outputs]
 
 cbuffer Constants : register(b0)
@@ -12,6 +18,7 @@ struct CPUToVertex
     float4 RectInPixel     : POS;
     float4 AtlasSrcInPixel : FONT;
     float4 Color           : COL;
+    float  AtlasPage       : PAGE;
     uint   VertexId        : SV_VertexID;
 };
 
@@ -19,11 +26,11 @@ struct VertexToPixel
 {
     float4 Position          : SV_POSITION;
     float4 Color             : COL;
-    float2 TexCoordInPercent : TXP;
+    float3 TexCoordInPercent : TXP; // z is the atlas page
 };
 
-Texture2D    AtlasTexture : register(t0);
-SamplerState AtlasSampler : register(s0);
+Texture2DArray AtlasTexture : register(t0);
+SamplerState   AtlasSampler : register(s0);
 
 // -------------------------------------------------------------
 
@@ -59,7 +66,7 @@ VertexToPixel VertexMain(CPUToVertex Input)
     Output.Position.w  = 1.f;
 
     Output.Color             = Input.Color;
-    Output.TexCoordInPercent = AtlasSourceInPixel[Input.VertexId] / AtlasSizeInPixel;
+    Output.TexCoordInPercent = float3(AtlasSourceInPixel[Input.VertexId] / AtlasSizeInPixel, Input.AtlasPage);
 
     return Output;
 }
@@ -68,8 +75,9 @@ VertexToPixel VertexMain(CPUToVertex Input)
 
 float4 PixelMain(VertexToPixel Input) : SV_TARGET
 {
-    float4 Sample = AtlasTexture.Sample(AtlasSampler, Input.TexCoordInPercent);
-    Sample *= Input.Color;
+    float  Coverage = AtlasTexture.Sample(AtlasSampler, Input.TexCoordInPercent).r;
+    float4 Sample   = float4(Input.Color.rgb, Input.Color.a * Coverage);
 
     return Sample;
 }
+)hlsl";
@@ -1,360 +0,0 @@
-#if 0
-//
-// Generated by Microsoft (R) HLSL Shader Compiler 10.1
-//
-//
-// Buffer Definitions: 
-//
-// cbuffer Constants
-// {
-//
-//   float3x3 Transform;                // Offset:    0 Size:    44
-//   float2 ViewportSizeInPixel;        // Offset:   48 Size:     8
-//   float2 AtlasSizeInPixel;           // Offset:   56 Size:     8
-//
-// }
-//
-//
-// Resource Bindings:
-//
-// Name                                 Type  Format         Dim      HLSL Bind  Count
-// ------------------------------ ---------- ------- ----------- -------------- ------
-// Constants                         cbuffer      NA          NA            cb0      1 
-//
-//
-//
-// Input signature:
-//
-// Name                 Index   Mask Register SysValue  Format   Used
-// -------------------- ----- ------ -------- -------- ------- ------
-// POS                      0   xyzw        0     NONE   float   xyzw
-// FONT                     0   xyzw        1     NONE   float   xyzw
-// COL                      0   xyzw        2     NONE   float   xyzw
-// SV_VertexID              0   x           3   VERTID    uint   x   
-//
-//
-// Output signature:
-//
-// Name                 Index   Mask Register SysValue  Format   Used
-// -------------------- ----- ------ -------- -------- ------- ------
-// SV_POSITION              0   xyzw        0      POS   float   xyzw
-// COL                      0   xyzw        1     NONE   float   xyzw
-// TXP                      0   xy          2     NONE   float   xy  
-//
-vs_5_0
-dcl_globalFlags refactoringAllowed
-dcl_constantbuffer CB0[4], immediateIndexed
-dcl_input v0.xyzw
-dcl_input v1.xyzw
-dcl_input v2.xyzw
-dcl_input_sgv v3.x, vertex_id
-dcl_output_siv o0.xyzw, position
-dcl_output o1.xyzw
-dcl_output o2.xy
-dcl_temps 1
-dcl_indexableTemp x0[4], 4
-dcl_indexableTemp x1[4], 4
-mov x0[0].xy, v0.xwxx
-mov x0[1].xy, v0.xyxx
-mov x0[2].xy, v0.zwzz
-mov x0[3].xy, v0.zyzz
-mov x1[0].xy, v1.xwxx
-mov x1[1].xy, v1.xyxx
-mov x1[2].xy, v1.zwzz
-mov x1[3].xy, v1.zyzz
-mov r0.x, v3.x
-mov r0.yz, x0[r0.x + 0].xxyx
-mov r0.xw, x1[r0.x + 0].xxxy
-div o2.xy, r0.xwxx, cb0[3].zwzz
-mul r0.xz, r0.zzzz, cb0[1].xxyx
-mad r0.xy, cb0[0].xyxx, r0.yyyy, r0.xzxx
-add r0.xy, r0.xyxx, cb0[2].xyxx
-add r0.z, -r0.y, cb0[3].y
-add r0.xy, r0.xzxx, r0.xzxx
-div r0.xy, r0.xyxx, cb0[3].xyxx
-add o0.xy, r0.xyxx, l(-1.000000, -1.000000, 0.000000, 0.000000)
-mov o0.zw, l(0,0,0,1.000000)
-mov o1.xyzw, v2.xyzw
-ret 
-// Approximately 22 instruction slots used
-#endif
-
-const BYTE D3D11VtxShaderBytes[] =
-{
-     68,  88,  66,  67, 141, 181, 
-    154,  60, 252, 161, 138, 201, 
-    166,   7,  45,  89,  20,  18, 
-    106, 180,   1,   0,   0,   0, 
-    120,   6,   0,   0,   5,   0, 
-      0,   0,  52,   0,   0,   0, 
-    232,   1,   0,   0, 116,   2, 
-      0,   0, 224,   2,   0,   0, 
-    220,   5,   0,   0,  82,  68, 
-     69,  70, 172,   1,   0,   0, 
-      1,   0,   0,   0, 104,   0, 
-      0,   0,   1,   0,   0,   0, 
-     60,   0,   0,   0,   0,   5, 
-    254, 255,   0,   1,   0,   0, 
-    129,   1,   0,   0,  82,  68, 
-     49,  49,  60,   0,   0,   0, 
-     24,   0,   0,   0,  32,   0, 
-      0,   0,  40,   0,   0,   0, 
-     36,   0,   0,   0,  12,   0, 
-      0,   0,   0,   0,   0,   0, 
-     92,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      1,   0,   0,   0,   1,   0, 
-      0,   0,  67, 111, 110, 115, 
-    116,  97, 110, 116, 115,   0, 
-    171, 171,  92,   0,   0,   0, 
-      3,   0,   0,   0, 128,   0, 
-      0,   0,  64,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0, 248,   0,   0,   0, 
-      0,   0,   0,   0,  44,   0, 
-      0,   0,   2,   0,   0,   0, 
-     12,   1,   0,   0,   0,   0, 
-      0,   0, 255, 255, 255, 255, 
-      0,   0,   0,   0, 255, 255, 
-    255, 255,   0,   0,   0,   0, 
-     48,   1,   0,   0,  48,   0, 
-      0,   0,   8,   0,   0,   0, 
-      2,   0,   0,   0,  76,   1, 
-      0,   0,   0,   0,   0,   0, 
-    255, 255, 255, 255,   0,   0, 
-      0,   0, 255, 255, 255, 255, 
-      0,   0,   0,   0, 112,   1, 
-      0,   0,  56,   0,   0,   0, 
-      8,   0,   0,   0,   2,   0, 
-      0,   0,  76,   1,   0,   0, 
-      0,   0,   0,   0, 255, 255, 
-    255, 255,   0,   0,   0,   0, 
-    255, 255, 255, 255,   0,   0, 
-      0,   0,  84, 114,  97, 110, 
-    115, 102, 111, 114, 109,   0, 
-    102, 108, 111,  97, 116,  51, 
-    120,  51,   0, 171,   3,   0, 
-      3,   0,   3,   0,   3,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      2,   1,   0,   0,  86, 105, 
-    101, 119, 112, 111, 114, 116, 
-     83, 105, 122, 101,  73, 110, 
-     80, 105, 120, 101, 108,   0, 
-    102, 108, 111,  97, 116,  50, 
-      0, 171,   1,   0,   3,   0, 
-      1,   0,   2,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,  68,   1, 
-      0,   0,  65, 116, 108,  97, 
-    115,  83, 105, 122, 101,  73, 
-    110,  80, 105, 120, 101, 108, 
-      0,  77, 105,  99, 114, 111, 
-    115, 111, 102, 116,  32,  40, 
-     82,  41,  32,  72,  76,  83, 
-     76,  32,  83, 104,  97, 100, 
-    101, 114,  32,  67, 111, 109, 
-    112, 105, 108, 101, 114,  32, 
-     49,  48,  46,  49,   0, 171, 
-    171, 171,  73,  83,  71,  78, 
-    132,   0,   0,   0,   4,   0, 
-      0,   0,   8,   0,   0,   0, 
-    104,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      3,   0,   0,   0,   0,   0, 
-      0,   0,  15,  15,   0,   0, 
-    108,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      3,   0,   0,   0,   1,   0, 
-      0,   0,  15,  15,   0,   0, 
-    113,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      3,   0,   0,   0,   2,   0, 
-      0,   0,  15,  15,   0,   0, 
-    117,   0,   0,   0,   0,   0, 
-      0,   0,   6,   0,   0,   0, 
-      1,   0,   0,   0,   3,   0, 
-      0,   0,   1,   1,   0,   0, 
-     80,  79,  83,   0,  70,  79, 
-     78,  84,   0,  67,  79,  76, 
-      0,  83,  86,  95,  86, 101, 
-    114, 116, 101, 120,  73,  68, 
-      0, 171, 171, 171,  79,  83, 
-     71,  78, 100,   0,   0,   0, 
-      3,   0,   0,   0,   8,   0, 
-      0,   0,  80,   0,   0,   0, 
-      0,   0,   0,   0,   1,   0, 
-      0,   0,   3,   0,   0,   0, 
-      0,   0,   0,   0,  15,   0, 
-      0,   0,  92,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   3,   0,   0,   0, 
-      1,   0,   0,   0,  15,   0, 
-      0,   0,  96,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   3,   0,   0,   0, 
-      2,   0,   0,   0,   3,  12, 
-      0,   0,  83,  86,  95,  80, 
-     79,  83,  73,  84,  73,  79, 
-     78,   0,  67,  79,  76,   0, 
-     84,  88,  80,   0,  83,  72, 
-     69,  88, 244,   2,   0,   0, 
-     80,   0,   1,   0, 189,   0, 
-      0,   0, 106,   8,   0,   1, 
-     89,   0,   0,   4,  70, 142, 
-     32,   0,   0,   0,   0,   0, 
-      4,   0,   0,   0,  95,   0, 
-      0,   3, 242,  16,  16,   0, 
-      0,   0,   0,   0,  95,   0, 
-      0,   3, 242,  16,  16,   0, 
-      1,   0,   0,   0,  95,   0, 
-      0,   3, 242,  16,  16,   0, 
-      2,   0,   0,   0,  96,   0, 
-      0,   4,  18,  16,  16,   0, 
-      3,   0,   0,   0,   6,   0, 
-      0,   0, 103,   0,   0,   4, 
-    242,  32,  16,   0,   0,   0, 
-      0,   0,   1,   0,   0,   0, 
-    101,   0,   0,   3, 242,  32, 
-     16,   0,   1,   0,   0,   0, 
-    101,   0,   0,   3,  50,  32, 
-     16,   0,   2,   0,   0,   0, 
-    104,   0,   0,   2,   1,   0, 
-      0,   0, 105,   0,   0,   4, 
-      0,   0,   0,   0,   4,   0, 
-      0,   0,   4,   0,   0,   0, 
-    105,   0,   0,   4,   1,   0, 
-      0,   0,   4,   0,   0,   0, 
-      4,   0,   0,   0,  54,   0, 
-      0,   6,  50,  48,  32,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0, 198,  16,  16,   0, 
-      0,   0,   0,   0,  54,   0, 
-      0,   6,  50,  48,  32,   0, 
-      0,   0,   0,   0,   1,   0, 
-      0,   0,  70,  16,  16,   0, 
-      0,   0,   0,   0,  54,   0, 
-      0,   6,  50,  48,  32,   0, 
-      0,   0,   0,   0,   2,   0, 
-      0,   0, 230,  26,  16,   0, 
-      0,   0,   0,   0,  54,   0, 
-      0,   6,  50,  48,  32,   0, 
-      0,   0,   0,   0,   3,   0, 
-      0,   0, 102,  26,  16,   0, 
-      0,   0,   0,   0,  54,   0, 
-      0,   6,  50,  48,  32,   0, 
-      1,   0,   0,   0,   0,   0, 
-      0,   0, 198,  16,  16,   0, 
-      1,   0,   0,   0,  54,   0, 
-      0,   6,  50,  48,  32,   0, 
-      1,   0,   0,   0,   1,   0, 
-      0,   0,  70,  16,  16,   0, 
-      1,   0,   0,   0,  54,   0, 
-      0,   6,  50,  48,  32,   0, 
-      1,   0,   0,   0,   2,   0, 
-      0,   0, 230,  26,  16,   0, 
-      1,   0,   0,   0,  54,   0, 
-      0,   6,  50,  48,  32,   0, 
-      1,   0,   0,   0,   3,   0, 
-      0,   0, 102,  26,  16,   0, 
-      1,   0,   0,   0,  54,   0, 
-      0,   5,  18,   0,  16,   0, 
-      0,   0,   0,   0,  10,  16, 
-     16,   0,   3,   0,   0,   0, 
-     54,   0,   0,   7,  98,   0, 
-     16,   0,   0,   0,   0,   0, 
-      6,  49,  32,   4,   0,   0, 
-      0,   0,  10,   0,  16,   0, 
-      0,   0,   0,   0,  54,   0, 
-      0,   7, 146,   0,  16,   0, 
-      0,   0,   0,   0,   6,  52, 
-     32,   4,   1,   0,   0,   0, 
-     10,   0,  16,   0,   0,   0, 
-      0,   0,  14,   0,   0,   8, 
-     50,  32,  16,   0,   2,   0, 
-      0,   0, 198,   0,  16,   0, 
-      0,   0,   0,   0, 230, 138, 
-     32,   0,   0,   0,   0,   0, 
-      3,   0,   0,   0,  56,   0, 
-      0,   8,  82,   0,  16,   0, 
-      0,   0,   0,   0, 166,  10, 
-     16,   0,   0,   0,   0,   0, 
-      6, 129,  32,   0,   0,   0, 
-      0,   0,   1,   0,   0,   0, 
-     50,   0,   0,  10,  50,   0, 
-     16,   0,   0,   0,   0,   0, 
-     70, 128,  32,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-     86,   5,  16,   0,   0,   0, 
-      0,   0, 134,   0,  16,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   8,  50,   0,  16,   0, 
-      0,   0,   0,   0,  70,   0, 
-     16,   0,   0,   0,   0,   0, 
-     70, 128,  32,   0,   0,   0, 
-      0,   0,   2,   0,   0,   0, 
-      0,   0,   0,   9,  66,   0, 
-     16,   0,   0,   0,   0,   0, 
-     26,   0,  16, 128,  65,   0, 
-      0,   0,   0,   0,   0,   0, 
-     26, 128,  32,   0,   0,   0, 
-      0,   0,   3,   0,   0,   0, 
-      0,   0,   0,   7,  50,   0, 
-     16,   0,   0,   0,   0,   0, 
-    134,   0,  16,   0,   0,   0, 
-      0,   0, 134,   0,  16,   0, 
-      0,   0,   0,   0,  14,   0, 
-      0,   8,  50,   0,  16,   0, 
-      0,   0,   0,   0,  70,   0, 
-     16,   0,   0,   0,   0,   0, 
-     70, 128,  32,   0,   0,   0, 
-      0,   0,   3,   0,   0,   0, 
-      0,   0,   0,  10,  50,  32, 
-     16,   0,   0,   0,   0,   0, 
-     70,   0,  16,   0,   0,   0, 
-      0,   0,   2,  64,   0,   0, 
-      0,   0, 128, 191,   0,   0, 
-    128, 191,   0,   0,   0,   0, 
-      0,   0,   0,   0,  54,   0, 
-      0,   8, 194,  32,  16,   0, 
-      0,   0,   0,   0,   2,  64, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0, 128,  63, 
-     54,   0,   0,   5, 242,  32, 
-     16,   0,   1,   0,   0,   0, 
-     70,  30,  16,   0,   2,   0, 
-      0,   0,  62,   0,   0,   1, 
-     83,  84,  65,  84, 148,   0, 
-      0,   0,  22,   0,   0,   0, 
-      1,   0,   0,   0,   0,   0, 
-      0,   0,   7,   0,   0,   0, 
-      8,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      1,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      8,   0,   0,   0,  10,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      3,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0, 
-      0,   0,   0,   0,   0,   0
-};
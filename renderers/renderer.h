@@ -1,6 +1,10 @@
 #pragma once
 
+#if defined(_MSC_VER)
 #define ASSERT(Cond) do {if (!(Cond)) __assume(0);} while (0)
+#else
+#define ASSERT(Cond) do {if (!(Cond)) __builtin_unreachable();} while (0)
+#endif
 
 class IRenderer
 {
@@ -14,4 +18,7 @@ public:
     virtual void DrawTextToScreen (void)                                     = 0;
 };
 
+#ifdef _WIN32
 #include "./d3d11/d3d11.h"
+#endif
+#include "./software/software.h"
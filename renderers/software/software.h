@@ -0,0 +1,531 @@
+#include "../renderer.h"
+
+#include <immintrin.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Headless renderer. Draws into a framebuffer owned by the caller, so it runs on machines
+// without a GPU and gives byte-exact output for regression tests.
+//
+// Init takes a software_target * in place of the window handle: the framebuffer to draw into and
+// the generator whose atlas it mirrors. RGBA targets are 4 bytes per pixel, GreyScale targets are
+// 1 byte per pixel and take the red channel as intensity.
+//
+// Glyphs with a scale other than 1 or coming from a distance field atlas go through a slower
+// bilinear path, everything else is copied texel for texel.
+//
+// Every atlas page the generator opens gets its own CacheSizeX * CacheSizeY plane, allocated on
+// first upload. Release (or the destructor) frees them along with the queued quads.
+
+struct software_framebuffer
+{
+    void                *Pixels;
+    uint32_t             Width;
+    uint32_t             Height;
+    uint32_t             Stride;
+    ntext::TextureFormat Format;
+};
+
+struct software_target
+{
+    software_framebuffer          Framebuffer;
+    const ntext::glyph_generator *Generator;
+};
+
+class software_renderer : public IRenderer
+{
+
+public:
+    ~software_renderer();
+
+    void Init             (void *WindowHandle, int Width, int Height)  override;
+    void Clear            (float R, float G, float B, float A)         override;
+    void Present          ()                                           override;
+    void UpdateTextCache  (const ntext::rasterized_glyph_list &List)   override;
+    void DrawTextToScreen (void)                                       override;
+
+    // Queues a shaped run with its pen starting at (X, Y) on the baseline. Flushed by DrawTextToScreen.
+    // Runs shaped with subpixel bins picked their variants for a pen starting at 0, so X should be a whole pixel.
+    void PushGlyphRun     (const ntext::shaped_glyph_run &Run, float X, float Y, float R, float G, float B, float A);
+
+    // Applies the copies returned by ntext::CompactAtlas. Call it before drawing runs shaped after the compaction step.
+    void MoveTextCache    (const ntext::atlas_move_list &List);
+
+    // Frees the atlas planes and the quad buffer. Init can be called again afterwards.
+    void Release          ();
+
+private:
+
+    struct glyph_quad
+    {
+        ntext::rectangle Bounds;
+        ntext::rectangle Source;
+        uint32_t         AtlasPage;
+        float            Scale;
+        float            DistanceRange;
+        float            R, G, B, A;
+    };
+
+    void BlendQuad       (const glyph_quad &Quad);
+    void BlendQuadScaled (const glyph_quad &Quad);
+
+    // Target
+    software_framebuffer Target;
+
+    // Text Stuff
+    uint8_t             *AtlasPages[ntext::GlyphAtlasMaxPages] = {};
+    uint32_t             AtlasWidth  = 0;
+    uint32_t             AtlasHeight = 0;
+
+    glyph_quad          *Quads        = 0;
+    uint32_t             QuadCount    = 0;
+    uint32_t             QuadCapacity = 0;
+};
+
+static inline uint8_t
+SoftwareUnitToByte(float Value)
+{
+    Value = Value < 0.f ? 0.f : (Value > 1.f ? 1.f : Value);
+
+    uint8_t Result = (uint8_t)(Value * 255.f + 0.5f);
+    return Result;
+}
+
+// Exact round(X / 255) for X in [0, 255 * 255].
+
+static inline uint32_t
+SoftwareDiv255(uint32_t X)
+{
+    uint32_t Result = ((X + 128) * 257) >> 16;
+    return Result;
+}
+
+static inline __m128i
+SoftwareDiv255x8(__m128i X)
+{
+    __m128i Result = _mm_mulhi_epu16(_mm_add_epi16(X, _mm_set1_epi16(128)), _mm_set1_epi16(257));
+    return Result;
+}
+
+void software_renderer::Init(void *WindowHandle, int Width, int Height)
+{
+    ASSERT(WindowHandle);
+
+    software_target *Desc = (software_target *)WindowHandle;
+    ASSERT(Desc->Generator);
+
+    this->Release();
+    this->Target = Desc->Framebuffer;
+
+    ASSERT(this->Target.Pixels);
+    ASSERT(this->Target.Width  == (uint32_t)Width);
+    ASSERT(this->Target.Height == (uint32_t)Height);
+    ASSERT(this->Target.Format == ntext::TextureFormat::RGBA || this->Target.Format == ntext::TextureFormat::GreyScale);
+
+    if(this->Target.Stride == 0)
+    {
+        this->Target.Stride = this->Target.Width * (this->Target.Format == ntext::TextureFormat::RGBA ? 4 : 1);
+    }
+
+    // The atlas is alpha only, there is no reason to expand it to RGBA when we sample on the CPU.
+    this->AtlasWidth  = Desc->Generator->CacheSizeX;
+    this->AtlasHeight = Desc->Generator->CacheSizeY;
+    ASSERT(this->AtlasWidth && this->AtlasHeight);
+
+    this->AtlasPages[0] = (uint8_t *)calloc((size_t)this->AtlasWidth * this->AtlasHeight, 1);
+    ASSERT(this->AtlasPages[0]);
+
+    this->QuadCount    = 0;
+    this->QuadCapacity = 4096;
+    this->Quads        = (glyph_quad *)malloc(this->QuadCapacity * sizeof(glyph_quad));
+    ASSERT(this->Quads);
+}
+
+software_renderer::~software_renderer()
+{
+    this->Release();
+}
+
+void software_renderer::Release()
+{
+    for(uint32_t Page = 0; Page < ntext::GlyphAtlasMaxPages; ++Page)
+    {
+        free(this->AtlasPages[Page]);
+        this->AtlasPages[Page] = 0;
+    }
+
+    free(this->Quads);
+    this->Quads        = 0;
+    this->QuadCount    = 0;
+    this->QuadCapacity = 0;
+}
+
+void software_renderer::Clear(float R, float G, float B, float A)
+{
+    uint8_t Color[4] = {SoftwareUnitToByte(R), SoftwareUnitToByte(G), SoftwareUnitToByte(B), SoftwareUnitToByte(A)};
+
+    for(uint32_t Y = 0; Y < this->Target.Height; ++Y)
+    {
+        uint8_t *Row = (uint8_t *)this->Target.Pixels + (size_t)Y * this->Target.Stride;
+
+        if(this->Target.Format == ntext::TextureFormat::RGBA)
+        {
+            for(uint32_t X = 0; X < this->Target.Width; ++X)
+            {
+                memcpy(Row + X * 4, Color, 4);
+            }
+        }
+        else
+        {
+            memset(Row, Color[0], this->Target.Width);
+        }
+    }
+}
+
+void software_renderer::UpdateTextCache(const ntext::rasterized_glyph_list &List)
+{
+    for(ntext::rasterized_glyph_node *Node = List.First; Node != 0; Node = Node->Next)
+    {
+        ntext::rasterized_glyph  &Glyph  = Node->Value;
+        ntext::rasterized_buffer &Buffer = Glyph.Buffer;
+
+        // Assume alpha-only source for now.
+        ASSERT(Buffer.BytesPerPixel == 1);
+
+        uint32_t DstLeft = (uint32_t)Glyph.Source.Left;
+        uint32_t DstTop  = (uint32_t)Glyph.Source.Top;
+
+        if(DstLeft >= this->AtlasWidth || DstTop >= this->AtlasHeight || Glyph.AtlasPage >= ntext::GlyphAtlasMaxPages) continue;
+
+        uint8_t *&Atlas = this->AtlasPages[Glyph.AtlasPage];
+        if(!Atlas)
+        {
+            Atlas = (uint8_t *)calloc((size_t)this->AtlasWidth * this->AtlasHeight, 1);
+            ASSERT(Atlas);
+        }
+
+        uint32_t CopyWidth  = Buffer.Width;
+        uint32_t CopyHeight = Buffer.Height;
+        if(CopyWidth  > this->AtlasWidth  - DstLeft) CopyWidth  = this->AtlasWidth  - DstLeft;
+        if(CopyHeight > this->AtlasHeight - DstTop ) CopyHeight = this->AtlasHeight - DstTop;
+
+        uint8_t *SrcBase   = (uint8_t *)Buffer.Data;
+        uint32_t SrcStride = Buffer.Stride ? Buffer.Stride : Buffer.Width;
+
+        for(uint32_t Y = 0; Y < CopyHeight; ++Y)
+        {
+            uint8_t *SrcRow = SrcBase + (size_t)Y * SrcStride;
+            uint8_t *DstRow = Atlas + (size_t)(DstTop + Y) * this->AtlasWidth + DstLeft;
+
+            memcpy(DstRow, SrcRow, CopyWidth);
+        }
+    }
+}
+
+void software_renderer::MoveTextCache(const ntext::atlas_move_list &List)
+{
+    for(ntext::atlas_move_node *Node = List.First; Node != 0; Node = Node->Next)
+    {
+        ntext::atlas_move &Move = Node->Value;
+
+        if(Move.FromPage >= ntext::GlyphAtlasMaxPages || Move.ToPage >= ntext::GlyphAtlasMaxPages) continue;
+
+        uint8_t *Source = this->AtlasPages[Move.FromPage];
+        if(!Source) continue;
+
+        uint8_t *&Atlas = this->AtlasPages[Move.ToPage];
+        if(!Atlas)
+        {
+            Atlas = (uint8_t *)calloc((size_t)this->AtlasWidth * this->AtlasHeight, 1);
+            ASSERT(Atlas);
+        }
+
+        uint32_t SrcLeft = (uint32_t)Move.From.Left;
+        uint32_t SrcTop  = (uint32_t)Move.From.Top;
+        uint32_t DstLeft = (uint32_t)Move.To.Left;
+        uint32_t DstTop  = (uint32_t)Move.To.Top;
+
+        if(SrcLeft >= this->AtlasWidth || SrcTop >= this->AtlasHeight || DstLeft >= this->AtlasWidth || DstTop >= this->AtlasHeight) continue;
+
+        uint32_t CopyWidth  = (uint32_t)(Move.From.Right  - Move.From.Left);
+        uint32_t CopyHeight = (uint32_t)(Move.From.Bottom - Move.From.Top);
+        if(CopyWidth  > this->AtlasWidth  - SrcLeft) CopyWidth  = this->AtlasWidth  - SrcLeft;
+        if(CopyWidth  > this->AtlasWidth  - DstLeft) CopyWidth  = this->AtlasWidth  - DstLeft;
+        if(CopyHeight > this->AtlasHeight - SrcTop ) CopyHeight = this->AtlasHeight - SrcTop;
+        if(CopyHeight > this->AtlasHeight - DstTop ) CopyHeight = this->AtlasHeight - DstTop;
+
+        // Source and destination are different pages, rows never overlap.
+        for(uint32_t Y = 0; Y < CopyHeight; ++Y)
+        {
+            uint8_t *SrcRow = Source + (size_t)(SrcTop + Y) * this->AtlasWidth + SrcLeft;
+            uint8_t *DstRow = Atlas  + (size_t)(DstTop + Y) * this->AtlasWidth + DstLeft;
+
+            memcpy(DstRow, SrcRow, CopyWidth);
+        }
+    }
+}
+
+void software_renderer::PushGlyphRun(const ntext::shaped_glyph_run &Run, float X, float Y, float R, float G, float B, float A)
+{
+    float PenX = X;
+
+    for(uint32_t Idx = 0; Idx < Run.ShapedCount; ++Idx)
+    {
+        const ntext::shaped_glyph &Glyph = Run.Shaped[Idx];
+
+        float Scale  = Glyph.Scale > 0.f ? Glyph.Scale : 1.f;
+        float Width  = (Glyph.Source.Right  - Glyph.Source.Left) * Scale;
+        float Height = (Glyph.Source.Bottom - Glyph.Source.Top ) * Scale;
+
+        if(Width > 0.f && Height > 0.f)
+        {
+            if(this->QuadCount == this->QuadCapacity)
+            {
+                uint32_t    Capacity = this->QuadCapacity ? this->QuadCapacity * 2 : 4096;
+                glyph_quad *Grown    = (glyph_quad *)realloc(this->Quads, (size_t)Capacity * sizeof(glyph_quad));
+                ASSERT(Grown);
+
+                this->Quads        = Grown;
+                this->QuadCapacity = Capacity;
+            }
+
+            glyph_quad &Quad = this->Quads[this->QuadCount++];
+
+            Quad.Bounds.Left   = PenX + Glyph.Layout.OffsetX;
+            Quad.Bounds.Top    = Y    - Glyph.Layout.OffsetY;
+            Quad.Bounds.Right  = Quad.Bounds.Left + Width;
+            Quad.Bounds.Bottom = Quad.Bounds.Top  + Height;
+            Quad.Source        = Glyph.Source;
+            Quad.AtlasPage     = Glyph.AtlasPage;
+            Quad.Scale         = Scale;
+            Quad.DistanceRange = Run.DistanceRange;
+            Quad.R             = R;
+            Quad.G             = G;
+            Quad.B             = B;
+            Quad.A             = A;
+        }
+
+        PenX += Glyph.Layout.Advance;
+    }
+}
+
+// Atlas texels map 1:1 to target pixels (point sampling, like the D3D11 sampler).
+// Blending is "over": Dst = Src * Alpha + Dst * (1 - Alpha) with Alpha = Coverage * A.
+
+void software_renderer::BlendQuad(const glyph_quad &Quad)
+{
+    if(Quad.Scale != 1.f || Quad.DistanceRange > 0.f)
+    {
+        this->BlendQuadScaled(Quad);
+        return;
+    }
+
+    uint8_t *Atlas = this->AtlasPages[Quad.AtlasPage];
+    if(!Atlas)
+    {
+        return;
+    }
+
+    int32_t Left = (int32_t)floorf(Quad.Bounds.Left + 0.5f);
+    int32_t Top  = (int32_t)floorf(Quad.Bounds.Top  + 0.5f);
+
+    int32_t SrcLeft = (int32_t)Quad.Source.Left;
+    int32_t SrcTop  = (int32_t)Quad.Source.Top;
+    int32_t Width   = (int32_t)(Quad.Source.Right  - Quad.Source.Left);
+    int32_t Height  = (int32_t)(Quad.Source.Bottom - Quad.Source.Top);
+
+    // Clip against the target.
+
+    if(Left < 0) { SrcLeft -= Left; Width  += Left; Left = 0; }
+    if(Top  < 0) { SrcTop  -= Top;  Height += Top;  Top  = 0; }
+    if(Left + Width  > (int32_t)this->Target.Width ) Width  = (int32_t)this->Target.Width  - Left;
+    if(Top  + Height > (int32_t)this->Target.Height) Height = (int32_t)this->Target.Height - Top;
+
+    if(Width <= 0 || Height <= 0)
+    {
+        return;
+    }
+
+    uint32_t ColorA = SoftwareUnitToByte(Quad.A);
+    uint8_t  Color[4] = {SoftwareUnitToByte(Quad.R), SoftwareUnitToByte(Quad.G), SoftwareUnitToByte(Quad.B), 255};
+
+    __m128i Zero     = _mm_setzero_si128();
+    __m128i Full     = _mm_set1_epi16(255);
+    __m128i AlphaMul = _mm_set1_epi16((short)ColorA);
+
+    if(this->Target.Format == ntext::TextureFormat::RGBA)
+    {
+        // Two pixels per 16-bit vector, so the colour is repeated twice.
+        __m128i SrcColor = _mm_setr_epi16(Color[0], Color[1], Color[2], Color[3], Color[0], Color[1], Color[2], Color[3]);
+
+        for(int32_t Y = 0; Y < Height; ++Y)
+        {
+            uint8_t *SrcRow = Atlas + (size_t)(SrcTop + Y) * this->AtlasWidth + SrcLeft;
+            uint8_t *DstRow = (uint8_t *)this->Target.Pixels + (size_t)(Top + Y) * this->Target.Stride + (size_t)Left * 4;
+
+            int32_t X = 0;
+            for(; X + 4 <= Width; X += 4)
+            {
+                uint32_t Coverage4;
+                memcpy(&Coverage4, SrcRow + X, 4);
+                if(Coverage4 == 0) continue;
+
+                // c0 c1 c2 c3 -> c0 c0 c0 c0 c1 c1 c1 c1 ... so every channel gets its pixel's coverage.
+                __m128i Coverage = _mm_cvtsi32_si128((int)Coverage4);
+                Coverage = _mm_unpacklo_epi8 (Coverage, Coverage);
+                Coverage = _mm_unpacklo_epi16(Coverage, Coverage);
+
+                __m128i AlphaLo = SoftwareDiv255x8(_mm_mullo_epi16(_mm_unpacklo_epi8(Coverage, Zero), AlphaMul));
+                __m128i AlphaHi = SoftwareDiv255x8(_mm_mullo_epi16(_mm_unpackhi_epi8(Coverage, Zero), AlphaMul));
+
+                __m128i Dst   = _mm_loadu_si128((__m128i *)(DstRow + X * 4));
+                __m128i DstLo = _mm_unpacklo_epi8(Dst, Zero);
+                __m128i DstHi = _mm_unpackhi_epi8(Dst, Zero);
+
+                DstLo = SoftwareDiv255x8(_mm_add_epi16(_mm_mullo_epi16(SrcColor, AlphaLo), _mm_mullo_epi16(DstLo, _mm_sub_epi16(Full, AlphaLo))));
+                DstHi = SoftwareDiv255x8(_mm_add_epi16(_mm_mullo_epi16(SrcColor, AlphaHi), _mm_mullo_epi16(DstHi, _mm_sub_epi16(Full, AlphaHi))));
+
+                _mm_storeu_si128((__m128i *)(DstRow + X * 4), _mm_packus_epi16(DstLo, DstHi));
+            }
+
+            for(; X < Width; ++X)
+            {
+                uint32_t Alpha = SoftwareDiv255(SrcRow[X] * ColorA);
+                uint8_t *Pixel = DstRow + X * 4;
+
+                for(uint32_t Channel = 0; Channel < 4; ++Channel)
+                {
+                    Pixel[Channel] = (uint8_t)SoftwareDiv255(Color[Channel] * Alpha + Pixel[Channel] * (255 - Alpha));
+                }
+            }
+        }
+    }
+    else
+    {
+        __m128i SrcValue = _mm_set1_epi16(Color[0]);
+
+        for(int32_t Y = 0; Y < Height; ++Y)
+        {
+            uint8_t *SrcRow = Atlas + (size_t)(SrcTop + Y) * this->AtlasWidth + SrcLeft;
+            uint8_t *DstRow = (uint8_t *)this->Target.Pixels + (size_t)(Top + Y) * this->Target.Stride + Left;
+
+            int32_t X = 0;
+            for(; X + 16 <= Width; X += 16)
+            {
+                __m128i Coverage = _mm_loadu_si128((__m128i *)(SrcRow + X));
+
+                __m128i AlphaLo = SoftwareDiv255x8(_mm_mullo_epi16(_mm_unpacklo_epi8(Coverage, Zero), AlphaMul));
+                __m128i AlphaHi = SoftwareDiv255x8(_mm_mullo_epi16(_mm_unpackhi_epi8(Coverage, Zero), AlphaMul));
+
+                __m128i Dst   = _mm_loadu_si128((__m128i *)(DstRow + X));
+                __m128i DstLo = _mm_unpacklo_epi8(Dst, Zero);
+                __m128i DstHi = _mm_unpackhi_epi8(Dst, Zero);
+
+                DstLo = SoftwareDiv255x8(_mm_add_epi16(_mm_mullo_epi16(SrcValue, AlphaLo), _mm_mullo_epi16(DstLo, _mm_sub_epi16(Full, AlphaLo))));
+                DstHi = SoftwareDiv255x8(_mm_add_epi16(_mm_mullo_epi16(SrcValue, AlphaHi), _mm_mullo_epi16(DstHi, _mm_sub_epi16(Full, AlphaHi))));
+
+                _mm_storeu_si128((__m128i *)(DstRow + X), _mm_packus_epi16(DstLo, DstHi));
+            }
+
+            for(; X < Width; ++X)
+            {
+                uint32_t Alpha = SoftwareDiv255(SrcRow[X] * ColorA);
+                DstRow[X] = (uint8_t)SoftwareDiv255(Color[0] * Alpha + DstRow[X] * (255 - Alpha));
+            }
+        }
+    }
+}
+
+// Bilinear sampling of the atlas, clamped to the glyph's own texels so neighbours never bleed in.
+// Distance fields are decoded to screen pixels (see BuildSignedDistanceField) and give a one pixel wide edge.
+
+void software_renderer::BlendQuadScaled(const glyph_quad &Quad)
+{
+    uint8_t *Atlas = this->AtlasPages[Quad.AtlasPage];
+    if(!Atlas)
+    {
+        return;
+    }
+
+    int32_t Left   = (int32_t)floorf(Quad.Bounds.Left);
+    int32_t Top    = (int32_t)floorf(Quad.Bounds.Top);
+    int32_t Right  = (int32_t)ceilf (Quad.Bounds.Right);
+    int32_t Bottom = (int32_t)ceilf (Quad.Bounds.Bottom);
+
+    if(Left   < 0) Left = 0;
+    if(Top    < 0) Top  = 0;
+    if(Right  > (int32_t)this->Target.Width ) Right  = (int32_t)this->Target.Width;
+    if(Bottom > (int32_t)this->Target.Height) Bottom = (int32_t)this->Target.Height;
+
+    if(Right <= Left || Bottom <= Top)
+    {
+        return;
+    }
+
+    float    InvScale   = 1.f / Quad.Scale;
+    float    MaxU       = Quad.Source.Right  - Quad.Source.Left - 1.f;
+    float    MaxV       = Quad.Source.Bottom - Quad.Source.Top  - 1.f;
+    uint32_t BytesPerPx = this->Target.Format == ntext::TextureFormat::RGBA ? 4 : 1;
+    uint32_t ColorA     = SoftwareUnitToByte(Quad.A);
+    uint8_t  Color[4]   = {SoftwareUnitToByte(Quad.R), SoftwareUnitToByte(Quad.G), SoftwareUnitToByte(Quad.B), 255};
+
+    for(int32_t Y = Top; Y < Bottom; ++Y)
+    {
+        float V = ((float)Y + 0.5f - Quad.Bounds.Top) * InvScale - 0.5f;
+        V = V < 0.f ? 0.f : (V > MaxV ? MaxV : V);
+
+        int32_t V0 = (int32_t)V;
+        int32_t V1 = V0 + 1 <= (int32_t)MaxV ? V0 + 1 : V0;
+        float   FV = V - (float)V0;
+
+        uint8_t *Row0   = Atlas + (size_t)((int32_t)Quad.Source.Top + V0) * this->AtlasWidth + (int32_t)Quad.Source.Left;
+        uint8_t *Row1   = Atlas + (size_t)((int32_t)Quad.Source.Top + V1) * this->AtlasWidth + (int32_t)Quad.Source.Left;
+        uint8_t *DstRow = (uint8_t *)this->Target.Pixels + (size_t)Y * this->Target.Stride;
+
+        for(int32_t X = Left; X < Right; ++X)
+        {
+            float U = ((float)X + 0.5f - Quad.Bounds.Left) * InvScale - 0.5f;
+            U = U < 0.f ? 0.f : (U > MaxU ? MaxU : U);
+
+            int32_t U0 = (int32_t)U;
+            int32_t U1 = U0 + 1 <= (int32_t)MaxU ? U0 + 1 : U0;
+            float   FU = U - (float)U0;
+
+            float Upper  = Row0[U0] + (Row0[U1] - Row0[U0]) * FU;
+            float Lower  = Row1[U0] + (Row1[U1] - Row1[U0]) * FU;
+            float Sample = (Upper + (Lower - Upper) * FV) / 255.f;
+
+            float Coverage = Sample;
+            if(Quad.DistanceRange > 0.f)
+            {
+                float Distance = (0.5f - Sample) * Quad.DistanceRange * Quad.Scale;
+                Coverage = 0.5f - Distance;
+            }
+
+            uint32_t Alpha = SoftwareDiv255(SoftwareUnitToByte(Coverage) * ColorA);
+            if(Alpha == 0) continue;
+
+            uint8_t *Pixel = DstRow + (size_t)X * BytesPerPx;
+            for(uint32_t Channel = 0; Channel < BytesPerPx; ++Channel)
+            {
+                Pixel[Channel] = (uint8_t)SoftwareDiv255(Color[Channel] * Alpha + Pixel[Channel] * (255 - Alpha));
+            }
+        }
+    }
+}
+
+void software_renderer::DrawTextToScreen(void)
+{
+    for(uint32_t Idx = 0; Idx < this->QuadCount; ++Idx)
+    {
+        this->BlendQuad(this->Quads[Idx]);
+    }
+
+    this->QuadCount = 0;
+}
+
+void software_renderer::Present()
+{
+    // The framebuffer belongs to the caller, there is nothing to flip.
+}
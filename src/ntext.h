@@ -5,15 +5,18 @@
 
 #include <immintrin.h>
 #include <stdint.h>
+#include <string.h>
 
-#define NTEXT_ASSERT(Cond) do {if (!(Cond)) __debugbreak();} while (0)
 #define NTEXT_ALIGNPOW2(x,b) (((x) + (b) - 1)&(~((b) - 1)))
 
 #ifdef _WIN32
 #define NTEXT_WIN32 1
+#else
+#define NTEXT_TRUETYPE 1
 #endif
 
-#if defined(_MSV_VER)
+#if defined(_MSC_VER)
+    #include <intrin.h>
     #define NTEXT_MSVC 1
 #elif defined(__clang__)
     #define NTEXT_CLANG 1
@@ -23,6 +26,19 @@
     #error "Unknown Compiler"
 #endif
 
+// The glyph hash uses AES-NI whenever the build allows it. Define NTEXT_PORTABLE_HASH to get the
+// scalar one everywhere, e.g. to share snapshots with machines built without it.
+
+#if !defined(NTEXT_PORTABLE_HASH) && (defined(__AES__) || defined(_MSC_VER))
+    #define NTEXT_AES_HASH 1
+#endif
+
+#if NTEXT_MSVC
+    #define NTEXT_ASSERT(Cond) do {if (!(Cond)) __debugbreak();} while (0)
+#elif NTEXT_CLANG || NTEXT_GNU
+    #define NTEXT_ASSERT(Cond) do {if (!(Cond)) __builtin_trap();} while (0)
+#endif
+
 #if NTEXT_MSVC
 
 static inline unsigned FindFirstBit(uint32_t Mask)
@@ -31,6 +47,12 @@ static inline unsigned FindFirstBit(uint32_t Mask)
     return _tzcnt_u32(Mask);
 }
 
+static inline unsigned FindFirstBit64(uint64_t Mask)
+{
+    NTEXT_ASSERT(Mask != 0);
+    return static_cast<unsigned>(_tzcnt_u64(Mask));
+}
+
 
 #elif NTEXT_CLANG || NTEXT_GNU
 
@@ -41,20 +63,99 @@ static inline unsigned FindFirstBit(uint32_t Mask)
     return __builtin_ctz(Mask);
 }
 
+static inline unsigned FindFirstBit64(uint64_t Mask)
+{
+    NTEXT_ASSERT(Mask != 0);
+    return __builtin_ctzll(Mask);
+}
+
 
 #else
     #error "FindFirstBit not supported for this compiler."
 #endif
 
+// Lets a single function use wider instructions than the rest of the build. Callers have to
+// check the CPU first (see IsGlyphTableWidthSupported). MSVC accepts the intrinsics anywhere.
+
+#if NTEXT_MSVC
+    #define NTEXT_TARGET(Features)
+#elif NTEXT_CLANG || NTEXT_GNU
+    #define NTEXT_TARGET(Features) __attribute__((target(Features)))
+#endif
+
+// Just enough ordering for the shared glyph table: acquire loads, release stores, the relaxed loads
+// a seqlock reader copies with and its fences. The file already assumes x86, where these mostly stop the compiler.
+// AtomicCopyRelaxed works on 4-byte words: Source has to be 4-byte aligned and Size a multiple of 4.
+
+#if NTEXT_MSVC
+
+static inline uint32_t AtomicLoadAcquire32(volatile uint32_t *Value)
+{
+    uint32_t Result = *Value;
+    _ReadWriteBarrier();
+    return Result;
+}
+
+static inline void AtomicStoreRelease32(volatile uint32_t *Value, uint32_t New)
+{
+    _ReadWriteBarrier();
+    *Value = New;
+}
+
+static inline uint32_t AtomicLoadRelaxed32(volatile uint32_t *Value)
+{
+    return *Value;
+}
+
+static inline void AtomicFenceAcquire() { _ReadWriteBarrier(); }
+static inline void AtomicFenceRelease() { _ReadWriteBarrier(); }
+
+#elif NTEXT_CLANG || NTEXT_GNU
+
+static inline uint32_t AtomicLoadAcquire32(volatile uint32_t *Value)
+{
+    return __atomic_load_n(Value, __ATOMIC_ACQUIRE);
+}
+
+static inline void AtomicStoreRelease32(volatile uint32_t *Value, uint32_t New)
+{
+    __atomic_store_n(Value, New, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t AtomicLoadRelaxed32(volatile uint32_t *Value)
+{
+    return __atomic_load_n(Value, __ATOMIC_RELAXED);
+}
+
+static inline void AtomicFenceAcquire() { __atomic_thread_fence(__ATOMIC_ACQUIRE); }
+static inline void AtomicFenceRelease() { __atomic_thread_fence(__ATOMIC_RELEASE); }
+
+#endif
+
+static inline void AtomicCopyRelaxed(void *Dest, const void *Source, uint64_t Size)
+{
+    volatile uint32_t *From = (volatile uint32_t *)Source;
+    uint8_t           *To   = (uint8_t *)Dest;
+
+    // Dest can be of any type, the words go through memcpy so it is not read back under another one.
+    for(uint64_t Idx = 0; Idx < Size / sizeof(uint32_t); ++Idx)
+    {
+        uint32_t Word = AtomicLoadRelaxed32(From + Idx);
+        memcpy(To + Idx * sizeof(uint32_t), &Word, sizeof(Word));
+    }
+}
+
 #if NTEXT_MSVC || NTEXT_CLANG
     #define AlignOf(T) __alignof(T)
 #elif NTEXT_GNU
-#define AlignOf(T) __alignof(T)__
+#define AlignOf(T) __alignof__(T)
 #else
     #error "AlignOf not supported for this compiler"
 #endif
 
 
+#include <math.h>
+
 #if NTEXT_WIN32
 #include <windows.h>
 #include <dwrite.h>
@@ -63,6 +164,13 @@ static inline unsigned FindFirstBit(uint32_t Mask)
 #pragma comment(lib, "dwrite")
 #endif
 
+#if NTEXT_TRUETYPE
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 namespace ntext
 {
 
@@ -117,6 +225,25 @@ PushArena(memory_arena *Arena, uint64_t Size, uint64_t Alignment)
 }
 
 
+// Carves a nested arena out of another one. Whatever goes in it survives regions entered on the parent.
+
+static memory_arena *
+PushSubArena(memory_arena *Parent, uint64_t Size)
+{
+    NTEXT_ASSERT(Parent);
+
+    memory_arena *Result = static_cast<memory_arena *>(PushArena(Parent, sizeof(memory_arena) + Size, AlignOf(memory_arena)));
+    if(Result)
+    {
+        Result->Reserved     = sizeof(memory_arena) + Size;
+        Result->BasePosition = 0;
+        Result->Position     = sizeof(memory_arena);
+    }
+
+    return Result;
+}
+
+
 static void
 ClearArena(memory_arena *Arena)
 {
@@ -172,7 +299,7 @@ constexpr T* PushArrayAligned(memory_arena* Arena, uint64_t Count, uint64_t Alig
 template <typename T>
 constexpr T* PushArray(memory_arena* Arena, uint64_t Count)
 {
-    return PushArrayAligned<T>(Arena, Count, max(8, alignof(T)));
+    return PushArrayAligned<T>(Arena, Count, alignof(T) > 8 ? alignof(T) : 8);
 }
 
 template <typename T>
@@ -181,12 +308,183 @@ constexpr T* PushStruct(memory_arena* Arena)
     return PushArray<T>(Arena, 1);
 }
 
-// ==================================================================================
-// @Internal : Win32 Implementation
-// ==================================================================================
 
-#ifdef NTEXT_WIN32
+// Read-only, shared view of a whole file. Every mapping of the same file is backed by the
+// same page cache pages, so several generators can open the same font for free.
+
+struct mapped_file
+{
+    uint8_t *Data;
+    uint64_t Size;
+
+#if NTEXT_WIN32
+    HANDLE   Mapping;
+#endif
+};
+
+
+static mapped_file
+MapFileReadOnly(const char *Path)
+{
+    mapped_file Result = {};
+
+#if NTEXT_WIN32
+    HANDLE File = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if(File != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER FileSize = {};
+        if(GetFileSizeEx(File, &FileSize) && FileSize.QuadPart > 0)
+        {
+            HANDLE Mapping = CreateFileMappingA(File, 0, PAGE_READONLY, 0, 0, 0);
+            if(Mapping)
+            {
+                void *View = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+                if(View)
+                {
+                    Result.Data    = static_cast<uint8_t *>(View);
+                    Result.Size    = static_cast<uint64_t>(FileSize.QuadPart);
+                    Result.Mapping = Mapping;
+                }
+                else
+                {
+                    CloseHandle(Mapping);
+                }
+            }
+        }
+
+        // The mapping keeps its own reference on the file.
+        CloseHandle(File);
+    }
+#else
+    int File = open(Path, O_RDONLY);
+    if(File >= 0)
+    {
+        struct stat Stat = {};
+        if(fstat(File, &Stat) == 0 && Stat.st_size > 0)
+        {
+            void *View = mmap(0, static_cast<size_t>(Stat.st_size), PROT_READ, MAP_SHARED, File, 0);
+            if(View != MAP_FAILED)
+            {
+                Result.Data = static_cast<uint8_t *>(View);
+                Result.Size = static_cast<uint64_t>(Stat.st_size);
+            }
+        }
+
+        close(File);
+    }
+#endif
+
+    return Result;
+}
+
+
+// FNV-1a over the name or path a font was loaded from. Unlike the font face pointer it is
+// the same from one run to the next, which is what the glyph cache keys on.
+
+static uint64_t
+ComputeFontId(const char *Name)
+{
+    uint64_t Result = 0xCBF29CE484222325ull;
+
+    for(const char *At = Name; At && *At; ++At)
+    {
+        Result ^= static_cast<uint8_t>(*At);
+        Result *= 0x100000001B3ull;
+    }
+
+    return Result;
+}
+
+
+static void
+UnmapFile(mapped_file *File)
+{
+    NTEXT_ASSERT(File);
+
+    if(File->Data)
+    {
+#if NTEXT_WIN32
+        UnmapViewOfFile(File->Data);
+        CloseHandle(File->Mapping);
+#else
+        munmap(File->Data, static_cast<size_t>(File->Size));
+#endif
+    }
+
+    *File = {};
+}
+
+
+struct file_chunk
+{
+    const void *Data;
+    uint64_t    Size;
+};
+
+
+// Creates or truncates Path and writes the chunks back to back. False if any of it failed.
+
+static bool
+WriteFileFromChunks(const char *Path, file_chunk *Chunks, uint32_t ChunkCount)
+{
+    bool Result = false;
+
+#if NTEXT_WIN32
+    HANDLE File = CreateFileA(Path, GENERIC_WRITE, 0, 0, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0);
+    if(File != INVALID_HANDLE_VALUE)
+    {
+        Result = true;
+
+        for(uint32_t Idx = 0; Result && Idx < ChunkCount; ++Idx)
+        {
+            const uint8_t *At   = static_cast<const uint8_t *>(Chunks[Idx].Data);
+            uint64_t       Left = Chunks[Idx].Size;
+
+            while(Result && Left)
+            {
+                DWORD ToWrite = Left > 0x40000000 ? 0x40000000 : static_cast<DWORD>(Left);
+                DWORD Written = 0;
+
+                Result = WriteFile(File, At, ToWrite, &Written, 0) && Written == ToWrite;
+                At    += Written;
+                Left  -= Written;
+            }
+        }
+
+        CloseHandle(File);
+    }
+#else
+    int File = open(Path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(File >= 0)
+    {
+        Result = true;
+
+        for(uint32_t Idx = 0; Result && Idx < ChunkCount; ++Idx)
+        {
+            const uint8_t *At   = static_cast<const uint8_t *>(Chunks[Idx].Data);
+            uint64_t       Left = Chunks[Idx].Size;
+
+            while(Result && Left)
+            {
+                ssize_t Written = write(File, At, static_cast<size_t>(Left));
+
+                Result = Written > 0;
+                At    += Result ? Written : 0;
+                Left  -= Result ? static_cast<uint64_t>(Written) : 0;
+            }
+        }
+
+        Result = (close(File) == 0) && Result;
+    }
+#endif
 
+    return Result;
+}
+
+// ==================================================================================
+// @Internal : Backend Types
+// Shared by every font backend. FillAtlas only ever talks to these.
+// ==================================================================================
 
 struct os_glyph_info
 {
@@ -210,6 +508,81 @@ struct rasterized_buffer
 };
 
 
+constexpr uint32_t FontFaceBMPSize  = 0x10000;
+constexpr uint32_t FontFacePageSize = 256;
+
+
+// Everything about a font that does not depend on the codepoint. Built once by LoadSystemFont
+// so that a glyph miss only costs a table read plus the glyph's own metrics.
+// Metrics are in pixels at the font size, Descent is positive below the baseline.
+// GlyphIndexBMP is filled one 256 codepoint page at a time, the first time a page is hit.
+
+struct font_face_info
+{
+    float     Scale;
+    float     Ascent;
+    float     Descent;
+    float     LineGap;
+    uint16_t *GlyphIndexBMP;
+    uint64_t  ResolvedPages[FontFaceBMPSize / FontFacePageSize / 64];
+};
+
+
+static bool
+IsGlyphIndexPageResolved(uint32_t Page, font_face_info *Info)
+{
+    bool Result = (Info->ResolvedPages[Page / 64] >> (Page % 64)) & 1;
+    return Result;
+}
+
+
+static void
+MarkGlyphIndexPageResolved(uint32_t Page, font_face_info *Info)
+{
+    Info->ResolvedPages[Page / 64] |= (1ull << (Page % 64));
+}
+
+
+// Structure-of-arrays version of os_glyph_info, filled by FindGlyphInformationBatch.
+
+struct os_glyph_info_batch
+{
+    uint16_t *GlyphIndices;
+    float    *Advances;
+    float    *OffsetsX;
+    float    *OffsetsY;
+    float    *SizesX;
+    float    *SizesY;
+    uint32_t  Count;
+};
+
+
+static os_glyph_info_batch
+PushGlyphInfoBatch(uint32_t Count, memory_arena *Arena)
+{
+    NTEXT_ASSERT(Count);
+
+    os_glyph_info_batch Result =
+    {
+        .GlyphIndices = PushArrayAligned<uint16_t>(Arena, Count, 32),
+        .Advances     = PushArrayAligned<float>   (Arena, Count, 32),
+        .OffsetsX     = PushArrayAligned<float>   (Arena, Count, 32),
+        .OffsetsY     = PushArrayAligned<float>   (Arena, Count, 32),
+        .SizesX       = PushArrayAligned<float>   (Arena, Count, 32),
+        .SizesY       = PushArrayAligned<float>   (Arena, Count, 32),
+        .Count        = Count,
+    };
+
+    return Result;
+}
+
+// ==================================================================================
+// @Internal : Win32 Implementation
+// ==================================================================================
+
+#ifdef NTEXT_WIN32
+
+
 struct backend_context
 {
     IDWriteFactory  *DirectWrite;
@@ -219,18 +592,104 @@ struct backend_context
 struct system_font
 {
     IDWriteFontFace *FontFace;
+    font_face_info  *Info;
     float            Size;
+    uint64_t         Id;
 };
 
 
 static bool
 IsValidSystemFont(system_font *Font)
 {
-    bool Result = (Font && Font->FontFace && Font->Size);
+    bool Result = (Font && Font->FontFace && Font->Info && Font->Size);
     return Result;
 }
 
 
+static font_face_info *
+CreateFontFaceInfo(IDWriteFontFace *FontFace, float Size, memory_arena *Arena)
+{
+    font_face_info *Result = PushStruct<font_face_info>(Arena);
+    uint16_t       *Table  = PushArray<uint16_t>(Arena, FontFaceBMPSize);
+
+    if(Result && Table)
+    {
+        DWRITE_FONT_METRICS FontMetrics = {};
+        FontFace->GetMetrics(&FontMetrics);
+
+        float Scale = (FontMetrics.designUnitsPerEm > 0) ? (Size / (float)FontMetrics.designUnitsPerEm) : 1.0f;
+
+        *Result = {};
+        Result->Scale         = Scale;
+        Result->Ascent        = FontMetrics.ascent  * Scale;
+        Result->Descent       = FontMetrics.descent * Scale;
+        Result->LineGap       = FontMetrics.lineGap * Scale;
+        Result->GlyphIndexBMP = Table;
+    }
+
+    return Result;
+}
+
+
+// Fonts opened from a file go through DirectWrite's local file loader, which maps the file
+// read-only and shares the view, rather than through the system collection.
+
+static system_font
+LoadFontFromFile(const char *Path, float Size, memory_arena *Arena, backend_context Backend)
+{
+    system_font     SystemFont  = {};
+    IDWriteFactory *DirectWrite = Backend.DirectWrite;
+
+    int    Length   = MultiByteToWideChar(CP_UTF8, 0, Path, -1, 0, 0);
+    WCHAR *WidePath = PushArray<WCHAR>(Arena, Length);
+    int    Written  = MultiByteToWideChar(CP_UTF8, 0, Path, -1, WidePath, Length);
+
+    if(Written == Length)
+    {
+        IDWriteFontFile *FontFile = 0;
+        DirectWrite->CreateFontFileReference(WidePath, 0, &FontFile);
+
+        if(FontFile)
+        {
+            BOOL                  IsSupported = FALSE;
+            DWRITE_FONT_FILE_TYPE FileType    = DWRITE_FONT_FILE_TYPE_UNKNOWN;
+            DWRITE_FONT_FACE_TYPE FaceType    = DWRITE_FONT_FACE_TYPE_UNKNOWN;
+            UINT32                FaceCount   = 0;
+            FontFile->Analyze(&IsSupported, &FileType, &FaceType, &FaceCount);
+
+            if(IsSupported)
+            {
+                DirectWrite->CreateFontFace(FaceType, 1, &FontFile, 0, DWRITE_FONT_SIMULATIONS_NONE, &SystemFont.FontFace);
+                if(SystemFont.FontFace)
+                {
+                    SystemFont.Info = CreateFontFaceInfo(SystemFont.FontFace, Size, Arena);
+                    SystemFont.Size = Size;
+                    SystemFont.Id   = ComputeFontId(Path);
+                }
+            }
+
+            FontFile->Release();
+        }
+    }
+
+    return SystemFont;
+}
+
+
+// Drops the DirectWrite face. Font and every copy of it are invalid afterwards, as are runs shaped with it.
+// Arena memory and cached glyphs stay, same as on the TrueType backend.
+
+static void
+ReleaseFont(system_font *Font, backend_context Backend)
+{
+    if(Font && Font->FontFace && Backend.DirectWrite)
+    {
+        Font->FontFace->Release();
+        *Font = {};
+    }
+}
+
+
 static system_font
 LoadSystemFont(const char *Name, float Size, memory_arena *Arena, backend_context Backend)
 {
@@ -263,6 +722,12 @@ LoadSystemFont(const char *Name, float Size, memory_arena *Arena, backend_contex
                 {
                     Font->CreateFontFace(&SystemFont.FontFace);
                     SystemFont.Size = Size;
+                    SystemFont.Id   = ComputeFontId(Name);
+
+                    if(SystemFont.FontFace)
+                    {
+                        SystemFont.Info = CreateFontFaceInfo(SystemFont.FontFace, Size, Arena);
+                    }
                 }
             }
         }
@@ -291,19 +756,47 @@ InitializeBackendContext(void)
 }
 
 
-static os_glyph_info
-FindGlyphInformation(uint32_t CodePoint, system_font Font)
+static uint16_t
+FindGlyphIndex(uint32_t CodePoint, system_font Font)
 {
-    UINT16 GlyphIndex = 0;
-    Font.FontFace->GetGlyphIndices(&CodePoint, 1, &GlyphIndex);
+    UINT16 Result = 0;
+
+    if(CodePoint < FontFaceBMPSize)
+    {
+        uint32_t Page = CodePoint / FontFacePageSize;
+
+        if(!IsGlyphIndexPageResolved(Page, Font.Info))
+        {
+            UINT32 Codepoints[FontFacePageSize];
+            for(uint32_t Idx = 0; Idx < FontFacePageSize; ++Idx)
+            {
+                Codepoints[Idx] = (Page * FontFacePageSize) + Idx;
+            }
+
+            Font.FontFace->GetGlyphIndices(Codepoints, FontFacePageSize, Font.Info->GlyphIndexBMP + (Page * FontFacePageSize));
+            MarkGlyphIndexPageResolved(Page, Font.Info);
+        }
+
+        Result = Font.Info->GlyphIndexBMP[CodePoint];
+    }
+    else
+    {
+        Font.FontFace->GetGlyphIndices(&CodePoint, 1, &Result);
+    }
+
+    return Result;
+}
+
+
+static os_glyph_info
+FindGlyphInformation(uint32_t CodePoint, system_font Font)
+{
+    UINT16 GlyphIndex = FindGlyphIndex(CodePoint, Font);
 
     DWRITE_GLYPH_METRICS GlyphMetrics = {};
     Font.FontFace->GetDesignGlyphMetrics(&GlyphIndex, 1, &GlyphMetrics, FALSE);
 
-    DWRITE_FONT_METRICS FontMetrics = {};
-    Font.FontFace->GetMetrics(&FontMetrics);
-
-    float Scale = (FontMetrics.designUnitsPerEm > 0) ? (Font.Size / (float)FontMetrics.designUnitsPerEm) : 1.0f;
+    float Scale = Font.Info->Scale;
 
     int32_t  Left    = GlyphMetrics.leftSideBearing;
     uint32_t Advance = GlyphMetrics.advanceWidth;
@@ -326,8 +819,49 @@ FindGlyphInformation(uint32_t CodePoint, system_font Font)
 }
 
 
+// Resolves Count codepoints in one go. GetDesignGlyphMetrics is called on chunks of glyphs
+// rather than once per glyph, the chunk only exists so the metrics can live on the stack.
+
+static void
+FindGlyphInformationBatch(uint32_t *Codepoints, uint32_t Count, system_font Font, os_glyph_info_batch *Out)
+{
+    NTEXT_ASSERT(Out && Out->Count >= Count);
+
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        Out->GlyphIndices[Idx] = FindGlyphIndex(Codepoints[Idx], Font);
+    }
+
+    float Scale = Font.Info->Scale;
+
+    for(uint32_t Start = 0; Start < Count; Start += 64)
+    {
+        uint32_t             ChunkCount = (Count - Start) < 64 ? (Count - Start) : 64;
+        DWRITE_GLYPH_METRICS Metrics[64];
+
+        Font.FontFace->GetDesignGlyphMetrics(Out->GlyphIndices + Start, ChunkCount, Metrics, FALSE);
+
+        for(uint32_t Idx = 0; Idx < ChunkCount; ++Idx)
+        {
+            int32_t  Left    = Metrics[Idx].leftSideBearing;
+            uint32_t Advance = Metrics[Idx].advanceWidth;
+            int32_t  Right   = Metrics[Idx].rightSideBearing;
+            int32_t  Top     = Metrics[Idx].topSideBearing;
+            uint32_t AHeight = Metrics[Idx].advanceHeight;
+            int32_t  Bottom  = Metrics[Idx].bottomSideBearing;
+
+            Out->Advances[Start + Idx] = static_cast<float>(Advance * Scale);
+            Out->OffsetsX[Start + Idx] = static_cast<float>(Left    * Scale);
+            Out->OffsetsY[Start + Idx] = static_cast<float>(Top     * Scale);
+            Out->SizesX  [Start + Idx] = static_cast<float>((Left   + Advance + Right)  * Scale);
+            Out->SizesY  [Start + Idx] = static_cast<float>((Top    + AHeight + Bottom) * Scale);
+        }
+    }
+}
+
+
 static rasterized_buffer
-RasterizeGlyphToAlphaTexture(uint16_t GlyphIndex, float Advance, system_font Font, backend_context Backend, memory_arena *Arena)
+RasterizeGlyphToAlphaTexture(uint16_t GlyphIndex, float Advance, float SubpixelX, system_font Font, backend_context Backend, memory_arena *Arena)
 {
     rasterized_buffer Result = {};
 
@@ -338,7 +872,7 @@ RasterizeGlyphToAlphaTexture(uint16_t GlyphIndex, float Advance, system_font Fon
 
         UINT16              GlyphIndices[1] = {GlyphIndex};
         FLOAT               Advances[1]     = {Advance};
-        DWRITE_GLYPH_OFFSET Offsets[1]      = {{0.f, 0.f}};
+        DWRITE_GLYPH_OFFSET Offsets[1]      = {{SubpixelX, 0.f}};
     
         DWRITE_GLYPH_RUN GlyphRun =
         {
@@ -397,1146 +931,5251 @@ RasterizeGlyphToAlphaTexture(uint16_t GlyphIndex, float Advance, system_font Fon
 
 
 // ==================================================================================
-// @Internal : Rectangle Packing
+// @Internal : TrueType Implementation
+// Portable backend. Reads cmap/hmtx/loca/glyf straight out of a .ttf file and
+// rasterizes the quadratic outlines into the arena. Only needs the C runtime.
 // ==================================================================================
 
-struct point
+#if NTEXT_TRUETYPE
+
+
+struct truetype_table
 {
-    uint16_t X;
-    uint16_t Y;
+    uint32_t Offset;
+    uint32_t Length;
 };
 
 
-struct rectangle_packer
+// Data is a zero-copy view into the mapped file. Tables are only located at load time,
+// the cmap subtable is picked the first time a glyph index is looked up.
+
+struct truetype_font
 {
-    point    *Skyline;
-    uint16_t  SkylineCount;
-    uint16_t  Width;
-    uint16_t  Height;
+    mapped_file    File;
+    uint8_t       *Data;
+    uint64_t       Size;
+
+    truetype_table Cmap;
+    truetype_table Head;
+    truetype_table Hhea;
+    truetype_table Hmtx;
+    truetype_table Loca;
+    truetype_table Glyf;
+    truetype_table Maxp;
+
+    bool           IsCmapParsed;
+    uint32_t       CmapSubtable;
+    uint16_t       CmapFormat;
+    uint16_t       UnitsPerEm;
+    uint16_t       GlyphCount;
+    uint16_t       HMetricCount;
+    int16_t        IndexToLocFormat;
+    int16_t        Ascent;
+    int16_t        Descent;
+    int16_t        LineGap;
 };
 
 
-struct packed_rectangle
+struct truetype_pixel_box
 {
-    uint16_t Width;
-    uint16_t Height;
+    int32_t X0;
+    int32_t Y0;
+    int32_t X1;
+    int32_t Y1;
+};
 
-    uint16_t X;
-    uint16_t Y;
-    bool     WasPacked;
+
+// Maps font units to pixel space: x' = A*x + C*y + E, y' = B*x + D*y + F.
+// Same layout as the composite glyph matrices so they compose directly.
+
+struct truetype_transform
+{
+    float A, B, C, D;
+    float E, F;
 };
 
 
-struct rectangle
+struct truetype_edge
 {
-    float Left;
-    float Top;
-    float Right;
-    float Bottom;
+    float X0;
+    float Y0;
+    float X1;
+    float Y1;
 };
 
 
-static uint64_t
-GetRectanglePackerFootprint(uint16_t Width)
+struct truetype_edge_list
+{
+    truetype_edge *Edges;
+    uint32_t       Count;
+    uint32_t       Capacity;
+};
+
+
+struct backend_context
+{
+    bool IsInitialized;
+};
+
+
+struct system_font
 {
-    uint64_t SkylineSize = Width * sizeof(point);
-    uint64_t Result      = sizeof(rectangle_packer) + SkylineSize;
+    truetype_font  *FontFace;
+    font_face_info *Info;
+    float           Size;
+    uint64_t        Id;
+};
+
+
+constexpr uint32_t TrueTypeMaxCurveSteps     = 16;
+constexpr uint32_t TrueTypeMaxCompositeDepth = 8;
 
+
+static uint16_t
+ReadU16BE(uint8_t *At)
+{
+    uint16_t Result = static_cast<uint16_t>((At[0] << 8) | At[1]);
     return Result;
 }
 
 
-static rectangle_packer *
-PlaceRectanglePackerInMemory(uint16_t Width, uint16_t Height, void *Memory)
+static int16_t
+ReadI16BE(uint8_t *At)
 {
-    rectangle_packer *Result = 0;
+    int16_t Result = static_cast<int16_t>(ReadU16BE(At));
+    return Result;
+}
 
-    if(Memory)
+
+static uint32_t
+ReadU32BE(uint8_t *At)
+{
+    uint32_t Result = (static_cast<uint32_t>(At[0]) << 24) | (static_cast<uint32_t>(At[1]) << 16) |
+                      (static_cast<uint32_t>(At[2]) <<  8) | (static_cast<uint32_t>(At[3]) <<  0);
+    return Result;
+}
+
+
+static truetype_table
+FindTrueTypeTable(uint8_t *Data, uint64_t Size, const char *Tag)
+{
+    truetype_table Result = {};
+
+    uint16_t TableCount = ReadU16BE(Data + 4);
+    if(12 + (uint64_t)TableCount * 16 <= Size)
     {
-        point *Skyline = (point *)Memory;
+        for(uint16_t Idx = 0; Idx < TableCount; ++Idx)
+        {
+            uint8_t *Record = Data + 12 + (Idx * 16);
+            if(memcmp(Record, Tag, 4) == 0)
+            {
+                uint32_t Offset = ReadU32BE(Record + 8);
+                uint32_t Length = ReadU32BE(Record + 12);
+
+                // Tables that point outside of the file are treated as missing.
+                if((uint64_t)Offset + Length <= Size)
+                {
+                    Result.Offset = Offset;
+                    Result.Length = Length;
+                }
 
-        Result = (rectangle_packer *)(Skyline + Width);
-        Result->Width        = Width;
-        Result->Height       = Height;
-        Result->Skyline      = Skyline;
-        Result->SkylineCount = 1;
-        Result->Skyline[0].X = 0;
-        Result->Skyline[0].Y = 0;
+                break;
+            }
+        }
     }
 
     return Result;
 }
 
 
+static bool
+ParseTrueTypeFont(uint8_t *Data, uint64_t Size, truetype_font *Font)
+{
+    NTEXT_ASSERT(Font);
+
+    if(!Data || Size < 12)
+    {
+        return false;
+    }
+
+    // Only glyf based fonts are handled. 'OTTO' (CFF outlines) and collections are rejected.
+    uint32_t Version = ReadU32BE(Data);
+    if(Version != 0x00010000 && Version != 0x74727565)
+    {
+        return false;
+    }
+
+    Font->Data = Data;
+    Font->Size = Size;
+    Font->Cmap = FindTrueTypeTable(Data, Size, "cmap");
+    Font->Head = FindTrueTypeTable(Data, Size, "head");
+    Font->Hhea = FindTrueTypeTable(Data, Size, "hhea");
+    Font->Hmtx = FindTrueTypeTable(Data, Size, "hmtx");
+    Font->Loca = FindTrueTypeTable(Data, Size, "loca");
+    Font->Glyf = FindTrueTypeTable(Data, Size, "glyf");
+    Font->Maxp = FindTrueTypeTable(Data, Size, "maxp");
+
+    if(Font->Head.Length < 54 || Font->Hhea.Length < 36 ||
+       Font->Maxp.Length < 6 || !Font->Hmtx.Length || !Font->Loca.Length || !Font->Glyf.Length)
+    {
+        return false;
+    }
+
+    uint8_t *Head = Data + Font->Head.Offset;
+    uint8_t *Hhea = Data + Font->Hhea.Offset;
+    uint8_t *Maxp = Data + Font->Maxp.Offset;
+
+    Font->UnitsPerEm       = ReadU16BE(Head + 18);
+    Font->IndexToLocFormat = ReadI16BE(Head + 50);
+    Font->GlyphCount       = ReadU16BE(Maxp + 4);
+    Font->Ascent           = ReadI16BE(Hhea + 4);
+    Font->Descent          = ReadI16BE(Hhea + 6);
+    Font->LineGap          = ReadI16BE(Hhea + 8);
+    Font->HMetricCount     = ReadU16BE(Hhea + 34);
+
+    uint64_t LocaEntrySize = Font->IndexToLocFormat ? 4 : 2;
+    if(!Font->UnitsPerEm || !Font->HMetricCount || Font->HMetricCount > Font->GlyphCount ||
+       (uint64_t)Font->HMetricCount * 4 > Font->Hmtx.Length ||
+       ((uint64_t)Font->GlyphCount + 1) * LocaEntrySize > Font->Loca.Length)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+// Pick a unicode subtable. Format 12 covers the full range so it wins over format 4.
+// Fonts without a usable cmap keep CmapFormat at 0 and map everything to glyph 0.
+
 static void
-PackRectangle(packed_rectangle &Rectangle, rectangle_packer *Packer)
+ParseTrueTypeCmap(truetype_font *Font)
 {
-    NTEXT_ASSERT(Packer);
+    NTEXT_ASSERT(Font && !Font->IsCmapParsed);
 
-    uint16_t Width  = Rectangle.Width;
-    uint16_t Height = Rectangle.Height;
+    Font->IsCmapParsed = true;
 
-    if(Width == 0 || Height == 0)
+    if(Font->Cmap.Length < 4)
     {
         return;
     }
 
-    uint16_t BestIndexInclusive = UINT16_MAX;
-    uint16_t BestIndexExclusive = UINT16_MAX;
-    point    BestPoint          = {UINT16_MAX, UINT16_MAX};
-
-    NTEXT_ASSERT(Packer->SkylineCount);
+    uint8_t *Cmap          = Font->Data + Font->Cmap.Offset;
+    uint16_t SubtableCount = ReadU16BE(Cmap + 2);
+    uint32_t BestScore     = 0;
 
-    for(uint16_t Idx = 0; Idx < Packer->SkylineCount; ++Idx)
+    for(uint16_t Idx = 0; Idx < SubtableCount && 4 + (Idx + 1) * 8u <= Font->Cmap.Length; ++Idx)
     {
-        point Point = Packer->Skyline[Idx];
+        uint8_t *Record     = Cmap + 4 + (Idx * 8);
+        uint16_t PlatformId = ReadU16BE(Record + 0);
+        uint16_t EncodingId = ReadU16BE(Record + 2);
+        uint32_t Offset     = ReadU32BE(Record + 4);
 
-        // If on the current skyline we do not have horizontal space, then we can break since the array is sorted left to right.
-        if(Width > Packer->Width - Point.X)
+        bool IsUnicode = (PlatformId == 0) || (PlatformId == 3 && (EncodingId == 1 || EncodingId == 10));
+        if(!IsUnicode || (uint64_t)Offset + 8 > Font->Cmap.Length)
         {
-            break;
+            continue;
         }
 
-        // If the current skyline is taller than our BestY, then we simply continue since we are trying to place bottom->top
-        if(Point.Y >= BestPoint.Y)
+        uint8_t *Subtable = Cmap + Offset;
+        uint16_t Format   = ReadU16BE(Subtable);
+        uint32_t Score    = 0;
+        uint64_t Length   = 0;
+
+        if(Format == 4)
         {
-            continue;
+            Length = ReadU16BE(Subtable + 2);
+            Score  = (16 + (uint64_t)ReadU16BE(Subtable + 6) * 4 <= Length) ? 1 : 0;
+        } else
+        if(Format == 12)
+        {
+            Length = ReadU32BE(Subtable + 4);
+            Score  = (16 + (uint64_t)ReadU32BE(Subtable + 12) * 12 <= Length) ? 2 : 0;
+        }
+
+        if(Score > BestScore && Offset + Length <= Font->Cmap.Length)
+        {
+            BestScore          = Score;
+            Font->CmapSubtable = Font->Cmap.Offset + Offset;
+            Font->CmapFormat   = Format;
+        }
+    }
+}
+
+
+static uint16_t
+LookupTrueTypeGlyphIndex(truetype_font *Font, uint32_t Codepoint)
+{
+    if(!Font->IsCmapParsed)
+    {
+        ParseTrueTypeCmap(Font);
+    }
+
+    uint16_t Result   = 0;
+    uint8_t *Subtable = Font->Data + Font->CmapSubtable;
+
+    if(Font->CmapFormat == 4)
+    {
+        if(Codepoint > 0xFFFF)
+        {
+            return 0;
         }
 
-        uint16_t XMax           = Point.X + Width;
-        uint16_t IndexExclusive = 0;
-        for(IndexExclusive = Idx + 1; IndexExclusive < Packer->SkylineCount; ++IndexExclusive)
+        uint16_t SegmentCount = ReadU16BE(Subtable + 6) / 2;
+        uint8_t *EndCodes     = Subtable + 14;
+        uint8_t *StartCodes   = EndCodes   + (SegmentCount * 2) + 2;
+        uint8_t *Deltas       = StartCodes + (SegmentCount * 2);
+        uint8_t *RangeOffsets = Deltas     + (SegmentCount * 2);
+        uint8_t *SubtableEnd  = Subtable   + ReadU16BE(Subtable + 2);
+
+        // Smallest segment whose end code is >= Codepoint.
+
+        uint32_t Low  = 0;
+        uint32_t High = SegmentCount;
+        while(Low < High)
         {
-            // XMax is the right edge of the current rectangle. If it is smaller or equal then we know that
-            // there is no way to intersect on the X axis anymore, because the skylines are sorted from left to right.
-            if(XMax <= Packer->Skyline[IndexExclusive].X)
+            uint32_t Mid = (Low + High) / 2;
+            if(ReadU16BE(EndCodes + (Mid * 2)) < Codepoint)
             {
-                break;
+                Low = Mid + 1;
             }
-
-            // At this point, we know we are intersecting on the X axis, thus we need to raise the skyline,
-            // which is what creates dead space. As long as we intersect on the X axis, we have to continue raising the
-            // point.
-            if(Point.Y < Packer->Skyline[IndexExclusive].Y)
+            else
             {
-                Point.Y = Packer->Skyline[IndexExclusive].Y;
+                High = Mid;
             }
         }
 
-        // Then it's a worse point than our current best.
-        if(Point.Y >= BestPoint.Y)
+        if(Low < SegmentCount)
         {
-            continue;
+            uint16_t Start       = ReadU16BE(StartCodes   + (Low * 2));
+            uint16_t Delta       = ReadU16BE(Deltas       + (Low * 2));
+            uint16_t RangeOffset = ReadU16BE(RangeOffsets + (Low * 2));
+
+            if(Start <= Codepoint)
+            {
+                if(RangeOffset == 0)
+                {
+                    Result = static_cast<uint16_t>(Codepoint + Delta);
+                }
+                else
+                {
+                    uint8_t *At = RangeOffsets + (Low * 2) + RangeOffset + ((Codepoint - Start) * 2);
+                    if(At + 2 <= SubtableEnd)
+                    {
+                        uint16_t Glyph = ReadU16BE(At);
+                        Result = Glyph ? static_cast<uint16_t>(Glyph + Delta) : 0;
+                    }
+                }
+            }
         }
+    } else
+    if(Font->CmapFormat == 12)
+    {
+        uint32_t GroupCount = ReadU32BE(Subtable + 12);
+        uint8_t *Groups     = Subtable + 16;
 
-        // Not enough vertical space to store this rectangle.
-        if(Height > Packer->Height - Point.Y)
+        uint32_t Low  = 0;
+        uint32_t High = GroupCount;
+        while(Low < High)
         {
-            continue;
+            uint32_t Mid   = (Low + High) / 2;
+            uint8_t *Group = Groups + (Mid * 12);
+
+            if(ReadU32BE(Group + 4) < Codepoint)
+            {
+                Low = Mid + 1;
+            }
+            else
+            {
+                High = Mid;
+            }
         }
 
-        BestIndexInclusive = Idx;
-        BestIndexExclusive = IndexExclusive;
-        BestPoint          = Point;
+        if(Low < GroupCount)
+        {
+            uint8_t *Group = Groups + (Low * 12);
+            uint32_t Start = ReadU32BE(Group + 0);
+
+            if(Start <= Codepoint)
+            {
+                Result = static_cast<uint16_t>(ReadU32BE(Group + 8) + (Codepoint - Start));
+            }
+        }
     }
 
-    // Could not pack the rectangle.
-    if(BestIndexInclusive == UINT16_MAX)
+    if(Result >= Font->GlyphCount)
     {
-        return;
+        Result = 0;
     }
 
-    NTEXT_ASSERT(BestIndexInclusive < BestIndexExclusive);
-    NTEXT_ASSERT(BestIndexExclusive > 0);
-
-    uint16_t RemovedCount = BestIndexExclusive - BestIndexInclusive;
-    NTEXT_ASSERT(RemovedCount > 0);
+    return Result;
+}
 
-    // To create the top left point, we use the best point we found and raise it by the height of the rectangle.
-    // To create the bot right point, we use the right edge of the triangle we are placing and the last overlapping skyline y
-    // coordinate. This ensures that the skyline goes from left to right.
 
-    point NewTopLeft  = {BestPoint.X                               , static_cast<uint16_t>(BestPoint.Y + Height)};
-    point NewBotRight = {static_cast<uint16_t>(BestPoint.X + Width), Packer->Skyline[BestIndexExclusive - 1].Y};
+static void
+GetTrueTypeHorizontalMetrics(truetype_font *Font, uint16_t GlyphIndex, uint16_t *Advance, int16_t *LeftBearing)
+{
+    uint8_t *Hmtx = Font->Data + Font->Hmtx.Offset;
 
-    // To know if we are creating a new skyline from the bottom right point, we need to check multiple cases.
-    // If the first exclusive point is a valid index, then we simply check: if (smaller) new point else no.
-    // If the first exclusive point is not a valid index, then we simply check: if(not_on_boundary) new point
+    if(GlyphIndex < Font->HMetricCount)
+    {
+        *Advance     = ReadU16BE(Hmtx + (GlyphIndex * 4) + 0);
+        *LeftBearing = ReadI16BE(Hmtx + (GlyphIndex * 4) + 2);
+    }
+    else
+    {
+        // Monospaced tail: the advance repeats and only the bearings are stored.
 
-    bool HasBottomRightPoint = BestIndexExclusive < Packer->SkylineCount ?
-        NewBotRight.X < Packer->Skyline[BestIndexExclusive].X :
-        NewBotRight.X < Packer->Width;
+        uint64_t BearingAt = (Font->HMetricCount * 4) + ((GlyphIndex - Font->HMetricCount) * 2);
 
-    uint16_t InsertedCount = 1 + HasBottomRightPoint;
-    NTEXT_ASSERT(Packer->SkylineCount + InsertedCount - RemovedCount <= Packer->Width);
+        *Advance     = ReadU16BE(Hmtx + ((Font->HMetricCount - 1) * 4));
+        *LeftBearing = (BearingAt + 2 <= Font->Hmtx.Length) ? ReadI16BE(Hmtx + BearingAt) : 0;
+    }
+}
 
-    if(InsertedCount > RemovedCount)
-    {
-        // Copy from the last element to the exclusive index.
-        // Make space for the new elements by shifting end by (InsertedCount - RemovedCount)
-        // This grows the array.
 
-        uint16_t Start = Packer->SkylineCount - 1;
-        uint16_t End   = Start + (InsertedCount - RemovedCount);
+// Returns the glyph data and its length. Empty glyphs (spaces) return a length of 0.
 
-        for(; Start >= BestIndexExclusive; --Start, --End)
-        {
-            Packer->Skyline[End] = Packer->Skyline[Start];
-        }
+static uint8_t *
+GetTrueTypeGlyphData(truetype_font *Font, uint16_t GlyphIndex, uint32_t *Length)
+{
+    uint8_t *Result = 0;
+    *Length = 0;
 
-        Packer->SkylineCount += (InsertedCount - RemovedCount);
-    } else
-    if(InsertedCount < RemovedCount)
+    if(GlyphIndex < Font->GlyphCount)
     {
-        // Copy from the first exclusive element to (Start - ElementsToRemoveCount)
-        // We basically start copying behind us and iterate until the end of the array.
+        uint8_t *Loca  = Font->Data + Font->Loca.Offset;
+        uint32_t Start = 0;
+        uint32_t End   = 0;
 
-        uint16_t Start = BestIndexExclusive;
-        uint16_t End   = Start - (RemovedCount - InsertedCount);
-
-        for(; Start < Packer->SkylineCount; ++Start, ++End)
+        if(Font->IndexToLocFormat == 0)
         {
-            Packer->Skyline[End] = Packer->Skyline[Start];
+            Start = ReadU16BE(Loca + (GlyphIndex * 2) + 0) * 2;
+            End   = ReadU16BE(Loca + (GlyphIndex * 2) + 2) * 2;
+        }
+        else
+        {
+            Start = ReadU32BE(Loca + (GlyphIndex * 4) + 0);
+            End   = ReadU32BE(Loca + (GlyphIndex * 4) + 4);
         }
 
-        Packer->SkylineCount += (RemovedCount - InsertedCount);
-    }
-
-    Packer->Skyline[BestIndexInclusive] = NewTopLeft;
-    if(HasBottomRightPoint)
-    {
-        Packer->Skyline[BestIndexInclusive + 1] = NewBotRight;
+        if(Start < End && End <= Font->Glyf.Length && End - Start >= 10)
+        {
+            Result  = Font->Data + Font->Glyf.Offset + Start;
+            *Length = End - Start;
+        }
     }
 
-    // This is kind of a hack. Unsure why this work since I do not fully remember how this algorithm works.
-    // The caller assumes that we return the bottom left and this looks like it does the trick?
-    // No it doesn't. Wait I am confused.
-
-    Rectangle.WasPacked = 1;
-    Rectangle.X         = NewTopLeft.X;
-    Rectangle.Y         = NewBotRight.Y;
+    return Result;
 }
 
 
-// ==================================================================================
-// @Public : NText Glyph Table Implementation
-// Placeholder: glyph table types and hash utilities
-// ==================================================================================
+// Bitmap bounds of the glyph at the given scale, in pixels. Y grows downward and the
+// origin is the pen position on the baseline. Both the metrics and the rasterizer go
+// through this so the packed rectangle and the rasterized buffer always agree.
 
-enum class GlyphTableWidth : uint64_t
+static truetype_pixel_box
+GetTrueTypeGlyphPixelBox(truetype_font *Font, uint16_t GlyphIndex, float Scale, float ShiftX)
 {
-    None     = 0,
-    _128Bits = 16,
-};
+    truetype_pixel_box Result = {};
 
+    uint32_t Length = 0;
+    uint8_t *Glyph  = GetTrueTypeGlyphData(Font, GlyphIndex, &Length);
 
-struct glyph_table_params
-{
-    GlyphTableWidth GroupWidth;
-    uint64_t        GroupCount;
-};
+    if(Glyph)
+    {
+        float XMin = ReadI16BE(Glyph + 2);
+        float YMin = ReadI16BE(Glyph + 4);
+        float XMax = ReadI16BE(Glyph + 6);
+        float YMax = ReadI16BE(Glyph + 8);
 
+        Result.X0 = static_cast<int32_t>(floorf( XMin * Scale));
+        Result.Y0 = static_cast<int32_t>(floorf(-YMax * Scale));
+        Result.X1 = static_cast<int32_t>(ceilf ( XMax * Scale + ShiftX));
+        Result.Y1 = static_cast<int32_t>(ceilf (-YMin * Scale));
 
-struct glyph_hash
-{
-    alignas(16)__m128i Value;
-};
+        if(Result.X1 <= Result.X0 || Result.Y1 <= Result.Y0)
+        {
+            Result = {};
+        }
+    }
+
+    return Result;
+}
 
 
-struct glyph_tag
+static uint32_t
+CountTrueTypeGlyphPoints(truetype_font *Font, uint16_t GlyphIndex, uint32_t Depth)
 {
-    uint8_t Value;
-};
+    uint32_t Result = 0;
+    uint32_t Length = 0;
+    uint8_t *Glyph  = GetTrueTypeGlyphData(Font, GlyphIndex, &Length);
 
+    if(!Glyph || Depth > TrueTypeMaxCompositeDepth)
+    {
+        return 0;
+    }
 
-struct glyph_layout_info
-{
-    float Advance;
-    float OffsetX;
-    float OffsetY;
-};
-
-
-struct glyph_entry
-{
-    glyph_hash        Hash;
-
-    uint32_t          PrevLRU;
-    uint32_t          NextLRU;
-
-    uint16_t          GlyphIndex;
-    rectangle         Source;
-    glyph_layout_info Layout;
-    bool              IsRasterized;
-};
-
-
-struct glyph_table
-{
-    uint8_t     *Metadata;
-    glyph_entry *Buckets;
-
-    uint64_t     GroupWidth;
-    uint64_t     GroupCount;
-    uint64_t     HashMask;
-
-    uint32_t     SentinelIndex;
-};
+    int16_t  ContourCount = ReadI16BE(Glyph);
+    uint8_t *End          = Glyph + Length;
 
+    if(ContourCount > 0)
+    {
+        uint8_t *LastEndPoint = Glyph + 10 + ((ContourCount - 1) * 2);
+        if(LastEndPoint + 2 <= End)
+        {
+            Result = ReadU16BE(LastEndPoint) + 1;
+        }
+    } else
+    if(ContourCount < 0)
+    {
+        uint8_t *At    = Glyph + 10;
+        uint16_t Flags = 0;
 
-struct glyph_state
-{
-    uint32_t          Id;
-    uint16_t          GlyphIndex;
-    glyph_layout_info Layout;
-    rectangle         Source;
-    bool              IsRasterized;
-};
+        do
+        {
+            if(At + 4 > End)
+            {
+                break;
+            }
 
+            Flags = ReadU16BE(At + 0);
+            uint16_t Component = ReadU16BE(At + 2);
+            At += 4;
 
-constexpr uint32_t GlyphTableInvalidEntry = 0xFFFFFFFFu;
-constexpr uint8_t  GlyphTableEmptyMask    = 1 << 6; 
-constexpr uint8_t  GlyphTableDeadMask     = 1 << 7;
-constexpr uint8_t  GlyphTableTagMask      = 0xFF & ~0x03;
+            At += (Flags & 0x0001) ? 4 : 2;
+            At += (Flags & 0x0008) ? 2 : (Flags & 0x0040) ? 4 : (Flags & 0x0080) ? 8 : 0;
 
+            Result += CountTrueTypeGlyphPoints(Font, Component, Depth + 1);
+        } while(Flags & 0x0020);
+    }
 
-static bool
-IsValidGlyphTable(glyph_table *Table)
-{
-    bool Result = Table && Table->Metadata && Table->Buckets;
     return Result;
 }
 
 
-static glyph_entry *
-GetGlyphEntry(uint64_t Index, glyph_table *Table)
-{
-    NTEXT_ASSERT(Table);
-    NTEXT_ASSERT(Index <= (Table->GroupCount * Table->GroupWidth)); // Could be sentinel.
-
-    glyph_entry *Result = Table->Buckets + Index;
-    return Result;
-}
-
-static glyph_entry *
-GetGlyphTableSentinel(glyph_table *Table)
+static truetype_transform
+ComposeTrueTypeTransform(truetype_transform Parent, truetype_transform Child)
 {
-    NTEXT_ASSERT(Table->SentinelIndex == Table->GroupCount * Table->GroupWidth);
+    truetype_transform Result =
+    {
+        .A = Parent.A * Child.A + Parent.C * Child.B,
+        .B = Parent.B * Child.A + Parent.D * Child.B,
+        .C = Parent.A * Child.C + Parent.C * Child.D,
+        .D = Parent.B * Child.C + Parent.D * Child.D,
+        .E = Parent.A * Child.E + Parent.C * Child.F + Parent.E,
+        .F = Parent.B * Child.E + Parent.D * Child.F + Parent.F,
+    };
 
-    glyph_entry *Result = Table->Buckets + Table->SentinelIndex;
     return Result;
 }
 
 
-static uint32_t
-GetGlyphGroupIndexFromHash(glyph_hash Hash, glyph_table *Table)
+static void
+PushTrueTypeLine(float X0, float Y0, float X1, float Y1, truetype_edge_list *List)
 {
-    uint64_t Low64  = _mm_cvtsi128_si64(Hash.Value);
-    uint32_t Result = (uint32_t)(Low64 & Table->HashMask);
+    // Horizontal edges never cross a sample row, so they are simply dropped.
+    if(Y0 == Y1)
+    {
+        return;
+    }
 
-    return Result;
+    if(List->Count < List->Capacity)
+    {
+        List->Edges[List->Count++] = {X0, Y0, X1, Y1};
+    }
 }
 
 
-static char unsigned OverhangMask[32] =
-{
-    255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
-    0, 0, 0, 0,  0, 0, 0, 0,  0, 0, 0, 0,  0, 0, 0, 0
-};
-
-
-static char unsigned DefaultSeed[16] =
-{
-    178, 201, 95, 240, 40, 41, 143, 216,
-    2, 209, 178, 114, 232, 4, 176, 188
-};
-
-
-// No clue how good (bad) this is bad. Trying something.
-
-static glyph_hash
-ComputeGlyphHash(size_t Count, uint32_t *Codepoints, void *Owner, char unsigned *Seedx16)
+static void
+PushTrueTypeCurve(float X0, float Y0, float CX, float CY, float X1, float Y1, truetype_edge_list *List)
 {
-    NTEXT_ASSERT(Count);
-    NTEXT_ASSERT(Codepoints);
-    NTEXT_ASSERT(Seedx16);
-
-    glyph_hash Result = {0};
+    // The step count is driven by how far the control point pulls the curve, in pixels.
 
-    __m128i HashValue = _mm_set_epi64x(reinterpret_cast<uint64_t>(Owner), static_cast<uint64_t>(Count));
-    HashValue = _mm_xor_si128(HashValue, _mm_loadu_si128((__m128i *)Seedx16));
+    float DX    = X0 - 2.f * CX + X1;
+    float DY    = Y0 - 2.f * CY + Y1;
+    float Bend  = sqrtf(DX * DX + DY * DY);
+    uint32_t Steps = 1 + static_cast<uint32_t>(sqrtf(Bend * 4.f));
 
-    size_t ChunkCount = Count / 4;
-    while(ChunkCount--)
+    if(Steps > TrueTypeMaxCurveSteps)
     {
-        __m128i In = _mm_loadu_si128((__m128i *)Codepoints);
-        Codepoints += 4;
-
-        HashValue = _mm_xor_si128(HashValue, In);
-        HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
-        HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
-        HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
-        HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+        Steps = TrueTypeMaxCurveSteps;
     }
 
-    size_t Overhang = Count % 16;
-
-    // Think there is a fix for that on the refterm issues tab.
-
-#if 0
-    __m128i In = _mm_loadu_si128((__m128i *)At);
-#else
-    char Temp[16];
-    __movsb((unsigned char *)Temp, reinterpret_cast<BYTE *>(Codepoints), Overhang);
-    __m128i In = _mm_loadu_si128((__m128i *)Temp);
-#endif
-    In = _mm_and_si128(In, _mm_loadu_si128((__m128i *)(OverhangMask + 16 - Overhang)));
-
-    HashValue = _mm_xor_si128(HashValue, In);
-    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
-    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
-    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
-    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
-
-    Result.Value = HashValue;
-
-    return Result;
-}
-
+    float PrevX = X0;
+    float PrevY = Y0;
+    for(uint32_t Step = 1; Step <= Steps; ++Step)
+    {
+        float T  = static_cast<float>(Step) / static_cast<float>(Steps);
+        float U  = 1.f - T;
+        float PX = (U * U * X0) + (2.f * U * T * CX) + (T * T * X1);
+        float PY = (U * U * Y0) + (2.f * U * T * CY) + (T * T * Y1);
 
-static glyph_tag
-GetGlyphTagFromHash(glyph_hash Hash)
-{
-    uint64_t  Low64  = _mm_cvtsi128_si64(Hash.Value);
-    glyph_tag Result = {.Value = (uint8_t)(Low64 & 0x3F)};
+        PushTrueTypeLine(PrevX, PrevY, PX, PY, List);
 
-    return Result;
+        PrevX = PX;
+        PrevY = PY;
+    }
 }
 
 
 static bool
-GlyphHashesAreEqual(glyph_hash A, glyph_hash B)
-{
-    __m128i Compare = _mm_cmpeq_epi8(A.Value, B.Value);
-    int     Mask    = _mm_movemask_epi8(Compare);
-
-    return (Mask == 0xFFFF);
-}
-
-// I need to understand alignment. 
-// It's simple, but I make the same mistake everywhere in the code 
-// which might cause a bunch of other issues. Need to focus on that.
-// Why is it that the refterm code does not handle that? Or does it when allocating?
-
-
-static uint64_t
-GetGlyphTableFootprint(glyph_table_params Params)
+DecodeTrueTypeGlyph(truetype_font *Font, uint16_t GlyphIndex, truetype_transform Transform, uint32_t Depth,
+                    truetype_edge_list *List, memory_arena *Arena)
 {
-    uint64_t SlotCount = Params.GroupCount * static_cast<uint32_t>(Params.GroupWidth);
-    uint64_t MetadataSize = SlotCount * sizeof(uint8_t);
-    uint64_t BucketsSize = (SlotCount + 1) * sizeof(glyph_entry); // Accounts for sentinel.
-    uint64_t TableSize = sizeof(glyph_table);
+    uint32_t Length = 0;
+    uint8_t *Glyph  = GetTrueTypeGlyphData(Font, GlyphIndex, &Length);
 
-    // Account for alignment padding (16 bytes per section)
-    uint64_t Result = MetadataSize + 15  // Metadata
-        + BucketsSize + 15   // Buckets
-        + TableSize + 15;    // Table
-    return Result;
-}
+    if(!Glyph)
+    {
+        return true;
+    }
 
-static glyph_table *
-PlaceGlyphTableInMemory(glyph_table_params Params, void *Memory)
-{
-    glyph_table *Result = 0;
-    if (Memory)
+    if(Depth > TrueTypeMaxCompositeDepth)
     {
-        uint64_t SlotCount = Params.GroupCount * static_cast<uint32_t>(Params.GroupWidth);
+        return false;
+    }
 
-        uintptr_t MetadataAddr = reinterpret_cast<uintptr_t>(Memory);
-        MetadataAddr = (MetadataAddr + 15) & ~15ULL;
-        uint8_t *Metadata = reinterpret_cast<uint8_t *>(MetadataAddr);
+    int16_t  ContourCount = ReadI16BE(Glyph);
+    uint8_t *End          = Glyph + Length;
 
-        uintptr_t BucketsAddr = MetadataAddr + (SlotCount * sizeof(uint8_t));
-        BucketsAddr = (BucketsAddr + 15) & ~15ULL;
-        glyph_entry *Buckets = reinterpret_cast<glyph_entry *>(BucketsAddr);
+    if(ContourCount > 0)
+    {
+        uint8_t *EndPoints = Glyph + 10;
+        if(EndPoints + (ContourCount * 2) + 2 > End)
+        {
+            return false;
+        }
 
-        uintptr_t ResultAddr = BucketsAddr + ((SlotCount + 1) * sizeof(glyph_entry));
-        ResultAddr = (ResultAddr + 15) & ~15ULL;
-        Result = reinterpret_cast<glyph_table *>(ResultAddr);
+        uint32_t PointCount        = ReadU16BE(EndPoints + ((ContourCount - 1) * 2)) + 1;
+        uint16_t InstructionLength = ReadU16BE(EndPoints + (ContourCount * 2));
+        uint8_t *At                = EndPoints + (ContourCount * 2) + 2 + InstructionLength;
 
-        Result->Metadata = Metadata;
-        Result->Buckets = Buckets;
-        Result->GroupWidth = static_cast<uint64_t>(Params.GroupWidth);
-        Result->GroupCount = Params.GroupCount;
-        Result->HashMask = Params.GroupCount - 1;
-        Result->SentinelIndex = SlotCount;
+        uint8_t *Flags  = PushArray<uint8_t>(Arena, PointCount);
+        float   *PointX = PushArray<float>(Arena, PointCount);
+        float   *PointY = PushArray<float>(Arena, PointCount);
 
-        for (uint32_t Idx = 0; Idx < SlotCount; ++Idx)
+        if(!Flags || !PointX || !PointY)
         {
-            glyph_entry *Entry = GetGlyphEntry(Idx, Result);
-            Entry->GlyphIndex = 0;
-            Entry->Source = {};
-            Entry->Layout = {};
-            Entry->IsRasterized = false;
+            return false;
         }
 
-        for (uint32_t Idx = 0; Idx < SlotCount; ++Idx)
+        for(uint32_t Idx = 0; Idx < PointCount;)
         {
-            Result->Metadata[Idx] = GlyphTableEmptyMask;
-        }
-
-        glyph_entry *Sentinel = GetGlyphTableSentinel(Result);
-        NTEXT_ASSERT(Sentinel);
-        Sentinel->PrevLRU = Result->SentinelIndex;
-        Sentinel->NextLRU = Result->SentinelIndex;
-    }
-    return Result;
-}
-
-
-// This will never trigger the LRU. Do we do some integer counting to figure out when it is full?
-// Simply recycle when we reach the maximum capacity? Sounds simple.
-
-static glyph_state
-FindGlyphEntryByHash(glyph_hash Hash, glyph_table *Table)
-{
-    NTEXT_ASSERT(Table);
-
-    glyph_entry *Result     = 0;
-    uint32_t     EntryIndex = GlyphTableInvalidEntry;
+            if(At >= End)
+            {
+                return false;
+            }
 
-    uint32_t ProbeCount = 0;
-    uint32_t GroupIndex = GetGlyphGroupIndexFromHash(Hash, Table);
+            uint8_t  Flag   = *At++;
+            uint32_t Repeat = 1;
 
-    NTEXT_ASSERT(GroupIndex < Table->GroupCount);
+            if(Flag & 0x08)
+            {
+                if(At >= End)
+                {
+                    return false;
+                }
 
-    while(!Result)
-    {
-        uint8_t  *Meta = Table->Metadata + (GroupIndex * Table->GroupWidth);
-        glyph_tag Tag  = GetGlyphTagFromHash(Hash);
+                Repeat += *At++;
+            }
 
-        __m128i MetaVector = _mm_loadu_si128((__m128i *)Meta);
-        __m128i TagVector  = _mm_set1_epi8(Tag.Value);
+            while(Repeat-- && Idx < PointCount)
+            {
+                Flags[Idx++] = Flag;
+            }
+        }
 
-        // Uses a 6 bit tags to search a matching tag through the meta-data vector.
-        // If found compare hashes and return if they match.
+        // X and Y are stored as separate delta streams. Decode them in font units first.
 
-        int TagMask = _mm_movemask_epi8(_mm_cmpeq_epi8(MetaVector, TagVector));
-        while(TagMask)
+        int32_t Value = 0;
+        for(uint32_t Idx = 0; Idx < PointCount; ++Idx)
         {
-            EntryIndex = FindFirstBit(TagMask) + (GroupIndex * Table->GroupWidth);
+            uint8_t Flag = Flags[Idx];
 
-            glyph_entry *Entry = GetGlyphEntry(EntryIndex, Table);
-            if(GlyphHashesAreEqual(Hash, Entry->Hash))
+            if(Flag & 0x02)
             {
-                Result = Entry;
-                break;
+                if(At + 1 > End) return false;
+                Value += (Flag & 0x10) ? At[0] : -At[0];
+                At    += 1;
+            } else
+            if(!(Flag & 0x10))
+            {
+                if(At + 2 > End) return false;
+                Value += ReadI16BE(At);
+                At    += 2;
             }
 
-            TagMask &= TagMask - 1;
+            PointX[Idx] = static_cast<float>(Value);
         }
 
-        if(!Result)
+        Value = 0;
+        for(uint32_t Idx = 0; Idx < PointCount; ++Idx)
         {
-            __m128i EmptyVector = _mm_set1_epi8(GlyphTableEmptyMask);
-            int     EmptyMask   = _mm_movemask_epi8(_mm_cmpeq_epi8(MetaVector, EmptyVector));
+            uint8_t Flag = Flags[Idx];
 
-            if(!EmptyMask)
+            if(Flag & 0x04)
             {
-                ProbeCount++;
-                GroupIndex = (GroupIndex + (ProbeCount * ProbeCount)) & Table->HashMask ;
-            }
-            else
+                if(At + 1 > End) return false;
+                Value += (Flag & 0x20) ? At[0] : -At[0];
+                At    += 1;
+            } else
+            if(!(Flag & 0x20))
             {
-                EntryIndex = FindFirstBit(EmptyMask) + (GroupIndex * Table->GroupWidth);
-                break;
+                if(At + 2 > End) return false;
+                Value += ReadI16BE(At);
+                At    += 2;
             }
+
+            PointY[Idx] = static_cast<float>(Value);
         }
-    }
 
-    if(Result)
-    {
-        // An existing entry was found, we simply pop it from the chain.
+        for(uint32_t Idx = 0; Idx < PointCount; ++Idx)
+        {
+            float X = PointX[Idx];
+            float Y = PointY[Idx];
 
-        glyph_entry *Prev = GetGlyphEntry(Result->PrevLRU, Table);
-        glyph_entry *Next = GetGlyphEntry(Result->NextLRU, Table);
+            PointX[Idx] = Transform.A * X + Transform.C * Y + Transform.E;
+            PointY[Idx] = Transform.B * X + Transform.D * Y + Transform.F;
+        }
 
-        NTEXT_ASSERT(Prev);
-        NTEXT_ASSERT(Next);
+        // Walk every contour. Two consecutive off-curve points imply an on-curve point halfway between them.
 
-        Prev->NextLRU = Result->NextLRU;
-        Next->PrevLRU = Result->PrevLRU;
-    }
-    else
-    {
-        // No existing entry was found, we simply allocate a new one by updating the metadata array.
+        uint32_t ContourStart = 0;
+        for(int16_t Contour = 0; Contour < ContourCount; ++Contour)
+        {
+            uint32_t ContourEnd = ReadU16BE(EndPoints + (Contour * 2));
+            if(ContourEnd < ContourStart || ContourEnd >= PointCount)
+            {
+                return false;
+            }
 
-        NTEXT_ASSERT(EntryIndex != GlyphTableInvalidEntry);
+            uint32_t First = ContourStart;
+            uint32_t Last  = ContourEnd;
+            float    StartX, StartY;
 
-        // Since the tag is 00XX XXXX, we clear the state bits.
-        Table->Metadata[EntryIndex] = GetGlyphTagFromHash(Hash).Value;
+            if(Flags[First] & 0x01)
+            {
+                StartX = PointX[First];
+                StartY = PointY[First];
+                First += 1;
+            } else
+            if(Flags[Last] & 0x01)
+            {
+                StartX = PointX[Last];
+                StartY = PointY[Last];
+                Last  -= 1;
+            }
+            else
+            {
+                StartX = 0.5f * (PointX[First] + PointX[Last]);
+                StartY = 0.5f * (PointY[First] + PointY[Last]);
+            }
 
+            float PenX       = StartX;
+            float PenY       = StartY;
+            float ControlX   = 0.f;
+            float ControlY   = 0.f;
+            bool  HasControl = false;
 
-        Result = GetGlyphEntry(EntryIndex, Table);
-        if (Result)
-        {
-            Result->Hash = Hash;
-        }
-    }
-
-    glyph_entry *Sentinel = GetGlyphTableSentinel(Table);
-    NTEXT_ASSERT(Sentinel && Result != Sentinel);
-
-    Result->NextLRU = Sentinel->NextLRU;
-    Result->PrevLRU = Table->SentinelIndex;
+            for(uint32_t Idx = First; Idx <= Last && Idx <= ContourEnd; ++Idx)
+            {
+                float X = PointX[Idx];
+                float Y = PointY[Idx];
 
-    glyph_entry *Head = GetGlyphEntry(Sentinel->NextLRU, Table);
-    Head->PrevLRU     = EntryIndex;
-    Sentinel->NextLRU = EntryIndex;
+                if(Flags[Idx] & 0x01)
+                {
+                    if(HasControl)
+                    {
+                        PushTrueTypeCurve(PenX, PenY, ControlX, ControlY, X, Y, List);
+                    }
+                    else
+                    {
+                        PushTrueTypeLine(PenX, PenY, X, Y, List);
+                    }
 
-    glyph_state State =
-    {
-        .Id           = EntryIndex,
-        .GlyphIndex   = Result->GlyphIndex,
-        .Layout       = Result->Layout,
-        .Source       = Result->Source,
-        .IsRasterized = Result->IsRasterized,
-    };
+                    PenX       = X;
+                    PenY       = Y;
+                    HasControl = false;
+                }
+                else
+                {
+                    if(HasControl)
+                    {
+                        float MidX = 0.5f * (ControlX + X);
+                        float MidY = 0.5f * (ControlY + Y);
 
-    return State;
-}
+                        PushTrueTypeCurve(PenX, PenY, ControlX, ControlY, MidX, MidY, List);
 
+                        PenX = MidX;
+                        PenY = MidY;
+                    }
 
-static glyph_state
-UpdateGlyphTableEntry(uint32_t Id, bool IsRasterized, uint16_t GlyphIndex, glyph_layout_info LayoutInfo, rectangle Source, glyph_table *Table)
-{
-    glyph_entry *Entry = GetGlyphEntry(Id, Table);
-    NTEXT_ASSERT(Entry);
+                    ControlX   = X;
+                    ControlY   = Y;
+                    HasControl = true;
+                }
+            }
 
-    Entry->IsRasterized = IsRasterized;
-    Entry->GlyphIndex   = GlyphIndex;
-    Entry->Layout       = LayoutInfo;
-    Entry->Source       = Source;
+            if(HasControl)
+            {
+                PushTrueTypeCurve(PenX, PenY, ControlX, ControlY, StartX, StartY, List);
+            }
+            else
+            {
+                PushTrueTypeLine(PenX, PenY, StartX, StartY, List);
+            }
 
-    glyph_state State =
+            ContourStart = ContourEnd + 1;
+        }
+    } else
+    if(ContourCount < 0)
     {
-        .Id           = Id,
-        .GlyphIndex   = GlyphIndex,
-        .Layout       = LayoutInfo,
-        .Source       = Source,
-        .IsRasterized = IsRasterized,
-    };
-    
-    return State;
-}
+        uint8_t *At    = Glyph + 10;
+        uint16_t Flags = 0;
 
+        do
+        {
+            if(At + 4 > End)
+            {
+                return false;
+            }
 
-// ==================================================================================
-// @Public : NText Context
-// Placeholder: generator and context management
-// ==================================================================================
+            Flags = ReadU16BE(At + 0);
+            uint16_t Component = ReadU16BE(At + 2);
+            At += 4;
 
-enum class TextStorage
-{
-    None      = 0,
-    LazyAtlas = 1,
-};
+            truetype_transform Local = {1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
 
+            // Point matching (ARGS_ARE_XY_VALUES cleared) is not supported and falls back to no offset.
 
-struct glyph_generator_params
-{
-    TextStorage TextStorage;
-    uint64_t    FrameMemoryBudget;
-    void       *FrameMemory;
-    uint16_t    CacheSizeX;
-    uint16_t    CacheSizeY;
-};
+            if(Flags & 0x0001)
+            {
+                if(At + 4 > End) return false;
+                if(Flags & 0x0002)
+                {
+                    Local.E = ReadI16BE(At + 0);
+                    Local.F = ReadI16BE(At + 2);
+                }
+                At += 4;
+            }
+            else
+            {
+                if(At + 2 > End) return false;
+                if(Flags & 0x0002)
+                {
+                    Local.E = static_cast<int8_t>(At[0]);
+                    Local.F = static_cast<int8_t>(At[1]);
+                }
+                At += 2;
+            }
 
+            // Scales are F2Dot14.
 
-// TODO: Add (System) Font Support
-struct glyph_generator
-{
-    // Memory
-    memory_arena     *Arena;
+            if(Flags & 0x0008)
+            {
+                if(At + 2 > End) return false;
+                Local.A = Local.D = ReadI16BE(At) / 16384.f;
+                At += 2;
+            } else
+            if(Flags & 0x0040)
+            {
+                if(At + 4 > End) return false;
+                Local.A = ReadI16BE(At + 0) / 16384.f;
+                Local.D = ReadI16BE(At + 2) / 16384.f;
+                At += 4;
+            } else
+            if(Flags & 0x0080)
+            {
+                if(At + 8 > End) return false;
+                Local.A = ReadI16BE(At + 0) / 16384.f;
+                Local.B = ReadI16BE(At + 2) / 16384.f;
+                Local.C = ReadI16BE(At + 4) / 16384.f;
+                Local.D = ReadI16BE(At + 6) / 16384.f;
+                At += 8;
+            }
 
-    // Systems
-    glyph_table      *GlyphTable;
-    rectangle_packer *Packer;
+            truetype_transform Combined = ComposeTrueTypeTransform(Transform, Local);
+            if(!DecodeTrueTypeGlyph(Font, Component, Combined, Depth + 1, List, Arena))
+            {
+                return false;
+            }
+        } while(Flags & 0x0020);
+    }
 
-    // Misc
-    TextStorage       TextStorage;
-};
+    return true;
+}
 
-// Should we add a function to get the static footprint for the glyph generator?
 
+// Accumulation buffer rasterizer. Every edge deposits, in each pixel it crosses, how much the
+// signed area under it changes there. A prefix sum along the row then yields the exact coverage.
+// Rows are Width + 2 floats, the last two catch the writes of edges sitting on the right border.
 
-static glyph_generator
-CreateGlyphGenerator(glyph_generator_params Params)
+static void
+AccumulateTrueTypeEdge(truetype_edge Edge, float *Accumulation, uint32_t Width, uint32_t Height)
 {
-    glyph_generator Generator = {};
+    float Direction = 1.f;
+    float X0 = Edge.X0, Y0 = Edge.Y0;
+    float X1 = Edge.X1, Y1 = Edge.Y1;
 
-    if(Params.FrameMemoryBudget == 0 || Params.FrameMemory == 0 || Params.TextStorage == TextStorage::None)
+    if(Y0 > Y1)
     {
-        return Generator;
+        Direction = -1.f;
+        X0 = Edge.X1; Y0 = Edge.Y1;
+        X1 = Edge.X0; Y1 = Edge.Y0;
     }
 
-    // Arena Initialization
+    float MaxX = static_cast<float>(Width);
+    X0 = X0 < 0.f ? 0.f : (X0 > MaxX ? MaxX : X0);
+    X1 = X1 < 0.f ? 0.f : (X1 > MaxX ? MaxX : X1);
+
+    float DXDY = (X1 - X0) / (Y1 - Y0);
+    float X    = X0;
+
+    if(Y0 < 0.f)
     {
-        NTEXT_ASSERT(Params.FrameMemory);
-        NTEXT_ASSERT(Params.FrameMemoryBudget);
+        X -= Y0 * DXDY;
+    }
 
-        Generator.Arena = static_cast<memory_arena *>(Params.FrameMemory);
-        Generator.Arena->Reserved     = Params.FrameMemoryBudget;
-        Generator.Arena->BasePosition = 0;
-        Generator.Arena->Position     = sizeof(memory_arena);
+    uint32_t RowStride = Width + 2;
+    int32_t  FirstRow  = Y0 < 0.f ? 0 : static_cast<int32_t>(Y0);
+    int32_t  LastRow   = static_cast<int32_t>(ceilf(Y1));
+
+    if(LastRow > static_cast<int32_t>(Height))
+    {
+        LastRow = static_cast<int32_t>(Height);
     }
 
-    // Glyph Table
+    for(int32_t Y = FirstRow; Y < LastRow; ++Y)
     {
-        glyph_table_params Params =
+        float *Row = Accumulation + (Y * RowStride);
+
+        float RowTop    = static_cast<float>(Y)     > Y0 ? static_cast<float>(Y)     : Y0;
+        float RowBottom = static_cast<float>(Y + 1) < Y1 ? static_cast<float>(Y + 1) : Y1;
+        float DY        = RowBottom - RowTop;
+        float XNext     = X + DXDY * DY;
+        float D         = DY * Direction;
+
+        float Left  = X < XNext ? X     : XNext;
+        float Right = X < XNext ? XNext : X;
+
+        float   LeftFloor  = floorf(Left);
+        int32_t LeftIdx    = static_cast<int32_t>(LeftFloor);
+        float   RightCeil  = ceilf(Right);
+        int32_t RightIdx   = static_cast<int32_t>(RightCeil);
+
+        if(RightIdx <= LeftIdx + 1)
         {
-            .GroupWidth = GlyphTableWidth::_128Bits,
-            .GroupCount = 64,
-        };
+            // The edge stays within one pixel: split by where its midpoint lands.
+            float Mid = 0.5f * (X + XNext) - LeftFloor;
 
-        uint64_t Footprint = GetGlyphTableFootprint(Params);
-        void    *Memory    = PushArena(Generator.Arena, Footprint, AlignOf(void *));
+            Row[LeftIdx]     += D - D * Mid;
+            Row[LeftIdx + 1] += D * Mid;
+        }
+        else
+        {
+            // Spans several pixels: triangle at each end, constant slope in between.
+            float InvSpan   = 1.f / (Right - Left);
+            float LeftFrac  = Left - LeftFloor;
+            float LeftArea  = 0.5f * InvSpan * (1.f - LeftFrac) * (1.f - LeftFrac);
+            float RightFrac = Right - RightCeil + 1.f;
+            float RightArea = 0.5f * InvSpan * RightFrac * RightFrac;
 
-        Generator.GlyphTable = PlaceGlyphTableInMemory(Params, Memory);
+            Row[LeftIdx] += D * LeftArea;
 
-        NTEXT_ASSERT(Generator.GlyphTable);
-    }
+            if(RightIdx == LeftIdx + 2)
+            {
+                Row[LeftIdx + 1] += D * (1.f - LeftArea - RightArea);
+            }
+            else
+            {
+                float Area = InvSpan * (1.5f - LeftFrac);
+                Row[LeftIdx + 1] += D * (Area - LeftArea);
 
-    // Packer
-    {
-        uint64_t Footprint = GetRectanglePackerFootprint(Params.CacheSizeX);
-        void    *Memory    = PushArena(Generator.Arena, Footprint, AlignOf(void *));
+                for(int32_t Idx = LeftIdx + 2; Idx < RightIdx - 1; ++Idx)
+                {
+                    Row[Idx] += D * InvSpan;
+                }
+
+                float Covered = Area + static_cast<float>(RightIdx - LeftIdx - 3) * InvSpan;
+                Row[RightIdx - 1] += D * (1.f - Covered - RightArea);
+            }
 
-        Generator.Packer = PlaceRectanglePackerInMemory(Params.CacheSizeX, Params.CacheSizeY, Memory);
+            Row[RightIdx] += D * RightArea;
+        }
 
-        NTEXT_ASSERT(Generator.Packer);
+        X = XNext;
     }
+}
 
-    // Constant Forwarding
+
+// Prefix sum of one accumulation row into 8-bit alpha. |Sum| is clamped to 1, which is the
+// non-zero rule as long as overlapping contours wind the same way (they do in TrueType).
+// Cells are rounded to fixed point before the sum so the SIMD scans, which add in another
+// order, give the exact same bytes as the scalar loop. 20 fractional bits keep the error far
+// below one alpha step. The scalar version resolves [X, Width) from the running Sum, it is
+// also the tail of the SIMD one.
+
+constexpr int32_t TrueTypeCoverageShift = 20;
+constexpr int32_t TrueTypeCoverageOne   = 1 << TrueTypeCoverageShift;
+
+static void
+ResolveTrueTypeCoverageRowScalar(const float *Row, uint8_t *Out, uint32_t X, uint32_t Width, int32_t Sum)
+{
+    for(; X < Width; ++X)
     {
-        NTEXT_ASSERT(Params.TextStorage != TextStorage::None);
+        Sum += _mm_cvtss_si32(_mm_set_ss(Row[X] * static_cast<float>(TrueTypeCoverageOne)));
 
-        Generator.TextStorage = Params.TextStorage;
+        int32_t Alpha = Sum < 0 ? -Sum : Sum;
+        Alpha  = Alpha > TrueTypeCoverageOne ? TrueTypeCoverageOne : Alpha;
+        Out[X] = static_cast<uint8_t>((Alpha * 255 + (TrueTypeCoverageOne >> 1)) >> TrueTypeCoverageShift);
     }
-
-    return Generator;
 }
 
 
-static bool IsValidGlyphGenerator(const glyph_generator &GlyphGenerator)
+static void
+ResolveTrueTypeCoverageRow(const float *Row, uint8_t *Out, uint32_t Width)
 {
-    bool Result = (GlyphGenerator.Arena != 0);
-    return Result;
-}
+    uint32_t X    = 0;
+    int32_t  Tail = 0;
 
+#if defined(__AVX2__)
+    {
+        __m256i Carry = _mm256_setzero_si256();
+        __m256  Fixed = _mm256_set1_ps(static_cast<float>(TrueTypeCoverageOne));
+        __m256i One   = _mm256_set1_epi32(TrueTypeCoverageOne);
+        __m256i Scale = _mm256_set1_epi32(255);
+        __m256i Round = _mm256_set1_epi32(TrueTypeCoverageOne >> 1);
 
-// ==================================================================================
-// @Public : NText String Utilities
-// ==================================================================================
+        for(; X + 8 <= Width; X += 8)
+        {
+            // In-lane scan, then carry the low lane total into the high lane.
+            __m256i Sum = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(Row + X), Fixed));
+            Sum = _mm256_add_epi32(Sum, _mm256_slli_si256(Sum, 4));
+            Sum = _mm256_add_epi32(Sum, _mm256_slli_si256(Sum, 8));
 
-struct word_slice
-{
-    uint64_t Start;
-    uint64_t Length;
-};
+            __m256i LowTotal = _mm256_shuffle_epi32(Sum, 0xFF);
+            LowTotal = _mm256_permute2x128_si256(LowTotal, LowTotal, 0x08);
 
+            Sum   = _mm256_add_epi32(_mm256_add_epi32(Sum, LowTotal), Carry);
+            Carry = _mm256_shuffle_epi32(Sum, 0xFF);
+            Carry = _mm256_permute2x128_si256(Carry, Carry, 0x11);
 
-struct word_slice_node
-{
-    word_slice_node *Next;
-    word_slice       Value;
-};
+            __m256i Alpha = _mm256_min_epi32(_mm256_abs_epi32(Sum), One);
+            __m256i Bytes = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(Alpha, Scale), Round), TrueTypeCoverageShift);
 
+            __m128i Packed = _mm_packus_epi32(_mm256_castsi256_si128(Bytes), _mm256_extracti128_si256(Bytes, 1));
+            Packed = _mm_packus_epi16(Packed, Packed);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(Out + X), Packed);
+        }
 
-struct word_slice_list
-{
-    word_slice_node *First;
-    word_slice_node *Last;
-    uint32_t         Count;
-};
+        // Hand the running sum to the scalar tail.
+        Tail = _mm_cvtsi128_si32(_mm256_castsi256_si128(Carry));
+    }
+#else
+    {
+        // SSE2 only: abs, min and the multiply by 255 are spelled out.
 
+        __m128i Carry = _mm_setzero_si128();
+        __m128  Fixed = _mm_set1_ps(static_cast<float>(TrueTypeCoverageOne));
+        __m128i One   = _mm_set1_epi32(TrueTypeCoverageOne);
+        __m128i Round = _mm_set1_epi32(TrueTypeCoverageOne >> 1);
 
-enum class TextAnalysis
-{
-    None               = 0,
-    GenerateWordSlices = 1,
-    SkipComplexCheck   = 2, // Rename this to something like IsAsciiUnsafe?
-};
+        for(; X + 4 <= Width; X += 4)
+        {
+            __m128i Sum = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(Row + X), Fixed));
+            Sum = _mm_add_epi32(Sum, _mm_slli_si128(Sum, 4));
+            Sum = _mm_add_epi32(Sum, _mm_slli_si128(Sum, 8));
+            Sum = _mm_add_epi32(Sum, Carry);
 
-inline TextAnalysis operator|(TextAnalysis A, TextAnalysis B)   {return static_cast<TextAnalysis>(static_cast<int>(A) | static_cast<int>(B));}
-inline TextAnalysis operator&(TextAnalysis A, TextAnalysis B)   {return static_cast<TextAnalysis>(static_cast<int>(A) & static_cast<int>(B));}
+            Carry = _mm_shuffle_epi32(Sum, _MM_SHUFFLE(3, 3, 3, 3));
 
+            __m128i Sign  = _mm_srai_epi32(Sum, 31);
+            __m128i Alpha = _mm_sub_epi32(_mm_xor_si128(Sum, Sign), Sign);
+            __m128i Over  = _mm_cmpgt_epi32(Alpha, One);
+            Alpha = _mm_or_si128(_mm_and_si128(Over, One), _mm_andnot_si128(Over, Alpha));
 
-struct unicode_decode
-{
-    uint32_t Increment;
-    uint32_t Codepoint;
-};
+            __m128i Bytes = _mm_sub_epi32(_mm_slli_epi32(Alpha, 8), Alpha);
+            Bytes = _mm_srli_epi32(_mm_add_epi32(Bytes, Round), TrueTypeCoverageShift);
+            Bytes = _mm_packs_epi32(Bytes, Bytes);
+            Bytes = _mm_packus_epi16(Bytes, Bytes);
 
+            int32_t Packed = _mm_cvtsi128_si32(Bytes);
+            memcpy(Out + X, &Packed, 4);
+        }
 
-struct analysed_text
-{
-    bool             IsComplex;
-    word_slice_list  Words;
-    uint32_t        *Codepoints;
-    uint64_t         CodepointCount;
-    uint64_t         GlyphCount;
-};
+        Tail = _mm_cvtsi128_si32(Carry);
+    }
+#endif
 
+    ResolveTrueTypeCoverageRowScalar(Row, Out, X, Width, Tail);
+}
 
-const static uint8_t UTF8Class[32] = 
+
+static void
+RasterizeTrueTypeEdges(truetype_edge_list *List, uint8_t *Out, uint32_t Width, uint32_t Height, uint32_t Stride, memory_arena *Arena)
 {
-  1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0,0,0,2,2,2,2,3,3,4,5,
-};
+    uint32_t RowStride    = Width + 2;
+    float   *Accumulation = PushArrayAligned<float>(Arena, RowStride * Height, 32);
 
+    if(!Accumulation)
+    {
+        return;
+    }
 
-static unicode_decode 
-UTF8Decode(char *String, uint64_t Maximum)
+    memset(Accumulation, 0, RowStride * Height * sizeof(float));
+
+    for(uint32_t Idx = 0; Idx < List->Count; ++Idx)
+    {
+        AccumulateTrueTypeEdge(List->Edges[Idx], Accumulation, Width, Height);
+    }
+
+    for(uint32_t Y = 0; Y < Height; ++Y)
+    {
+        ResolveTrueTypeCoverageRow(Accumulation + (Y * RowStride), Out + (Y * Stride), Width);
+    }
+}
+
+
+static bool
+IsValidSystemFont(system_font *Font)
 {
-    unicode_decode Result = { 1, _UI32_MAX};
+    bool Result = (Font && Font->FontFace && Font->Info && Font->Size);
+    return Result;
+}
 
-    uint8_t Byte      = String[0];
-    uint8_t ByteClass = UTF8Class[Byte >> 3];
 
-    switch (ByteClass)
+static font_face_info *
+CreateFontFaceInfo(truetype_font *FontFace, float Size, memory_arena *Arena)
+{
+    font_face_info *Result = PushStruct<font_face_info>(Arena);
+    uint16_t       *Table  = PushArray<uint16_t>(Arena, FontFaceBMPSize);
+
+    if(Result && Table)
     {
+        float Scale = Size / static_cast<float>(FontFace->UnitsPerEm);
+
+        *Result = {};
+        Result->Scale         = Scale;
+        Result->Ascent        =  FontFace->Ascent  * Scale;
+        Result->Descent       = -FontFace->Descent * Scale;
+        Result->LineGap       =  FontFace->LineGap * Scale;
+        Result->GlyphIndexBMP = Table;
+    }
 
-    case 1:
+    return Result;
+}
+
+
+// The file is mapped read-only and never copied. Only the table directory and the
+// head/hhea/maxp headers are read here, so the cost does not depend on the font size.
+
+static system_font
+LoadFontFromFile(const char *Path, float Size, memory_arena *Arena, backend_context Backend)
+{
+    system_font SystemFont = {};
+
+    if(!Backend.IsInitialized)
     {
-        Result.Codepoint = Byte;
-    } break;
+        return SystemFont;
+    }
 
-    case 2:
+    mapped_file File = MapFileReadOnly(Path);
+    if(File.Data)
     {
-        if (1 < Maximum)
+        truetype_font *Face = PushStruct<truetype_font>(Arena);
+        if(Face)
         {
-            char ContByte = String[1];
-            if (UTF8Class[ContByte >> 3] == 0)
+            *Face = {};
+            if(ParseTrueTypeFont(File.Data, File.Size, Face))
             {
-                Result.Codepoint  = (Byte     & 0b00011111) << 6;
-                Result.Codepoint |= (ContByte & 0b00111111) << 0;
-                Result.Increment  = 2;
+                Face->File = File;
+
+                SystemFont.FontFace = Face;
+                SystemFont.Info     = CreateFontFaceInfo(Face, Size, Arena);
+                SystemFont.Size     = Size;
+                SystemFont.Id       = ComputeFontId(Path);
             }
         }
-    } break;
 
-    case 3:
-    {
-        if (2 < Maximum)
+        if(!SystemFont.FontFace)
         {
-            char ContByte[2] = { String[1], String[2] };
-            if (UTF8Class[ContByte[0] >> 3] == 0 && UTF8Class[ContByte[1] >> 3] == 0)
-            {
-                Result.Codepoint  = ((Byte        & 0b00001111) << 12);
-                Result.Codepoint |= ((ContByte[0] & 0b00111111) << 6 );
-                Result.Codepoint |= ((ContByte[1] & 0b00111111) << 0 );
-                Result.Increment  = 3;
-            }
+            UnmapFile(&File);
         }
-    } break;
+    }
 
-    case 4:
+    return SystemFont;
+}
+
+
+// Unmaps the font file. Font and every copy of it are invalid afterwards, as are runs shaped with it.
+// What LoadFontFromFile took from the arena stays there, and so do its glyphs in the cache (see RemoveCachedGlyph).
+
+static void
+ReleaseFont(system_font *Font, backend_context Backend)
+{
+    if(Font && Font->FontFace && Backend.IsInitialized)
     {
-        if (3 < Maximum)
+        UnmapFile(&Font->FontFace->File);
+        *Font = {};
+    }
+}
+
+
+// There is no system font collection on this backend: Name is the path to a .ttf file.
+
+static system_font
+LoadSystemFont(const char *Name, float Size, memory_arena *Arena, backend_context Backend)
+{
+    system_font Result = LoadFontFromFile(Name, Size, Arena, Backend);
+    return Result;
+}
+
+
+static bool
+IsValidBackendContext(backend_context *Backend)
+{
+    bool Result = (Backend && Backend->IsInitialized);
+    return Result;
+}
+
+
+static backend_context
+InitializeBackendContext(void)
+{
+    backend_context Result = {};
+    Result.IsInitialized = true;
+
+    return Result;
+}
+
+
+static uint16_t
+FindGlyphIndex(uint32_t CodePoint, system_font Font)
+{
+    uint16_t Result = 0;
+
+    if(CodePoint < FontFaceBMPSize)
+    {
+        uint32_t Page = CodePoint / FontFacePageSize;
+
+        if(!IsGlyphIndexPageResolved(Page, Font.Info))
         {
-            char ContByte[3] = { String[1], String[2], String[3] };
-            if (UTF8Class[ContByte[0] >> 3] == 0 && UTF8Class[ContByte[1] >> 3] == 0 && UTF8Class[ContByte[2] >> 3] == 0)
+            uint16_t *Table = Font.Info->GlyphIndexBMP + (Page * FontFacePageSize);
+            for(uint32_t Idx = 0; Idx < FontFacePageSize; ++Idx)
             {
-                Result.Codepoint  = (Byte        & 0b00000111) << 18;
-                Result.Codepoint |= (ContByte[0] & 0b00111111) << 12;
-                Result.Codepoint |= (ContByte[1] & 0b00111111) << 6;
-                Result.Codepoint |= (ContByte[2] & 0b00111111) << 0;
-                Result.Increment = 4;
+                Table[Idx] = LookupTrueTypeGlyphIndex(Font.FontFace, (Page * FontFacePageSize) + Idx);
             }
+
+            MarkGlyphIndexPageResolved(Page, Font.Info);
         }
-    } break;
 
+        Result = Font.Info->GlyphIndexBMP[CodePoint];
+    }
+    else
+    {
+        Result = LookupTrueTypeGlyphIndex(Font.FontFace, CodePoint);
     }
 
     return Result;
 }
 
 
-static analysed_text
-AnalyzeText(char *Data, uint64_t Size, TextAnalysis Flags, glyph_generator &Generator)
+// OffsetX/OffsetY locate the top-left of the rasterized buffer relative to the pen on the baseline (Y up).
+
+static os_glyph_info
+FindGlyphInformation(uint32_t CodePoint, system_font Font)
 {
-    NTEXT_ASSERT(Data);
-    NTEXT_ASSERT(Size);
+    os_glyph_info Result = {};
 
-    analysed_text Result =
+    if(IsValidSystemFont(&Font))
     {
-        .Codepoints = PushArray<uint32_t>(Generator.Arena, Size),
-    };
+        truetype_font *Face  = Font.FontFace;
+        float          Scale = Font.Info->Scale;
 
-    if(Result.Codepoints)
-    {
-        uint64_t DecodedBytes = 0;
+        uint16_t GlyphIndex  = FindGlyphIndex(CodePoint, Font);
+        uint16_t Advance     = 0;
+        int16_t  LeftBearing = 0;
+        GetTrueTypeHorizontalMetrics(Face, GlyphIndex, &Advance, &LeftBearing);
 
-        while(DecodedBytes < Size)
+        truetype_pixel_box Box = GetTrueTypeGlyphPixelBox(Face, GlyphIndex, Scale, 0.f);
+
+        Result =
         {
-            unicode_decode Decoded = UTF8Decode(Data + DecodedBytes, Size - DecodedBytes);
+            .GlyphIndex = GlyphIndex,
+            .Advance    = static_cast<float>(Advance * Scale),
+            .OffsetX    = static_cast<float>(Box.X0),
+            .OffsetY    = static_cast<float>(-Box.Y0),
+            .SizeX      = static_cast<float>(Box.X1 - Box.X0),
+            .SizeY      = static_cast<float>(Box.Y1 - Box.Y0),
+        };
+    }
 
-            Result.Codepoints[Result.CodepointCount++] = Decoded.Codepoint;
-            DecodedBytes                              += Decoded.Increment;
-        }
+    return Result;
+}
 
-        if(!((Flags & TextAnalysis::SkipComplexCheck) != TextAnalysis::None))
-        {
-            char    *At                = Data;
-            uint64_t Remaining         = Size;
-            uint64_t Advance           = 16;
-            __m128i  ComplexByteVector = _mm_set1_epi8(0x80);
 
-            __m128i HasComplex = _mm_setzero_si128();
-            while(Remaining >= Advance)
-            {
-                __m128i Batch = _mm_loadu_si128((__m128i *)At);
-                __m128i TextX = _mm_and_si128(Batch, ComplexByteVector);
+static void
+FindGlyphInformationBatch(uint32_t *Codepoints, uint32_t Count, system_font Font, os_glyph_info_batch *Out)
+{
+    NTEXT_ASSERT(Out && Out->Count >= Count);
 
-                HasComplex = _mm_or_si128(HasComplex, TextX);
+    if(!IsValidSystemFont(&Font))
+    {
+        return;
+    }
 
-                if(_mm_movemask_epi8(HasComplex))
-                {
-                    Result.IsComplex = true;
-                    break;
-                }
+    truetype_font *Face  = Font.FontFace;
+    float          Scale = Font.Info->Scale;
 
-                Remaining -= Advance;
-                At        += Advance;
-            }
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        Out->GlyphIndices[Idx] = FindGlyphIndex(Codepoints[Idx], Font);
+    }
 
-            if(!Result.IsComplex)
-            {
-                while(Remaining--)
-                {
-                    if(*At == (char)0x80)
-                    {
-                        Result.IsComplex = true;
-                        break;
-                    }
-                }
-            }
-        }
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        uint16_t Advance     = 0;
+        int16_t  LeftBearing = 0;
+        GetTrueTypeHorizontalMetrics(Face, Out->GlyphIndices[Idx], &Advance, &LeftBearing);
 
-        if((Flags & TextAnalysis::GenerateWordSlices) != TextAnalysis::None)
-        {
-            // We only handle simple ASCII path for now. Which is fine.
+        truetype_pixel_box Box = GetTrueTypeGlyphPixelBox(Face, Out->GlyphIndices[Idx], Scale, 0.f);
 
-            uint64_t CodepointIdx = 0;
+        Out->Advances[Idx] = static_cast<float>(Advance * Scale);
+        Out->OffsetsX[Idx] = static_cast<float>(Box.X0);
+        Out->OffsetsY[Idx] = static_cast<float>(-Box.Y0);
+        Out->SizesX  [Idx] = static_cast<float>(Box.X1 - Box.X0);
+        Out->SizesY  [Idx] = static_cast<float>(Box.Y1 - Box.Y0);
+    }
+}
 
-            while(CodepointIdx < Result.CodepointCount)
+
+static rasterized_buffer
+RasterizeGlyphToAlphaTexture(uint16_t GlyphIndex, float Advance, float SubpixelX, system_font Font, backend_context Backend, memory_arena *Arena)
+{
+    rasterized_buffer Result = {};
+
+    if(IsValidSystemFont(&Font) && IsValidBackendContext(&Backend))
+    {
+        truetype_font     *Face  = Font.FontFace;
+        float              Scale = Font.Info->Scale;
+        truetype_pixel_box Box   = GetTrueTypeGlyphPixelBox(Face, GlyphIndex, Scale, SubpixelX);
+
+        uint32_t TextureWidth  = static_cast<uint32_t>(Box.X1 - Box.X0);
+        uint32_t TextureHeight = static_cast<uint32_t>(Box.Y1 - Box.Y0);
+
+        if(TextureWidth > 0 && TextureHeight > 0)
+        {
+            uint32_t BytesPerPixel = 1;
+            uint32_t Stride        = TextureWidth * BytesPerPixel;
+            uint8_t *Buffer        = PushArray<uint8_t>(Arena, Stride * TextureHeight);
+
+            if(Buffer)
             {
-                uint32_t Codepoint = Result.Codepoints[CodepointIdx];
-        
-                if(Codepoint != ' ' && Codepoint != '\t')
+                // Edges and scanline scratch live past the buffer and are popped once we are done.
+
+                memory_region Region = EnterMemoryRegion(Arena);
+
+                truetype_transform Transform =
                 {
-                    word_slice_node *Node = PushStruct<word_slice_node>(Generator.Arena);
-                    if(Node)
-                    {
-                        word_slice_list &List = Result.Words;
+                    .A = Scale, .B = 0.f, .C = 0.f, .D = -Scale,
+                    .E = static_cast<float>(-Box.X0) + SubpixelX,
+                    .F = static_cast<float>(-Box.Y0),
+                };
 
-                        Node->Value.Start  = CodepointIdx;
-                        Node->Value.Length = 0;
-        
-                        if(!List.First)
-                        {
-                             List.First = Node;
-                        }
-            
-                        if(List.Last)
-                        {
-                            List.Last->Next = Node;
-                        }
-            
-                        List.Last   = Node;
-                        List.Count += 1;
-        
-                        Codepoint = Data[++CodepointIdx];
-                        while(CodepointIdx < Result.CodepointCount && Codepoint != ' ' && Codepoint != '\t')
-                        {
-                            CodepointIdx += 1;
-                            Codepoint     = Result.Codepoints[CodepointIdx];
-                        }
-        
-                        Node->Value.Length = CodepointIdx - Node->Value.Start;
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-                else
+                truetype_edge_list List = {};
+                List.Capacity = CountTrueTypeGlyphPoints(Face, GlyphIndex, 0) * TrueTypeMaxCurveSteps;
+                List.Edges    = List.Capacity ? PushArray<truetype_edge>(Arena, List.Capacity) : 0;
+
+                if(!List.Edges || !DecodeTrueTypeGlyph(Face, GlyphIndex, Transform, 0, &List, Arena))
                 {
-                    ++CodepointIdx;
+                    List.Count = 0;
                 }
+
+                RasterizeTrueTypeEdges(&List, Buffer, TextureWidth, TextureHeight, Stride, Arena);
+
+                LeaveMemoryRegion(Region);
+
+                Result.Data          = Buffer;
+                Result.Stride        = Stride;
+                Result.Width         = TextureWidth;
+                Result.Height        = TextureHeight;
+                Result.BytesPerPixel = BytesPerPixel;
             }
         }
     }
 
-
     return Result;
 }
 
+#endif // NTEXT_TRUETYPE
+
+
 // ==================================================================================
-// @Public : NText Collection
+// @Internal : Signed Distance Fields
+// Turns an alpha coverage buffer into a single channel distance field, using the
+// separable Euclidean distance transform (Felzenszwalb & Huttenlocher) on the inside
+// and outside of the shape. Partial coverage seeds sub-pixel distances, which keeps
+// the edges of small glyphs smooth.
+//
+// Encoding: Value / 255 = 0.5 - Distance / Range, where Range = 2 * Spread and Distance
+// is in rasterized pixels, positive outside of the glyph.
 // ==================================================================================
 
-enum class TextureFormat
-{
-    None      = 0,
-    RGBA      = 1,
-    GreyScale = 2,
-};
+constexpr float SDFInfinity = 1e20f;
 
 
-struct rasterized_glyph
+static void
+DistanceTransform1D(float *Grid, uint32_t Offset, uint32_t Stride, uint32_t Length, float *F, float *Z, uint32_t *V)
 {
-    rectangle         Source;
-    rasterized_buffer Buffer;
-};
+    V[0] = 0;
+    Z[0] = -SDFInfinity;
+    Z[1] =  SDFInfinity;
+    F[0] = Grid[Offset];
 
+    // Lower envelope of the parabolas rooted at every sample.
 
-struct rasterized_glyph_node
-{
-    rasterized_glyph_node *Next;
-    rasterized_glyph       Value;
-};
+    int32_t K = 0;
+    for(uint32_t Q = 1; Q < Length; ++Q)
+    {
+        F[Q] = Grid[Offset + (Q * Stride)];
 
+        float S = 0.f;
+        do
+        {
+            uint32_t R = V[K];
+            S = ((F[Q] - F[R]) + static_cast<float>(Q * Q) - static_cast<float>(R * R)) / static_cast<float>(2 * (Q - R));
+        } while(S <= Z[K] && --K > -1);
+
+        K += 1;
+        V[K]     = Q;
+        Z[K]     = S;
+        Z[K + 1] = SDFInfinity;
+    }
 
-struct rasterized_glyph_list
-{
-    rasterized_glyph_node *First;
-    rasterized_glyph_node *Last;
-    uint32_t               Count;
-};
+    K = 0;
+    for(uint32_t Q = 0; Q < Length; ++Q)
+    {
+        while(Z[K + 1] < static_cast<float>(Q))
+        {
+            K += 1;
+        }
 
+        uint32_t R  = V[K];
+        float    QR = static_cast<float>(Q) - static_cast<float>(R);
 
-struct shaped_glyph
-{
-    uint16_t          GlyphIndex;
-    rectangle         Source;
-    glyph_layout_info Layout;
-    uint32_t          ClusterStart;
-    uint32_t          ClusterCount;
-};
+        Grid[Offset + (Q * Stride)] = F[R] + (QR * QR);
+    }
+}
 
 
-struct shaped_glyph_run
+static void
+DistanceTransform2D(float *Grid, uint32_t Width, uint32_t Height, float *F, float *Z, uint32_t *V)
 {
-    rasterized_glyph_list UpdateList;
-    shaped_glyph         *Shaped;
-    uint32_t              ShapedCount;
-};
+    for(uint32_t X = 0; X < Width; ++X)
+    {
+        DistanceTransform1D(Grid, X, Width, Height, F, Z, V);
+    }
 
+    for(uint32_t Y = 0; Y < Height; ++Y)
+    {
+        DistanceTransform1D(Grid, Y * Width, 1, Width, F, Z, V);
+    }
+}
 
-struct word_glyph_cursor
-{
-    shaped_glyph *Glyphs;
-    uint32_t      GlyphCount;
-    uint32_t      GlyphAt;
-};
 
+// The result is Spread pixels larger than the coverage on every side so the field has room to fall off.
 
-struct word_advance
+static rasterized_buffer
+BuildSignedDistanceField(rasterized_buffer Coverage, uint32_t Spread, memory_arena *Arena)
 {
-    float Advance;
-    float LeadingWhitespaceAdvance;
-};
+    NTEXT_ASSERT(Coverage.Data && Coverage.BytesPerPixel == 1);
+    NTEXT_ASSERT(Spread);
 
+    rasterized_buffer Result = {};
 
-// TODO: Error checks.
-static shaped_glyph_run
-FillAtlas(analysed_text Analysed, glyph_generator &Generator, system_font Font, backend_context Backend)
-{
-    shaped_glyph_run Run = {};
-    Run.Shaped = PushArray<shaped_glyph>(Generator.Arena, Analysed.CodepointCount);
+    uint32_t Width  = Coverage.Width  + (2 * Spread);
+    uint32_t Height = Coverage.Height + (2 * Spread);
+    uint8_t *Buffer = PushArray<uint8_t>(Arena, Width * Height);
 
-    if(!Analysed.IsComplex)
+    if(Buffer)
     {
-        for(uint32_t Idx = 0; Idx < Analysed.CodepointCount; ++Idx)
+        memory_region Region = EnterMemoryRegion(Arena);
+
+        uint32_t Longest = Width > Height ? Width : Height;
+        float   *Outer   = PushArray<float>(Arena, Width * Height);
+        float   *Inner   = PushArray<float>(Arena, Width * Height);
+        float   *F       = PushArray<float>(Arena, Longest);
+        float   *Z       = PushArray<float>(Arena, Longest + 1);
+        uint32_t *V      = PushArray<uint32_t>(Arena, Longest);
+
+        if(Outer && Inner && F && Z && V)
         {
-            uint32_t Codepoint = Analysed.Codepoints[Idx];
-        
-            glyph_hash  Hash  = ComputeGlyphHash(1, &Codepoint, 0, DefaultSeed);
-            glyph_state State = FindGlyphEntryByHash(Hash, Generator.GlyphTable);
+            for(uint32_t Idx = 0; Idx < Width * Height; ++Idx)
+            {
+                Outer[Idx] = SDFInfinity;
+                Inner[Idx] = 0.f;
+            }
+
+            for(uint32_t Y = 0; Y < Coverage.Height; ++Y)
+            {
+                uint8_t *Row = static_cast<uint8_t *>(Coverage.Data) + (Y * Coverage.Stride);
+
+                for(uint32_t X = 0; X < Coverage.Width; ++X)
+                {
+                    uint32_t Idx   = ((Y + Spread) * Width) + (X + Spread);
+                    float    Alpha = Row[X] / 255.f;
+
+                    if(Row[X] == 255)
+                    {
+                        Outer[Idx] = 0.f;
+                        Inner[Idx] = SDFInfinity;
+                    } else
+                    if(Row[X] != 0)
+                    {
+                        float OuterDistance = Alpha < 0.5f ? 0.5f - Alpha : 0.f;
+                        float InnerDistance = Alpha > 0.5f ? Alpha - 0.5f : 0.f;
+
+                        Outer[Idx] = OuterDistance * OuterDistance;
+                        Inner[Idx] = InnerDistance * InnerDistance;
+                    }
+                }
+            }
+
+            DistanceTransform2D(Outer, Width, Height, F, Z, V);
+            DistanceTransform2D(Inner, Width, Height, F, Z, V);
+
+            float Range = static_cast<float>(2 * Spread);
+            for(uint32_t Idx = 0; Idx < Width * Height; ++Idx)
+            {
+                float Distance = sqrtf(Outer[Idx]) - sqrtf(Inner[Idx]);
+                float Value    = (0.5f - (Distance / Range)) * 255.f + 0.5f;
+
+                Buffer[Idx] = static_cast<uint8_t>(Value < 0.f ? 0.f : (Value > 255.f ? 255.f : Value));
+            }
+
+            Result.Data          = Buffer;
+            Result.Stride        = Width;
+            Result.Width         = Width;
+            Result.Height        = Height;
+            Result.BytesPerPixel = 1;
+        }
+
+        LeaveMemoryRegion(Region);
+    }
+
+    return Result;
+}
+
+
+// ==================================================================================
+// @Internal : Rectangle Packing
+// ==================================================================================
+
+struct point
+{
+    uint16_t X;
+    uint16_t Y;
+};
+
+
+// Skyline    : Bottom-left skyline. Fast and tight for glyphs, but cannot reuse what is freed under it.
+// Shelf      : Rows as tall as the glyph that opened them. The cheapest, and the one that wastes the most height.
+// Guillotine : Free rectangles, split in two on every placement (best area fit).
+// MaxRects   : Maximal free rectangles (best short side fit). The densest and the slowest.
+//
+// Skyline and Shelf cannot give space back: evicted rectangles are only accounted for in ReleasedArea,
+// which tells how much of the packed area is actually dead. The free-list packers take them back.
+
+enum class RectanglePacker
+{
+    Skyline    = 0,
+    Shelf      = 1,
+    Guillotine = 2,
+    MaxRects   = 3,
+};
+
+
+struct packer_shelf
+{
+    uint16_t Y;
+    uint16_t Height;
+    uint16_t UsedWidth;
+};
+
+
+struct free_rectangle
+{
+    uint16_t X;
+    uint16_t Y;
+    uint16_t Width;
+    uint16_t Height;
+};
+
+
+// The skyline is kept as two arrays so PackRectangle can scan eight segments at once. SkylineX[SkylineCount]
+// is always UINT16_MAX and both arrays have room for a full vector past it.
+// The free list has a fixed capacity. A piece that does not fit on it any more is counted in ReleasedArea
+// instead, so the space is not lost for good: compaction takes it back with the rest of the page.
+
+constexpr uint16_t SkylinePadding = 8;
+
+struct rectangle_packer
+{
+    RectanglePacker Kind;
+    uint16_t        Width;
+    uint16_t        Height;
+    uint64_t        ReleasedArea;
+
+    // Skyline
+    uint16_t       *SkylineX;
+    uint16_t       *SkylineY;
+    uint16_t        SkylineCount;
+
+    // Shelf
+    packer_shelf   *Shelves;
+    uint32_t        ShelfCount;
+
+    // Guillotine, MaxRects
+    free_rectangle *FreeRects;
+    uint32_t        FreeCount;
+    uint32_t        FreeCapacity;
+};
+
+
+struct packed_rectangle
+{
+    uint16_t Width;
+    uint16_t Height;
+
+    uint16_t X;
+    uint16_t Y;
+    bool     WasPacked;
+};
+
+
+struct rectangle
+{
+    float Left;
+    float Top;
+    float Right;
+    float Bottom;
+};
+
+
+// How many elements the state of a packer can hold: skyline segments, shelves or free rectangles.
+
+static uint32_t
+GetRectanglePackerCapacity(RectanglePacker Kind, uint16_t Width, uint16_t Height)
+{
+    uint32_t Result = 0;
+
+    switch(Kind)
+    {
+        case RectanglePacker::Skyline:    Result = Width;                    break;
+        case RectanglePacker::Shelf:      Result = Height;                   break;
+        case RectanglePacker::Guillotine:
+        case RectanglePacker::MaxRects:   Result = 2u * (Width + Height);    break;
+    }
+
+    return Result;
+}
+
+
+static uint64_t
+GetRectanglePackerStateSize(RectanglePacker Kind, uint32_t Count)
+{
+    uint64_t Result = 0;
+
+    switch(Kind)
+    {
+        case RectanglePacker::Skyline:    Result = Count * 2 * sizeof(uint16_t);    break;
+        case RectanglePacker::Shelf:      Result = Count * sizeof(packer_shelf);    break;
+        case RectanglePacker::Guillotine:
+        case RectanglePacker::MaxRects:   Result = Count * sizeof(free_rectangle);  break;
+    }
+
+    return Result;
+}
+
+
+static uint64_t
+GetRectanglePackerArraySize(RectanglePacker Kind, uint16_t Width, uint16_t Height)
+{
+    uint32_t Capacity = GetRectanglePackerCapacity(Kind, Width, Height);
+    uint64_t Result   = 0;
+
+    if(Kind == RectanglePacker::Skyline)
+    {
+        Result = 2 * NTEXT_ALIGNPOW2((Capacity + SkylinePadding) * sizeof(uint16_t), AlignOf(rectangle_packer));
+    }
+    else
+    {
+        Result = NTEXT_ALIGNPOW2(GetRectanglePackerStateSize(Kind, Capacity), AlignOf(rectangle_packer));
+    }
+
+    return Result;
+}
+
+
+static uint64_t
+GetRectanglePackerFootprint(RectanglePacker Kind, uint16_t Width, uint16_t Height)
+{
+    uint64_t Result = sizeof(rectangle_packer) + GetRectanglePackerArraySize(Kind, Width, Height);
+    return Result;
+}
+
+
+static void
+ResetRectanglePacker(rectangle_packer *Packer)
+{
+    NTEXT_ASSERT(Packer);
+
+    switch(Packer->Kind)
+    {
+
+    case RectanglePacker::Skyline:
+    {
+        Packer->SkylineCount = 1;
+        Packer->SkylineX[0]  = 0;
+        Packer->SkylineY[0]  = 0;
+        Packer->SkylineX[1]  = UINT16_MAX;
+    } break;
+
+    case RectanglePacker::Shelf:
+    {
+        Packer->ShelfCount = 0;
+    } break;
+
+    case RectanglePacker::Guillotine:
+    case RectanglePacker::MaxRects:
+    {
+        Packer->FreeCount    = 1;
+        Packer->FreeRects[0] = {0, 0, Packer->Width, Packer->Height};
+    } break;
+
+    }
+
+    Packer->ReleasedArea = 0;
+}
+
+
+// The arrays come first, then the packer itself.
+
+static rectangle_packer *
+PlaceRectanglePackerInMemory(RectanglePacker Kind, uint16_t Width, uint16_t Height, void *Memory)
+{
+    rectangle_packer *Result = 0;
+
+    if(Memory)
+    {
+        uint64_t ArraySize = GetRectanglePackerArraySize(Kind, Width, Height);
+        uint8_t *Arrays    = (uint8_t *)Memory;
+
+        // Whatever the memory held, the skyline padding lanes are read and must not be garbage for the sanitizers.
+        memset(Arrays, 0, ArraySize);
+
+        Result = (rectangle_packer *)(Arrays + ArraySize);
+        memset(Result, 0, sizeof(rectangle_packer));
+
+        Result->Kind   = Kind;
+        Result->Width  = Width;
+        Result->Height = Height;
+
+        switch(Kind)
+        {
+            case RectanglePacker::Skyline:
+            {
+                Result->SkylineX = (uint16_t *)(Arrays);
+                Result->SkylineY = (uint16_t *)(Arrays + ArraySize / 2);
+            } break;
+
+            case RectanglePacker::Shelf:
+            {
+                Result->Shelves = (packer_shelf *)Arrays;
+            } break;
+
+            case RectanglePacker::Guillotine:
+            case RectanglePacker::MaxRects:
+            {
+                Result->FreeRects    = (free_rectangle *)Arrays;
+                Result->FreeCapacity = GetRectanglePackerCapacity(Kind, Width, Height);
+            } break;
+        }
+
+        ResetRectanglePacker(Result);
+    }
+
+    return Result;
+}
+
+
+static bool
+IsRectanglePackerEmpty(rectangle_packer *Packer)
+{
+    bool Result = false;
+
+    switch(Packer->Kind)
+    {
+        case RectanglePacker::Skyline: Result = Packer->SkylineCount == 1 && Packer->SkylineY[0] == 0; break;
+        case RectanglePacker::Shelf:   Result = Packer->ShelfCount == 0;                                break;
+
+        case RectanglePacker::Guillotine:
+        case RectanglePacker::MaxRects:
+        {
+            free_rectangle Free = Packer->FreeRects[0];
+            Result = Packer->FreeCount == 1 && Free.Width == Packer->Width && Free.Height == Packer->Height;
+        } break;
+    }
+
+    return Result;
+}
+
+
+// Snapshot support: the arrays that hold the state of a packer (at most two) and how many elements are in use.
+
+static uint32_t
+GetRectanglePackerState(rectangle_packer *Packer, file_chunk *Chunks, uint32_t *Count)
+{
+    uint32_t Result = 0;
+
+    switch(Packer->Kind)
+    {
+
+    case RectanglePacker::Skyline:
+    {
+        *Count    = Packer->SkylineCount;
+        Chunks[0] = {Packer->SkylineX, Packer->SkylineCount * sizeof(uint16_t)};
+        Chunks[1] = {Packer->SkylineY, Packer->SkylineCount * sizeof(uint16_t)};
+        Result    = 2;
+    } break;
+
+    case RectanglePacker::Shelf:
+    {
+        *Count    = Packer->ShelfCount;
+        Chunks[0] = {Packer->Shelves, Packer->ShelfCount * sizeof(packer_shelf)};
+        Result    = 1;
+    } break;
+
+    case RectanglePacker::Guillotine:
+    case RectanglePacker::MaxRects:
+    {
+        *Count    = Packer->FreeCount;
+        Chunks[0] = {Packer->FreeRects, Packer->FreeCount * sizeof(free_rectangle)};
+        Result    = 1;
+    } break;
+
+    }
+
+    return Result;
+}
+
+
+// Whether Count elements of saved state at At describe a packer of that size: skyline segments start at 0
+// and go right, shelves are stacked from the top, free rectangles are not empty. Everything stays in bounds.
+
+static bool
+IsRectanglePackerStateValid(const uint8_t *At, uint32_t Count, RectanglePacker Kind, uint16_t Width, uint16_t Height)
+{
+    bool Result = Count <= GetRectanglePackerCapacity(Kind, Width, Height);
+
+    switch(Kind)
+    {
+
+    case RectanglePacker::Skyline:
+    {
+        Result = Result && Count;
+
+        // MinX is where the next segment has to start at the earliest, the first one at 0 exactly.
+        uint32_t MinX = 0;
+
+        for(uint32_t Idx = 0; Result && Idx < Count; ++Idx)
+        {
+            uint16_t X, Y;
+            memcpy(&X, At + Idx * sizeof(uint16_t),           sizeof(X));
+            memcpy(&Y, At + (Count + Idx) * sizeof(uint16_t), sizeof(Y));
+
+            Result = (Idx ? X >= MinX : X == 0) && X < Width && Y <= Height;
+            MinX   = X + 1u;
+        }
+    } break;
+
+    case RectanglePacker::Shelf:
+    {
+        uint32_t Top = 0;
+
+        for(uint32_t Idx = 0; Result && Idx < Count; ++Idx)
+        {
+            packer_shelf Shelf;
+            memcpy(&Shelf, At + Idx * sizeof(packer_shelf), sizeof(Shelf));
+
+            Result = Shelf.Y == Top && Shelf.Height <= Height - Top && Shelf.UsedWidth <= Width;
+            Top   += Shelf.Height;
+        }
+    } break;
+
+    case RectanglePacker::Guillotine:
+    case RectanglePacker::MaxRects:
+    {
+        for(uint32_t Idx = 0; Result && Idx < Count; ++Idx)
+        {
+            free_rectangle Free;
+            memcpy(&Free, At + Idx * sizeof(free_rectangle), sizeof(Free));
+
+            Result = Free.Width && Free.Height && Free.X < Width && Free.Y < Height &&
+                     Free.Width <= Width - Free.X && Free.Height <= Height - Free.Y;
+        }
+    } break;
+
+    default:
+    {
+        Result = false;
+    } break;
+
+    }
+
+    return Result;
+}
+
+
+// Inverse of GetRectanglePackerState. The caller checked that Count fits, returns the bytes consumed.
+
+static uint64_t
+LoadRectanglePackerState(const uint8_t *At, uint32_t Count, rectangle_packer *Packer)
+{
+    uint64_t Result = GetRectanglePackerStateSize(Packer->Kind, Count);
+
+    switch(Packer->Kind)
+    {
+
+    case RectanglePacker::Skyline:
+    {
+        uint64_t AxisSize = Count * sizeof(uint16_t);
+
+        memcpy(Packer->SkylineX, At,            AxisSize);
+        memcpy(Packer->SkylineY, At + AxisSize, AxisSize);
+
+        Packer->SkylineCount    = static_cast<uint16_t>(Count);
+        Packer->SkylineX[Count] = UINT16_MAX;
+    } break;
+
+    case RectanglePacker::Shelf:
+    {
+        memcpy(Packer->Shelves, At, Result);
+        Packer->ShelfCount = Count;
+    } break;
+
+    case RectanglePacker::Guillotine:
+    case RectanglePacker::MaxRects:
+    {
+        memcpy(Packer->FreeRects, At, Result);
+        Packer->FreeCount = Count;
+    } break;
+
+    }
+
+    return Result;
+}
+
+
+static void
+PushFreeRectangle(free_rectangle Free, rectangle_packer *Packer)
+{
+    if(Free.Width && Free.Height)
+    {
+        if(Packer->FreeCount < Packer->FreeCapacity)
+        {
+            Packer->FreeRects[Packer->FreeCount++] = Free;
+        }
+        else
+        {
+            Packer->ReleasedArea += static_cast<uint64_t>(Free.Width) * Free.Height;
+        }
+    }
+}
+
+
+static void
+ReleasePackedRectangle(rectangle Source, rectangle_packer *Packer)
+{
+    NTEXT_ASSERT(Packer);
+
+    float Width  = Source.Right  - Source.Left;
+    float Height = Source.Bottom - Source.Top;
+
+    if(Width > 0.f && Height > 0.f)
+    {
+        free_rectangle Free =
+        {
+            .X      = static_cast<uint16_t>(Source.Left),
+            .Y      = static_cast<uint16_t>(Source.Top),
+            .Width  = static_cast<uint16_t>(Width),
+            .Height = static_cast<uint16_t>(Height),
+        };
+
+        // The released rectangle does not overlap any free one, so it can go straight back on the list.
+        bool HasFreeList = Packer->Kind == RectanglePacker::Guillotine || Packer->Kind == RectanglePacker::MaxRects;
+
+        if(HasFreeList)
+        {
+            PushFreeRectangle(Free, Packer);
+        }
+        else
+        {
+            Packer->ReleasedArea += static_cast<uint64_t>(Width * Height);
+        }
+    }
+}
+
+
+// Highest Y among the segments from Index on that start left of XMax, and the index of the first one that
+// does not. Works on eight segments at a time: the unsigned compare and max are done on values biased
+// by 0x8000, since SSE2 only has the signed ones. The sentinel at SkylineCount always ends the scan.
+
+static uint16_t
+GetSkylineMaxY(uint16_t Index, uint16_t XMax, rectangle_packer *Packer, uint16_t *IndexExclusive)
+{
+    __m128i Bias    = _mm_set1_epi16(static_cast<short>(0x8000));
+    __m128i Limit   = _mm_xor_si128(_mm_set1_epi16(static_cast<short>(XMax)), Bias);
+    __m128i Lanes   = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+    __m128i Highest = Bias;
+
+    uint32_t At = Index;
+    while(true)
+    {
+        __m128i X = _mm_xor_si128(_mm_loadu_si128((__m128i *)(Packer->SkylineX + At)), Bias);
+        __m128i Y = _mm_loadu_si128((__m128i *)(Packer->SkylineY + At));
+
+        // X is sorted up to the sentinel, so the segments under the rectangle are a prefix of the lanes.
+        uint32_t Past  = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi16(Limit, X))) ^ 0xFFFF;
+        uint32_t Under = Past ? FindFirstBit(Past) / 2 : 8;
+
+        __m128i Keep = _mm_cmplt_epi16(Lanes, _mm_set1_epi16(static_cast<short>(Under)));
+        Highest = _mm_max_epi16(Highest, _mm_xor_si128(_mm_and_si128(Y, Keep), Bias));
+
+        At += Under;
+        if(Under < 8)
+        {
+            break;
+        }
+    }
+
+    Highest = _mm_max_epi16(Highest, _mm_srli_si128(Highest, 8));
+    Highest = _mm_max_epi16(Highest, _mm_srli_si128(Highest, 4));
+    Highest = _mm_max_epi16(Highest, _mm_srli_si128(Highest, 2));
+
+    *IndexExclusive = static_cast<uint16_t>(At);
+
+    uint16_t Result = static_cast<uint16_t>(_mm_cvtsi128_si32(Highest) ^ 0x8000);
+    return Result;
+}
+
+
+static void
+PackRectangleSkyline(packed_rectangle &Rectangle, rectangle_packer *Packer)
+{
+    uint16_t Width  = Rectangle.Width;
+    uint16_t Height = Rectangle.Height;
+
+    uint16_t BestIndexInclusive = UINT16_MAX;
+    uint16_t BestIndexExclusive = UINT16_MAX;
+    point    BestPoint          = {UINT16_MAX, UINT16_MAX};
+
+    NTEXT_ASSERT(Packer->SkylineCount);
+
+    // Candidates are found eight at a time: segments where the rectangle still fits horizontally (a prefix,
+    // X is sorted), that leave enough room above and that are lower than the best spot so far.
+    // Only those get the overlap scan.
+
+    __m128i  Bias   = _mm_set1_epi16(static_cast<short>(0x8000));
+    __m128i  XLimit = _mm_xor_si128(_mm_set1_epi16(static_cast<short>(Packer->Width  - Width )), Bias);
+    __m128i  YLimit = _mm_xor_si128(_mm_set1_epi16(static_cast<short>(Packer->Height - Height)), Bias);
+    uint32_t Block  = 0;
+
+    while(Block < Packer->SkylineCount)
+    {
+        __m128i X = _mm_xor_si128(_mm_loadu_si128((__m128i *)(Packer->SkylineX + Block)), Bias);
+        __m128i Y = _mm_xor_si128(_mm_loadu_si128((__m128i *)(Packer->SkylineY + Block)), Bias);
+
+        uint32_t TooWide = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi16(X, XLimit)));
+        uint32_t TooHigh = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi16(Y, YLimit)));
+        uint32_t Fits    = (TooWide ? (1u << FindFirstBit(TooWide)) - 1 : 0xFFFF) & ~TooHigh;
+
+        while(true)
+        {
+            __m128i  BestY      = _mm_xor_si128(_mm_set1_epi16(static_cast<short>(BestPoint.Y)), Bias);
+            uint32_t Candidates = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi16(BestY, Y))) & Fits;
+
+            if(!Candidates)
+            {
+                break;
+            }
+
+            uint32_t Lane = FindFirstBit(Candidates) / 2;
+            uint16_t Idx  = static_cast<uint16_t>(Block + Lane);
+            uint16_t XIdx = Packer->SkylineX[Idx];
+
+            // Lanes up to this one are done whatever happens.
+            Fits &= ~((4u << (2 * Lane)) - 1);
+
+            // The rectangle has to rest on the highest segment it overlaps, which is what creates dead space.
+            uint16_t IndexExclusive = 0;
+            uint16_t YIdx           = GetSkylineMaxY(Idx, static_cast<uint16_t>(XIdx + Width), Packer, &IndexExclusive);
+
+            // Then it's a worse point than our current best.
+            if(YIdx >= BestPoint.Y)
+            {
+                continue;
+            }
+
+            // Not enough vertical space to store this rectangle.
+            if(Height > Packer->Height - YIdx)
+            {
+                continue;
+            }
+
+            BestIndexInclusive = Idx;
+            BestIndexExclusive = IndexExclusive;
+            BestPoint          = {XIdx, YIdx};
+        }
+
+        // The rest of the skyline is too far right for this width.
+        if(TooWide)
+        {
+            break;
+        }
+
+        Block += 8;
+    }
+
+    // Could not pack the rectangle.
+    if(BestIndexInclusive == UINT16_MAX)
+    {
+        return;
+    }
+
+    NTEXT_ASSERT(BestIndexInclusive < BestIndexExclusive);
+    NTEXT_ASSERT(BestIndexExclusive > 0);
+
+    uint16_t RemovedCount = BestIndexExclusive - BestIndexInclusive;
+    NTEXT_ASSERT(RemovedCount > 0);
+
+    // To create the top left point, we use the best point we found and raise it by the height of the rectangle.
+    // To create the bot right point, we use the right edge of the triangle we are placing and the last overlapping skyline y
+    // coordinate. This ensures that the skyline goes from left to right.
+
+    point NewTopLeft  = {BestPoint.X                               , static_cast<uint16_t>(BestPoint.Y + Height)};
+    point NewBotRight = {static_cast<uint16_t>(BestPoint.X + Width), Packer->SkylineY[BestIndexExclusive - 1]};
+
+    // To know if we are creating a new skyline from the bottom right point, we need to check multiple cases.
+    // If the first exclusive point is a valid index, then we simply check: if (smaller) new point else no.
+    // If the first exclusive point is not a valid index, then we simply check: if(not_on_boundary) new point
+
+    bool HasBottomRightPoint = BestIndexExclusive < Packer->SkylineCount ?
+        NewBotRight.X < Packer->SkylineX[BestIndexExclusive] :
+        NewBotRight.X < Packer->Width;
+
+    uint16_t InsertedCount = 1 + HasBottomRightPoint;
+    NTEXT_ASSERT(Packer->SkylineCount + InsertedCount - RemovedCount <= Packer->Width);
+
+    // Shift everything from the exclusive index on so that exactly InsertedCount slots are left for the new points.
+    // The sentinel moves with the rest.
+
+    if(InsertedCount != RemovedCount)
+    {
+        uint16_t Start = BestIndexExclusive;
+        uint16_t End   = BestIndexInclusive + InsertedCount;
+        uint16_t Moved = Packer->SkylineCount + 1 - Start;
+
+        memmove(Packer->SkylineX + End, Packer->SkylineX + Start, Moved * sizeof(uint16_t));
+        memmove(Packer->SkylineY + End, Packer->SkylineY + Start, Moved * sizeof(uint16_t));
+
+        Packer->SkylineCount = static_cast<uint16_t>(Packer->SkylineCount + InsertedCount - RemovedCount);
+    }
+
+    Packer->SkylineX[BestIndexInclusive] = NewTopLeft.X;
+    Packer->SkylineY[BestIndexInclusive] = NewTopLeft.Y;
+    if(HasBottomRightPoint)
+    {
+        Packer->SkylineX[BestIndexInclusive + 1] = NewBotRight.X;
+        Packer->SkylineY[BestIndexInclusive + 1] = NewBotRight.Y;
+    }
+
+    // The rectangle rests on the highest skyline it overlaps, which is BestPoint. The last overlapped
+    // segment (what NewBotRight carries) can be lower and would put us on top of older rectangles.
+
+    Rectangle.WasPacked = 1;
+    Rectangle.X         = BestPoint.X;
+    Rectangle.Y         = BestPoint.Y;
+}
+
+
+// Best height fit among the shelves with room left, a new shelf on top of the last one otherwise.
+
+static void
+PackRectangleShelf(packed_rectangle &Rectangle, rectangle_packer *Packer)
+{
+    uint32_t BestShelf = UINT32_MAX;
+    uint32_t BestWaste = UINT32_MAX;
+
+    for(uint32_t Idx = 0; Idx < Packer->ShelfCount; ++Idx)
+    {
+        packer_shelf &Shelf = Packer->Shelves[Idx];
+
+        if(Rectangle.Height <= Shelf.Height && Rectangle.Width <= Packer->Width - Shelf.UsedWidth)
+        {
+            uint32_t Waste = Shelf.Height - Rectangle.Height;
+            if(Waste < BestWaste)
+            {
+                BestShelf = Idx;
+                BestWaste = Waste;
+            }
+        }
+    }
+
+    if(BestShelf == UINT32_MAX)
+    {
+        packer_shelf *Last = Packer->ShelfCount ? &Packer->Shelves[Packer->ShelfCount - 1] : 0;
+        uint16_t      Top  = Last ? static_cast<uint16_t>(Last->Y + Last->Height) : 0;
+
+        if(Rectangle.Height > Packer->Height - Top || Packer->ShelfCount == GetRectanglePackerCapacity(Packer->Kind, Packer->Width, Packer->Height))
+        {
+            return;
+        }
+
+        BestShelf = Packer->ShelfCount++;
+        Packer->Shelves[BestShelf] = {Top, Rectangle.Height, 0};
+    }
+
+    packer_shelf &Shelf = Packer->Shelves[BestShelf];
+
+    Rectangle.WasPacked = 1;
+    Rectangle.X         = Shelf.UsedWidth;
+    Rectangle.Y         = Shelf.Y;
+
+    Shelf.UsedWidth = static_cast<uint16_t>(Shelf.UsedWidth + Rectangle.Width);
+}
+
+
+// Best area fit, then the leftover of the chosen rectangle is cut along its shorter side.
+
+static void
+PackRectangleGuillotine(packed_rectangle &Rectangle, rectangle_packer *Packer)
+{
+    uint32_t BestIndex = UINT32_MAX;
+    uint32_t BestArea  = UINT32_MAX;
+
+    for(uint32_t Idx = 0; Idx < Packer->FreeCount; ++Idx)
+    {
+        free_rectangle &Free = Packer->FreeRects[Idx];
+
+        if(Rectangle.Width <= Free.Width && Rectangle.Height <= Free.Height)
+        {
+            uint32_t Area = static_cast<uint32_t>(Free.Width) * Free.Height;
+            if(Area < BestArea)
+            {
+                BestIndex = Idx;
+                BestArea  = Area;
+            }
+        }
+    }
+
+    if(BestIndex == UINT32_MAX)
+    {
+        return;
+    }
+
+    free_rectangle Free = Packer->FreeRects[BestIndex];
+    Packer->FreeRects[BestIndex] = Packer->FreeRects[--Packer->FreeCount];
+
+    uint16_t LeftoverX = Free.Width  - Rectangle.Width;
+    uint16_t LeftoverY = Free.Height - Rectangle.Height;
+
+    free_rectangle Right  = {static_cast<uint16_t>(Free.X + Rectangle.Width), Free.Y, LeftoverX, Free.Height};
+    free_rectangle Bottom = {Free.X, static_cast<uint16_t>(Free.Y + Rectangle.Height), Rectangle.Width, LeftoverY};
+
+    if(LeftoverX < LeftoverY)
+    {
+        Right.Height = Rectangle.Height;
+        Bottom.Width = Free.Width;
+    }
+
+    // Bigger piece first, so a full list gives up the small one.
+    uint32_t RightArea  = static_cast<uint32_t>(Right.Width)  * Right.Height;
+    uint32_t BottomArea = static_cast<uint32_t>(Bottom.Width) * Bottom.Height;
+
+    PushFreeRectangle(RightArea >= BottomArea ? Right  : Bottom, Packer);
+    PushFreeRectangle(RightArea >= BottomArea ? Bottom : Right , Packer);
+
+    Rectangle.WasPacked = 1;
+    Rectangle.X         = Free.X;
+    Rectangle.Y         = Free.Y;
+}
+
+
+static bool
+IsFreeRectangleInside(free_rectangle Inner, free_rectangle Outer)
+{
+    bool Result = Inner.X >= Outer.X && Inner.Y >= Outer.Y &&
+                  Inner.X + Inner.Width  <= Outer.X + Outer.Width &&
+                  Inner.Y + Inner.Height <= Outer.Y + Outer.Height;
+    return Result;
+}
+
+
+// Best short side fit. Every free rectangle the placement overlaps is replaced by the (up to four) maximal
+// rectangles around it, then every rectangle that sits inside another is pruned, whichever of the two is new.
+// The old ones were already pruned against each other, so only the pairs with a new piece are checked.
+
+static void
+PackRectangleMaxRects(packed_rectangle &Rectangle, rectangle_packer *Packer)
+{
+    uint32_t BestIndex     = UINT32_MAX;
+    uint32_t BestShortSide = UINT32_MAX;
+    uint32_t BestLongSide  = UINT32_MAX;
+
+    for(uint32_t Idx = 0; Idx < Packer->FreeCount; ++Idx)
+    {
+        free_rectangle &Free = Packer->FreeRects[Idx];
+
+        if(Rectangle.Width <= Free.Width && Rectangle.Height <= Free.Height)
+        {
+            uint32_t LeftoverX = Free.Width  - Rectangle.Width;
+            uint32_t LeftoverY = Free.Height - Rectangle.Height;
+            uint32_t ShortSide = LeftoverX < LeftoverY ? LeftoverX : LeftoverY;
+            uint32_t LongSide  = LeftoverX < LeftoverY ? LeftoverY : LeftoverX;
+
+            if(ShortSide < BestShortSide || (ShortSide == BestShortSide && LongSide < BestLongSide))
+            {
+                BestIndex     = Idx;
+                BestShortSide = ShortSide;
+                BestLongSide  = LongSide;
+            }
+        }
+    }
+
+    if(BestIndex == UINT32_MAX)
+    {
+        return;
+    }
+
+    uint32_t Left   = Packer->FreeRects[BestIndex].X;
+    uint32_t Top    = Packer->FreeRects[BestIndex].Y;
+    uint32_t Right  = Left + Rectangle.Width;
+    uint32_t Bottom = Top  + Rectangle.Height;
+
+    // Pieces are appended behind the rectangles being split, which are only marked (Width = 0) and
+    // squeezed out afterwards so that the survivors stay in front of the new pieces.
+
+    uint32_t OldCount = Packer->FreeCount;
+    for(uint32_t Idx = 0; Idx < OldCount; ++Idx)
+    {
+        free_rectangle Free = Packer->FreeRects[Idx];
+
+        uint32_t FreeRight  = Free.X + Free.Width;
+        uint32_t FreeBottom = Free.Y + Free.Height;
+
+        if(Free.X >= Right || FreeRight <= Left || Free.Y >= Bottom || FreeBottom <= Top)
+        {
+            continue;
+        }
+
+        if(Free.X < Left)
+        {
+            PushFreeRectangle({Free.X, Free.Y, static_cast<uint16_t>(Left - Free.X), Free.Height}, Packer);
+        }
+
+        if(FreeRight > Right)
+        {
+            PushFreeRectangle({static_cast<uint16_t>(Right), Free.Y, static_cast<uint16_t>(FreeRight - Right), Free.Height}, Packer);
+        }
+
+        if(Free.Y < Top)
+        {
+            PushFreeRectangle({Free.X, Free.Y, Free.Width, static_cast<uint16_t>(Top - Free.Y)}, Packer);
+        }
+
+        if(FreeBottom > Bottom)
+        {
+            PushFreeRectangle({Free.X, static_cast<uint16_t>(Bottom), Free.Width, static_cast<uint16_t>(FreeBottom - Bottom)}, Packer);
+        }
+
+        Packer->FreeRects[Idx].Width = 0;
+    }
+
+    uint32_t Kept     = 0;
+    uint32_t NewStart = 0;
+    for(uint32_t Idx = 0; Idx < Packer->FreeCount; ++Idx)
+    {
+        if(Idx == OldCount)
+        {
+            NewStart = Kept;
+        }
+
+        if(Packer->FreeRects[Idx].Width)
+        {
+            Packer->FreeRects[Kept++] = Packer->FreeRects[Idx];
+        }
+    }
+
+    if(OldCount == Packer->FreeCount)
+    {
+        NewStart = Kept;
+    }
+
+    Packer->FreeCount = Kept;
+
+    // Pruned rectangles are marked the same way, so of two equal ones only the first goes.
+    for(uint32_t Idx = 0; Idx < Packer->FreeCount; ++Idx)
+    {
+        uint32_t First = Idx < NewStart ? NewStart : 0;
+
+        for(uint32_t Other = First; Other < Packer->FreeCount; ++Other)
+        {
+            if(Other != Idx && Packer->FreeRects[Other].Width && IsFreeRectangleInside(Packer->FreeRects[Idx], Packer->FreeRects[Other]))
+            {
+                Packer->FreeRects[Idx].Width = 0;
+                break;
+            }
+        }
+    }
+
+    Kept = 0;
+    for(uint32_t Idx = 0; Idx < Packer->FreeCount; ++Idx)
+    {
+        if(Packer->FreeRects[Idx].Width)
+        {
+            Packer->FreeRects[Kept++] = Packer->FreeRects[Idx];
+        }
+    }
+
+    Packer->FreeCount = Kept;
+
+    Rectangle.WasPacked = 1;
+    Rectangle.X         = static_cast<uint16_t>(Left);
+    Rectangle.Y         = static_cast<uint16_t>(Top);
+}
+
+
+static void
+PackRectangle(packed_rectangle &Rectangle, rectangle_packer *Packer)
+{
+    NTEXT_ASSERT(Packer);
+
+    if(Rectangle.Width == 0 || Rectangle.Height == 0 || Rectangle.Width > Packer->Width || Rectangle.Height > Packer->Height)
+    {
+        return;
+    }
+
+    switch(Packer->Kind)
+    {
+        case RectanglePacker::Skyline:    PackRectangleSkyline   (Rectangle, Packer); break;
+        case RectanglePacker::Shelf:      PackRectangleShelf     (Rectangle, Packer); break;
+        case RectanglePacker::Guillotine: PackRectangleGuillotine(Rectangle, Packer); break;
+        case RectanglePacker::MaxRects:   PackRectangleMaxRects  (Rectangle, Packer); break;
+    }
+}
+
+
+// Packs a whole batch tallest first, then widest, which leaves a much flatter skyline than text order.
+// Results are written back in place, so the caller's order is kept. Rectangles that are already packed
+// are skipped: a batch can be offered to several packers in turn.
+
+static void
+PackRectangles(packed_rectangle *Rectangles, uint32_t Count, rectangle_packer *Packer, memory_arena *Scratch)
+{
+    NTEXT_ASSERT(Packer);
+
+    memory_region Region = EnterMemoryRegion(Scratch);
+
+    uint32_t *Keys      = PushArray<uint32_t>(Scratch, Count);
+    uint32_t *Order     = PushArray<uint32_t>(Scratch, Count);
+    uint32_t *SwapKeys  = PushArray<uint32_t>(Scratch, Count);
+    uint32_t *SwapOrder = PushArray<uint32_t>(Scratch, Count);
+
+    if(Keys && Order && SwapKeys && SwapOrder)
+    {
+        uint32_t Pending = 0;
+        for(uint32_t Idx = 0; Idx < Count; ++Idx)
+        {
+            packed_rectangle &Rectangle = Rectangles[Idx];
+
+            if(!Rectangle.WasPacked && Rectangle.Width && Rectangle.Height)
+            {
+                // Inverted so that an ascending sort gives the largest first.
+                Keys[Pending]  = ~((static_cast<uint32_t>(Rectangle.Height) << 16) | Rectangle.Width);
+                Order[Pending] = Idx;
+                Pending       += 1;
+            }
+        }
+
+        // LSD radix sort, one byte per pass. Stable, so equal sizes keep text order.
+        for(uint32_t Shift = 0; Shift < 32; Shift += 8)
+        {
+            uint32_t Offsets[256] = {};
+
+            for(uint32_t Idx = 0; Idx < Pending; ++Idx)
+            {
+                Offsets[(Keys[Idx] >> Shift) & 0xFF] += 1;
+            }
+
+            uint32_t Total = 0;
+            for(uint32_t Digit = 0; Digit < 256; ++Digit)
+            {
+                uint32_t DigitCount = Offsets[Digit];
+                Offsets[Digit]      = Total;
+                Total              += DigitCount;
+            }
+
+            for(uint32_t Idx = 0; Idx < Pending; ++Idx)
+            {
+                uint32_t Slot = Offsets[(Keys[Idx] >> Shift) & 0xFF]++;
+
+                SwapKeys[Slot]  = Keys[Idx];
+                SwapOrder[Slot] = Order[Idx];
+            }
+
+            uint32_t *Temp = Keys;
+            Keys      = SwapKeys;
+            SwapKeys  = Temp;
+            Temp      = Order;
+            Order     = SwapOrder;
+            SwapOrder = Temp;
+        }
+
+        for(uint32_t Idx = 0; Idx < Pending; ++Idx)
+        {
+            PackRectangle(Rectangles[Order[Idx]], Packer);
+        }
+    }
+    else
+    {
+        // Out of scratch memory: text order still works, it is just worse.
+        for(uint32_t Idx = 0; Idx < Count; ++Idx)
+        {
+            if(!Rectangles[Idx].WasPacked)
+            {
+                PackRectangle(Rectangles[Idx], Packer);
+            }
+        }
+    }
+
+    LeaveMemoryRegion(Region);
+}
+
+
+// ==================================================================================
+// @Public : NText Glyph Table Implementation
+// Placeholder: glyph table types and hash utilities
+// ==================================================================================
+
+// How many metadata bytes a single probe compares: SSE2, AVX2 or AVX-512BW.
+
+enum class GlyphTableWidth : uint64_t
+{
+    None     = 0,
+    _128Bits = 16,
+    _256Bits = 32,
+    _512Bits = 64,
+};
+
+
+struct glyph_table_params
+{
+    GlyphTableWidth GroupWidth;
+    uint64_t        GroupCount;
+};
+
+
+struct glyph_hash
+{
+    alignas(16)__m128i Value;
+};
+
+
+struct glyph_tag
+{
+    uint8_t Value;
+};
+
+
+struct glyph_layout_info
+{
+    float Advance;
+    float OffsetX;
+    float OffsetY;
+};
+
+
+// A slot is split over three parallel arrays: the hashes (all a probe compares), the LRU links
+// (all a hit rewrites) and this, which is only read once the slot is known. It is 32 bytes and
+// Buckets is 32-byte aligned, so reading it never straddles two cache lines. AtlasPage is below
+// GlyphAtlasMaxPages.
+
+struct glyph_lru_link
+{
+    uint32_t PrevLRU;
+    uint32_t NextLRU;
+};
+
+
+struct glyph_entry
+{
+    uint16_t          GlyphIndex;
+    uint8_t           AtlasPage;
+    bool              IsRasterized;
+    rectangle         Source;
+    glyph_layout_info Layout;
+};
+
+
+// Count is the number of live entries. Once it reaches Capacity, inserting evicts the LRU tail.
+// Capacity stays below the slot count so probe sequences keep running into free slots.
+// DeadCount is the number of tombstones, see CleanupGlyphTable.
+// Epoch changes whenever an entry leaves or changes slot, anything caching ids compares against it.
+// Sequence is odd while the writer changes metadata, hashes or payloads (see ReadGlyphEntryByHash).
+// LRU links are only ever touched by the writer and are not covered.
+//
+// While growing, Previous is the smaller table being drained into this one. Everything it
+// still holds is older than anything in this table.
+//
+// Pins is only set while a run is being filled (see PinGlyphTable), one bit per slot.
+
+struct glyph_table
+{
+    uint8_t        *Metadata;
+    glyph_hash     *Hashes;
+    glyph_lru_link *Links;
+    glyph_entry    *Buckets;
+
+    uint64_t     GroupWidth;
+    uint64_t     GroupCount;
+    uint64_t     HashMask;
+
+    uint32_t     SentinelIndex;
+    uint32_t     Count;
+    uint32_t     Capacity;
+    uint32_t     DeadCount;
+    uint32_t     Epoch;
+
+    volatile uint32_t Sequence;
+
+    glyph_table *Previous;
+    uint64_t    *Pins;
+};
+
+
+// EvictedId is GlyphTableInvalidEntry unless making room for this entry evicted another one
+// (while growing, it can be a slot of the previous table). EvictedSource and EvictedAtlasPage are where
+// that one lived in the atlas.
+
+struct glyph_state
+{
+    uint32_t          Id;
+    uint16_t          GlyphIndex;
+    uint16_t          AtlasPage;
+    glyph_layout_info Layout;
+    rectangle         Source;
+    bool              IsRasterized;
+
+    uint32_t          EvictedId;
+    uint16_t          EvictedAtlasPage;
+    rectangle         EvictedSource;
+};
+
+
+constexpr uint32_t GlyphTableInvalidEntry = 0xFFFFFFFFu;
+constexpr uint8_t  GlyphTableEmptyMask    = 1 << 6; 
+constexpr uint8_t  GlyphTableDeadMask     = 1 << 7;
+constexpr uint8_t  GlyphTableTagMask      = 0xFF & ~0x03;
+
+
+static bool
+IsValidGlyphTable(glyph_table *Table)
+{
+    bool Result = Table && Table->Metadata && Table->Hashes && Table->Links && Table->Buckets;
+    return Result;
+}
+
+
+static glyph_entry *
+GetGlyphEntry(uint64_t Index, glyph_table *Table)
+{
+    NTEXT_ASSERT(Table);
+    NTEXT_ASSERT(Index < (Table->GroupCount * Table->GroupWidth));
+
+    glyph_entry *Result = Table->Buckets + Index;
+    return Result;
+}
+
+static glyph_lru_link *
+GetGlyphLink(uint64_t Index, glyph_table *Table)
+{
+    NTEXT_ASSERT(Table);
+    NTEXT_ASSERT(Index <= (Table->GroupCount * Table->GroupWidth)); // Could be sentinel.
+
+    glyph_lru_link *Result = Table->Links + Index;
+    return Result;
+}
+
+static glyph_lru_link *
+GetGlyphTableSentinel(glyph_table *Table)
+{
+    NTEXT_ASSERT(Table->SentinelIndex == Table->GroupCount * Table->GroupWidth);
+
+    glyph_lru_link *Result = Table->Links + Table->SentinelIndex;
+    return Result;
+}
+
+
+static uint32_t
+GetGlyphGroupIndexFromHash(glyph_hash Hash, glyph_table *Table)
+{
+    uint64_t Low64  = _mm_cvtsi128_si64(Hash.Value);
+    uint32_t Result = (uint32_t)(Low64 & Table->HashMask);
+
+    return Result;
+}
+
+
+#if NTEXT_AES_HASH
+static char unsigned OverhangMask[32] =
+{
+    255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
+    0, 0, 0, 0,  0, 0, 0, 0,  0, 0, 0, 0,  0, 0, 0, 0
+};
+#endif
+
+
+static char unsigned DefaultSeed[16] =
+{
+    178, 201, 95, 240, 40, 41, 143, 216,
+    2, 209, 178, 114, 232, 4, 176, 188
+};
+
+
+// Identifies what ComputeGlyphHash produces. Anything persisting hashes (SaveGlyphCache) records it,
+// so change it along with the hash.
+
+#if NTEXT_AES_HASH
+constexpr uint32_t GlyphHashKind = 1; // AES, DefaultSeed
+#else
+constexpr uint32_t GlyphHashKind = 2; // Portable, DefaultSeed
+#endif
+
+
+// Bijective 64-bit finalizer (the MurmurHash3 one).
+
+static inline uint64_t
+MixGlyphHash64(uint64_t Value)
+{
+    Value ^= Value >> 33;
+    Value *= 0xFF51AFD7ED558CCDull;
+    Value ^= Value >> 33;
+    Value *= 0xC4CEB9FE1A85EC53ull;
+    Value ^= Value >> 33;
+
+    return Value;
+}
+
+
+// Scalar fallback for builds without AES-NI. Both halves see every input, the table
+// takes the group and the tag from the low one and compares all 128 bits.
+
+static glyph_hash
+ComputeGlyphHashPortable(size_t Count, uint32_t *Codepoints, uint64_t Key, char unsigned *Seedx16)
+{
+    NTEXT_ASSERT(Count);
+    NTEXT_ASSERT(Codepoints);
+    NTEXT_ASSERT(Seedx16);
+
+    uint64_t Seed[2];
+    memcpy(Seed, Seedx16, sizeof(Seed));
+
+    uint64_t Low  = Seed[0] ^ static_cast<uint64_t>(Count);
+    uint64_t High = Seed[1] ^ Key;
+
+    for(size_t Idx = 0; Idx < Count; ++Idx)
+    {
+        Low  = MixGlyphHash64(Low ^ Codepoints[Idx]) + High;
+        High = MixGlyphHash64(High ^ Codepoints[Idx] ^ ((Low << 29) | (Low >> 35)));
+    }
+
+    Low  = MixGlyphHash64(Low ^ High);
+    High = MixGlyphHash64(High + Low);
+
+    glyph_hash Result = {.Value = _mm_set_epi64x(static_cast<int64_t>(High), static_cast<int64_t>(Low))};
+    return Result;
+}
+
+
+// No clue how good (bad) this is bad. Trying something.
+// Key is whatever else identifies the glyph besides its codepoints (see MakeGlyphKey).
+
+static glyph_hash
+ComputeGlyphHash(size_t Count, uint32_t *Codepoints, uint64_t Key, char unsigned *Seedx16)
+{
+#if !NTEXT_AES_HASH
+    return ComputeGlyphHashPortable(Count, Codepoints, Key, Seedx16);
+#else
+    NTEXT_ASSERT(Count);
+    NTEXT_ASSERT(Codepoints);
+    NTEXT_ASSERT(Seedx16);
+
+    glyph_hash Result = {0};
+
+    __m128i HashValue = _mm_set_epi64x(Key, static_cast<uint64_t>(Count));
+    HashValue = _mm_xor_si128(HashValue, _mm_loadu_si128((__m128i *)Seedx16));
+
+    size_t ChunkCount = Count / 4;
+    while(ChunkCount--)
+    {
+        __m128i In = _mm_loadu_si128((__m128i *)Codepoints);
+        Codepoints += 4;
+
+        HashValue = _mm_xor_si128(HashValue, In);
+        HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+        HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+        HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+        HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+    }
+
+    // Whatever did not fill a whole chunk, in bytes.
+    size_t Overhang = (Count % 4) * sizeof(uint32_t);
+
+    // Think there is a fix for that on the refterm issues tab.
+
+#if 0
+    __m128i In = _mm_loadu_si128((__m128i *)At);
+#else
+    char Temp[16];
+    memcpy(Temp, Codepoints, Overhang);
+    __m128i In = _mm_loadu_si128((__m128i *)Temp);
+#endif
+    In = _mm_and_si128(In, _mm_loadu_si128((__m128i *)(OverhangMask + 16 - Overhang)));
+
+    HashValue = _mm_xor_si128(HashValue, In);
+    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+
+    Result.Value = HashValue;
+
+    return Result;
+#endif
+}
+
+
+// What every lookup of a single codepoint uses. Same value as ComputeGlyphHash(1, ...), without the
+// chunk loop and the overhang copy: the codepoint goes straight into the first lane.
+
+static inline glyph_hash
+ComputeSingleGlyphHash(uint32_t Codepoint, uint64_t Key, char unsigned *Seedx16)
+{
+#if !NTEXT_AES_HASH
+    return ComputeGlyphHashPortable(1, &Codepoint, Key, Seedx16);
+#else
+    __m128i HashValue = _mm_set_epi64x(static_cast<int64_t>(Key), 1);
+    HashValue = _mm_xor_si128(HashValue, _mm_loadu_si128((__m128i *)Seedx16));
+    HashValue = _mm_xor_si128(HashValue, _mm_cvtsi32_si128(static_cast<int>(Codepoint)));
+
+    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+    HashValue = _mm_aesdec_si128(HashValue, _mm_setzero_si128());
+
+    glyph_hash Result = {.Value = HashValue};
+    return Result;
+#endif
+}
+
+
+// The group index comes from the low bits, so the tag has to come from the top ones.
+// Otherwise every entry of a group would share the same tag.
+
+static glyph_tag
+GetGlyphTagFromHash(glyph_hash Hash)
+{
+    uint64_t  Low64  = _mm_cvtsi128_si64(Hash.Value);
+    glyph_tag Result = {.Value = (uint8_t)(Low64 >> 58)};
+
+    return Result;
+}
+
+
+static bool
+IsGlyphTableWidthSupported(GlyphTableWidth Width)
+{
+    bool Result = (Width == GlyphTableWidth::_128Bits);
+
+#if NTEXT_MSVC
+    int Info[4] = {};
+    __cpuidex(Info, 7, 0);
+
+    // The OS also has to save the wide registers: YMM for AVX2, plus opmask and ZMM for AVX-512.
+    bool     HasOSXSave = false;
+    uint64_t XCR0       = 0;
+    {
+        int Leaf1[4] = {};
+        __cpuid(Leaf1, 1);
+
+        HasOSXSave = (Leaf1[2] & (1 << 27)) != 0;
+        XCR0       = HasOSXSave ? _xgetbv(0) : 0;
+    }
+
+    if(Width == GlyphTableWidth::_256Bits)
+    {
+        Result = (Info[1] & (1 << 5)) && ((XCR0 & 0x06) == 0x06);
+    } else
+    if(Width == GlyphTableWidth::_512Bits)
+    {
+        Result = (Info[1] & (1 << 16)) && (Info[1] & (1 << 30)) && ((XCR0 & 0xE6) == 0xE6);
+    }
+#else
+    if(Width == GlyphTableWidth::_256Bits)
+    {
+        Result = __builtin_cpu_supports("avx2");
+    } else
+    if(Width == GlyphTableWidth::_512Bits)
+    {
+        Result = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    }
+#endif
+
+    return Result;
+}
+
+
+static bool
+GlyphHashesAreEqual(glyph_hash A, glyph_hash B)
+{
+    __m128i Compare = _mm_cmpeq_epi8(A.Value, B.Value);
+    int     Mask    = _mm_movemask_epi8(Compare);
+
+    return (Mask == 0xFFFF);
+}
+
+// I need to understand alignment. 
+// It's simple, but I make the same mistake everywhere in the code 
+// which might cause a bunch of other issues. Need to focus on that.
+// Why is it that the refterm code does not handle that? Or does it when allocating?
+
+
+static uint64_t
+GetGlyphTableFootprint(glyph_table_params Params)
+{
+    uint64_t SlotCount = Params.GroupCount * static_cast<uint32_t>(Params.GroupWidth);
+    uint64_t MetadataSize = SlotCount * sizeof(uint8_t);
+    uint64_t HashesSize = SlotCount * sizeof(glyph_hash);
+    uint64_t LinksSize = (SlotCount + 1) * sizeof(glyph_lru_link); // Accounts for sentinel.
+    uint64_t BucketsSize = SlotCount * sizeof(glyph_entry);
+    uint64_t TableSize = sizeof(glyph_table);
+
+    // Account for alignment padding (16 bytes per section, 32 for the buckets)
+    uint64_t Result = MetadataSize + 15  // Metadata
+        + HashesSize + 15    // Hashes
+        + LinksSize + 15     // Links
+        + BucketsSize + 31   // Buckets
+        + TableSize + 15;    // Table
+    return Result;
+}
+
+static glyph_table *
+PlaceGlyphTableInMemory(glyph_table_params Params, void *Memory)
+{
+    glyph_table *Result = 0;
+    if (Memory)
+    {
+        uint64_t SlotCount = Params.GroupCount * static_cast<uint32_t>(Params.GroupWidth);
+
+        uintptr_t MetadataAddr = reinterpret_cast<uintptr_t>(Memory);
+        MetadataAddr = (MetadataAddr + 15) & ~15ULL;
+        uint8_t *Metadata = reinterpret_cast<uint8_t *>(MetadataAddr);
+
+        uintptr_t HashesAddr = MetadataAddr + (SlotCount * sizeof(uint8_t));
+        HashesAddr = (HashesAddr + 15) & ~15ULL;
+        glyph_hash *Hashes = reinterpret_cast<glyph_hash *>(HashesAddr);
+
+        uintptr_t LinksAddr = HashesAddr + (SlotCount * sizeof(glyph_hash));
+        LinksAddr = (LinksAddr + 15) & ~15ULL;
+        glyph_lru_link *Links = reinterpret_cast<glyph_lru_link *>(LinksAddr);
+
+        uintptr_t BucketsAddr = LinksAddr + ((SlotCount + 1) * sizeof(glyph_lru_link));
+        BucketsAddr = (BucketsAddr + 31) & ~31ULL;
+        glyph_entry *Buckets = reinterpret_cast<glyph_entry *>(BucketsAddr);
+
+        uintptr_t ResultAddr = BucketsAddr + (SlotCount * sizeof(glyph_entry));
+        ResultAddr = (ResultAddr + 15) & ~15ULL;
+        Result = reinterpret_cast<glyph_table *>(ResultAddr);
+
+        Result->Metadata = Metadata;
+        Result->Hashes = Hashes;
+        Result->Links = Links;
+        Result->Buckets = Buckets;
+        Result->GroupWidth = static_cast<uint64_t>(Params.GroupWidth);
+        Result->GroupCount = Params.GroupCount;
+        Result->HashMask = Params.GroupCount - 1;
+        Result->SentinelIndex = SlotCount;
+        Result->Count = 0;
+        Result->Capacity = SlotCount - (SlotCount / 8);
+        Result->DeadCount = 0;
+        Result->Epoch = 0;
+        Result->Sequence = 0;
+        Result->Previous = 0;
+        Result->Pins = 0;
+
+        for (uint32_t Idx = 0; Idx < SlotCount; ++Idx)
+        {
+            glyph_entry *Entry = GetGlyphEntry(Idx, Result);
+            Entry->GlyphIndex = 0;
+            Entry->AtlasPage = 0;
+            Entry->Source = {};
+            Entry->Layout = {};
+            Entry->IsRasterized = false;
+
+            // Never read while the slot is not linked, but snapshots check every link.
+            Result->Links[Idx].PrevLRU = Result->SentinelIndex;
+            Result->Links[Idx].NextLRU = Result->SentinelIndex;
+        }
+
+        for (uint32_t Idx = 0; Idx < SlotCount; ++Idx)
+        {
+            Result->Metadata[Idx] = GlyphTableEmptyMask;
+        }
+
+        glyph_lru_link *Sentinel = GetGlyphTableSentinel(Result);
+        NTEXT_ASSERT(Sentinel);
+        Sentinel->PrevLRU = Result->SentinelIndex;
+        Sentinel->NextLRU = Result->SentinelIndex;
+    }
+    return Result;
+}
+
+
+// Entries moved from the previous table per lookup while growing. One group worth, so a
+// table is drained long before the larger one could fill up.
+
+constexpr uint32_t GlyphTableMigrationStep = 16;
+
+
+// GroupCount is how many groups the probe looked at, only benchmarks read it.
+
+struct glyph_probe
+{
+    uint32_t EntryIndex;
+    uint32_t FreeIndex;
+    uint32_t GroupCount;
+};
+
+
+static void
+UnlinkGlyphEntry(uint32_t Index, glyph_table *Table)
+{
+    glyph_lru_link *Entry = GetGlyphLink(Index, Table);
+    glyph_lru_link *Prev  = GetGlyphLink(Entry->PrevLRU, Table);
+    glyph_lru_link *Next  = GetGlyphLink(Entry->NextLRU, Table);
+
+    NTEXT_ASSERT(Prev);
+    NTEXT_ASSERT(Next);
+
+    Prev->NextLRU = Entry->NextLRU;
+    Next->PrevLRU = Entry->PrevLRU;
+}
+
+
+static void
+LinkGlyphEntryAtHead(uint32_t Index, glyph_table *Table)
+{
+    glyph_lru_link *Sentinel = GetGlyphTableSentinel(Table);
+    glyph_lru_link *Entry    = GetGlyphLink(Index, Table);
+    glyph_lru_link *Head     = GetGlyphLink(Sentinel->NextLRU, Table);
+
+    Entry->NextLRU    = Sentinel->NextLRU;
+    Entry->PrevLRU    = Table->SentinelIndex;
+    Head->PrevLRU     = Index;
+    Sentinel->NextLRU = Index;
+
+    if(Table->Pins)
+    {
+        Table->Pins[Index / 64] |= (1ull << (Index % 64));
+    }
+}
+
+
+static void
+LinkGlyphEntryAtTail(uint32_t Index, glyph_table *Table)
+{
+    glyph_lru_link *Sentinel = GetGlyphTableSentinel(Table);
+    glyph_lru_link *Entry    = GetGlyphLink(Index, Table);
+    glyph_lru_link *Tail     = GetGlyphLink(Sentinel->PrevLRU, Table);
+
+    Entry->PrevLRU    = Sentinel->PrevLRU;
+    Entry->NextLRU    = Table->SentinelIndex;
+    Tail->NextLRU     = Index;
+    Sentinel->PrevLRU = Index;
+}
+
+
+// Moves a live entry to the head, for lookups that found it without probing.
+
+static void
+TouchGlyphEntry(uint32_t Index, glyph_table *Table)
+{
+    UnlinkGlyphEntry(Index, Table);
+    LinkGlyphEntryAtHead(Index, Table);
+}
+
+
+// While pinned, every entry linked at the head is marked, so the entries a run uses are exactly the
+// front of the LRU up to the first unmarked one. Eviction takes the tail: once that one is marked,
+// everything is in use by the run and the insertion fails instead (see FindGlyphEntryByHash).
+// Unpin before the ids of the run are let go. Nothing changes when Arena cannot hold the bits.
+
+static void
+PinGlyphTable(glyph_table *Table, memory_arena *Arena)
+{
+    uint64_t  SlotCount = Table->GroupCount * Table->GroupWidth;
+    uint64_t  WordCount = (SlotCount + 63) / 64;
+    uint64_t *Pins      = PushArray<uint64_t>(Arena, WordCount);
+
+    if(Pins)
+    {
+        memset(Pins, 0, WordCount * sizeof(uint64_t));
+        Table->Pins = Pins;
+    }
+}
+
+
+static void
+UnpinGlyphTable(glyph_table *Table)
+{
+    Table->Pins = 0;
+}
+
+
+static bool
+IsGlyphEntryPinned(uint32_t Index, glyph_table *Table)
+{
+    bool Result = Table->Pins && (Table->Pins[Index / 64] & (1ull << (Index % 64)));
+    return Result;
+}
+
+
+// Unlinks a live entry and leaves a tombstone so the probe sequences going through it stay intact.
+
+static void
+TombstoneGlyphEntry(uint32_t Index, glyph_table *Table)
+{
+    UnlinkGlyphEntry(Index, Table);
+
+    Table->Metadata[Index] = GlyphTableDeadMask;
+    Table->Count          -= 1;
+    Table->DeadCount      += 1;
+    Table->Epoch          += 1;
+}
+
+
+// Brackets every change readers could observe. Writes never nest.
+
+static void
+BeginGlyphTableWrite(glyph_table *Table)
+{
+    NTEXT_ASSERT((Table->Sequence & 1) == 0);
+
+    AtomicStoreRelease32(&Table->Sequence, Table->Sequence + 1);
+    AtomicFenceRelease();
+}
+
+
+static void
+EndGlyphTableWrite(glyph_table *Table)
+{
+    AtomicStoreRelease32(&Table->Sequence, Table->Sequence + 1);
+}
+
+
+// Marks a free slot (empty or dead) as live and stores its hash. The entry itself is left to the caller.
+
+static glyph_entry *
+ClaimGlyphSlot(uint32_t Index, glyph_hash Hash, glyph_table *Table)
+{
+    NTEXT_ASSERT(Index != GlyphTableInvalidEntry);
+
+    if(Table->Metadata[Index] == GlyphTableDeadMask)
+    {
+        Table->DeadCount -= 1;
+    }
+
+    // Since the tag is 00XX XXXX, we clear the state bits.
+    Table->Metadata[Index] = GetGlyphTagFromHash(Hash).Value;
+    Table->Hashes[Index]   = Hash;
+    Table->Count          += 1;
+
+    glyph_entry *Result = GetGlyphEntry(Index, Table);
+    return Result;
+}
+
+
+// One bit per slot of the group for each state we care about.
+
+struct glyph_group_match
+{
+    uint64_t Tags;
+    uint64_t Empty;
+    uint64_t Dead;
+};
+
+
+static glyph_group_match
+MatchGlyphGroup128(uint8_t *Meta, uint8_t Tag)
+{
+    __m128i MetaVector = _mm_loadu_si128((__m128i *)Meta);
+
+    glyph_group_match Result =
+    {
+        .Tags  = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(MetaVector, _mm_set1_epi8(static_cast<char>(Tag))))),
+        .Empty = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(MetaVector, _mm_set1_epi8(GlyphTableEmptyMask)))),
+        .Dead  = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(MetaVector, _mm_set1_epi8(static_cast<char>(GlyphTableDeadMask))))),
+    };
+
+    return Result;
+}
+
+
+NTEXT_TARGET("avx2") static glyph_group_match
+MatchGlyphGroup256(uint8_t *Meta, uint8_t Tag)
+{
+    __m256i MetaVector = _mm256_loadu_si256((__m256i *)Meta);
+
+    glyph_group_match Result =
+    {
+        .Tags  = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(MetaVector, _mm256_set1_epi8(static_cast<char>(Tag))))),
+        .Empty = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(MetaVector, _mm256_set1_epi8(GlyphTableEmptyMask)))),
+        .Dead  = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(MetaVector, _mm256_set1_epi8(static_cast<char>(GlyphTableDeadMask))))),
+    };
+
+    return Result;
+}
+
+
+NTEXT_TARGET("avx512f,avx512bw") static glyph_group_match
+MatchGlyphGroup512(uint8_t *Meta, uint8_t Tag)
+{
+    __m512i MetaVector = _mm512_loadu_si512(Meta);
+
+    glyph_group_match Result =
+    {
+        .Tags  = _mm512_cmpeq_epi8_mask(MetaVector, _mm512_set1_epi8(static_cast<char>(Tag))),
+        .Empty = _mm512_cmpeq_epi8_mask(MetaVector, _mm512_set1_epi8(GlyphTableEmptyMask)),
+        .Dead  = _mm512_cmpeq_epi8_mask(MetaVector, _mm512_set1_epi8(static_cast<char>(GlyphTableDeadMask))),
+    };
+
+    return Result;
+}
+
+
+static glyph_group_match
+MatchGlyphGroup(uint8_t *Meta, uint8_t Tag, uint64_t GroupWidth)
+{
+    glyph_group_match Result;
+
+    switch(static_cast<GlyphTableWidth>(GroupWidth))
+    {
+
+    case GlyphTableWidth::_512Bits: Result = MatchGlyphGroup512(Meta, Tag); break;
+    case GlyphTableWidth::_256Bits: Result = MatchGlyphGroup256(Meta, Tag); break;
+    default:                        Result = MatchGlyphGroup128(Meta, Tag); break;
+
+    }
+
+    return Result;
+}
+
+
+// Probing is triangular (+1, +2, +3, ... groups), which visits every group exactly once when the
+// group count is a power of two. A probe therefore ends after GroupCount groups at worst, even
+// when tombstones have eaten every empty slot. FreeIndex is the first dead or empty slot of the sequence.
+
+static glyph_probe
+ProbeGlyphTable(glyph_hash Hash, glyph_table *Table)
+{
+    NTEXT_ASSERT(Table);
+
+    glyph_probe Result = {GlyphTableInvalidEntry, GlyphTableInvalidEntry, 0};
+
+    glyph_tag Tag        = GetGlyphTagFromHash(Hash);
+    uint32_t  GroupIndex = GetGlyphGroupIndexFromHash(Hash, Table);
+
+    NTEXT_ASSERT(GroupIndex < Table->GroupCount);
+
+    for(uint32_t ProbeCount = 0; ProbeCount < Table->GroupCount; ++ProbeCount)
+    {
+        uint8_t          *Meta  = Table->Metadata + (GroupIndex * Table->GroupWidth);
+        glyph_group_match Match = MatchGlyphGroup(Meta, Tag.Value, Table->GroupWidth);
+
+        Result.GroupCount = ProbeCount + 1;
+
+        // Uses a 6 bit tags to search a matching tag through the meta-data vector.
+        // If found compare hashes and return if they match.
+
+        uint64_t TagMask = Match.Tags;
+        while(TagMask)
+        {
+            uint32_t EntryIndex = FindFirstBit64(TagMask) + (GroupIndex * Table->GroupWidth);
+
+            if(GlyphHashesAreEqual(Hash, Table->Hashes[EntryIndex]))
+            {
+                Result.EntryIndex = EntryIndex;
+                return Result;
+            }
+
+            TagMask &= TagMask - 1;
+        }
+
+        if(Result.FreeIndex == GlyphTableInvalidEntry && Match.Dead)
+        {
+            Result.FreeIndex = FindFirstBit64(Match.Dead) + (GroupIndex * Table->GroupWidth);
+        }
+
+        // An empty slot ends every probe sequence that could have reached the hash.
+        if(Match.Empty)
+        {
+            if(Result.FreeIndex == GlyphTableInvalidEntry)
+            {
+                Result.FreeIndex = FindFirstBit64(Match.Empty) + (GroupIndex * Table->GroupWidth);
+            }
+            break;
+        }
+
+        GroupIndex = (GroupIndex + ProbeCount + 1) & Table->HashMask;
+    }
+
+    return Result;
+}
+
+
+// Moves the most recent entries of the previous table to the tail of this one, which keeps
+// the combined LRU order intact. The previous table is dropped once it is empty.
+
+static void
+MigrateGlyphEntries(glyph_table *Table, uint32_t Budget)
+{
+    glyph_table *Previous = Table->Previous;
+    NTEXT_ASSERT(Previous);
+
+    glyph_lru_link *PreviousSentinel = GetGlyphTableSentinel(Previous);
+
+    BeginGlyphTableWrite(Table);
+    BeginGlyphTableWrite(Previous);
+
+    while(Budget-- && Previous->Count)
+    {
+        uint32_t    OldIndex = PreviousSentinel->NextLRU;
+        glyph_hash  OldHash  = Previous->Hashes[OldIndex];
+        glyph_probe Probe    = ProbeGlyphTable(OldHash, Table);
+
+        NTEXT_ASSERT(Probe.EntryIndex == GlyphTableInvalidEntry);
+        NTEXT_ASSERT(Probe.FreeIndex  != GlyphTableInvalidEntry && Table->Count < Table->Capacity);
+
+        *ClaimGlyphSlot(Probe.FreeIndex, OldHash, Table) = *GetGlyphEntry(OldIndex, Previous);
+
+        LinkGlyphEntryAtTail(Probe.FreeIndex, Table);
+        TombstoneGlyphEntry(OldIndex, Previous);
+    }
+
+    EndGlyphTableWrite(Previous);
+    EndGlyphTableWrite(Table);
+
+    if(!Previous->Count)
+    {
+        Table->Previous = 0;
+    }
+}
+
+
+// Looks the hash up and moves it to the front of the LRU, inserting it if missing. While growing,
+// the previous table is checked too and a hit there is moved over right away. When the table is
+// full and pinned up to its tail, nothing is inserted and Id is GlyphTableInvalidEntry.
+
+static glyph_state
+FindGlyphEntryByHash(glyph_hash Hash, glyph_table *Table)
+{
+    NTEXT_ASSERT(Table);
+
+    if(Table->Previous)
+    {
+        MigrateGlyphEntries(Table, GlyphTableMigrationStep);
+    }
+
+    glyph_probe  Probe      = ProbeGlyphTable(Hash, Table);
+    uint32_t     EntryIndex = Probe.EntryIndex;
+    glyph_entry *Result     = 0;
+
+    uint32_t  EvictedId        = GlyphTableInvalidEntry;
+    uint16_t  EvictedAtlasPage = 0;
+    rectangle EvictedSource    = {};
+
+    if(EntryIndex != GlyphTableInvalidEntry)
+    {
+        // An existing entry was found, we simply pop it from the chain.
+
+        Result = GetGlyphEntry(EntryIndex, Table);
+        UnlinkGlyphEntry(EntryIndex, Table);
+    }
+    else
+    {
+        glyph_entry  Moved    = {};
+        bool         WasMoved = false;
+        glyph_table *Previous = Table->Previous;
+
+        // The previous table is never pinned, a hit there moves into this one.
+        bool IsFull = Table->Count >= Table->Capacity && !(Previous && Previous->Count);
+        if(IsFull && IsGlyphEntryPinned(GetGlyphTableSentinel(Table)->PrevLRU, Table))
+        {
+            glyph_state Failed = {.Id = GlyphTableInvalidEntry, .EvictedId = GlyphTableInvalidEntry};
+            return Failed;
+        }
+
+        BeginGlyphTableWrite(Table);
+
+        if(Previous)
+        {
+            glyph_probe OldProbe = ProbeGlyphTable(Hash, Previous);
+            if(OldProbe.EntryIndex != GlyphTableInvalidEntry)
+            {
+                Moved    = *GetGlyphEntry(OldProbe.EntryIndex, Previous);
+                WasMoved = true;
+
+                BeginGlyphTableWrite(Previous);
+                TombstoneGlyphEntry(OldProbe.EntryIndex, Previous);
+                EndGlyphTableWrite(Previous);
+            }
+        }
+
+        // Full: the least recently used entry goes, and that is in the previous table if it still holds any.
+
+        if(Table->Count >= Table->Capacity)
+        {
+            glyph_table *Victims = (Previous && Previous->Count) ? Previous : Table;
+
+            EvictedId = GetGlyphTableSentinel(Victims)->PrevLRU;
+            NTEXT_ASSERT(EvictedId != Victims->SentinelIndex);
+
+            EvictedSource    = GetGlyphEntry(EvictedId, Victims)->Source;
+            EvictedAtlasPage = GetGlyphEntry(EvictedId, Victims)->AtlasPage;
+
+            if(Victims != Table)
+            {
+                BeginGlyphTableWrite(Victims);
+            }
+
+            TombstoneGlyphEntry(EvictedId, Victims);
+
+            if(Victims != Table)
+            {
+                EndGlyphTableWrite(Victims);
+            }
+        }
+
+        EntryIndex = Probe.FreeIndex;
+        Result     = ClaimGlyphSlot(EntryIndex, Hash, Table);
+
+        if(WasMoved)
+        {
+            *Result = Moved;
+        }
+        else
+        {
+            Result->GlyphIndex   = 0;
+            Result->AtlasPage    = 0;
+            Result->Source       = {};
+            Result->Layout       = {};
+            Result->IsRasterized = false;
+        }
+
+        EndGlyphTableWrite(Table);
+
+        if(Previous && !Previous->Count)
+        {
+            Table->Previous = 0;
+        }
+    }
+
+    NTEXT_ASSERT(EntryIndex != Table->SentinelIndex);
+
+    LinkGlyphEntryAtHead(EntryIndex, Table);
+
+    glyph_state State =
+    {
+        .Id               = EntryIndex,
+        .GlyphIndex       = Result->GlyphIndex,
+        .AtlasPage        = Result->AtlasPage,
+        .Layout           = Result->Layout,
+        .Source           = Result->Source,
+        .IsRasterized     = Result->IsRasterized,
+        .EvictedId        = EvictedId,
+        .EvictedAtlasPage = EvictedAtlasPage,
+        .EvictedSource    = EvictedSource,
+    };
+
+    return State;
+}
+
+
+// How far ahead of the lookup the batch touches memory. Metadata is fetched two windows ahead,
+// the buckets its tags point at one window ahead, so both are (hopefully) cached when we get there.
+
+constexpr uint32_t GlyphLookupWindow = 8;
+
+
+static void
+PrefetchGlyphGroup(glyph_hash Hash, glyph_table *Table)
+{
+    uint32_t GroupIndex = GetGlyphGroupIndexFromHash(Hash, Table);
+    uint8_t *Meta       = Table->Metadata + (GroupIndex * Table->GroupWidth);
+
+    _mm_prefetch(reinterpret_cast<const char *>(Meta), _MM_HINT_T0);
+}
+
+
+static void
+PrefetchGlyphBuckets(glyph_hash Hash, glyph_table *Table)
+{
+    uint32_t GroupIndex = GetGlyphGroupIndexFromHash(Hash, Table);
+    uint8_t *Meta       = Table->Metadata + (GroupIndex * Table->GroupWidth);
+
+    glyph_group_match Match   = MatchGlyphGroup(Meta, GetGlyphTagFromHash(Hash).Value, Table->GroupWidth);
+    uint64_t          TagMask = Match.Tags;
+
+    // Only the hash is compared, the payload waits until the slot is known.
+    while(TagMask)
+    {
+        uint32_t EntryIndex = FindFirstBit64(TagMask) + (GroupIndex * Table->GroupWidth);
+        _mm_prefetch(reinterpret_cast<const char *>(Table->Hashes + EntryIndex), _MM_HINT_T0);
+
+        TagMask &= TagMask - 1;
+    }
+}
+
+
+// Same as calling FindGlyphEntryByHash on every hash in order (insertions and evictions included),
+// but the memory of the next lookups is requested while the current one resolves. Only the
+// first group of each probe sequence is prefetched, the rest is rare enough.
+
+static void
+FindGlyphEntriesByHashBatch(glyph_hash *Hashes, uint32_t Count, glyph_state *States, glyph_table *Table)
+{
+    NTEXT_ASSERT(Table);
+    NTEXT_ASSERT(Count == 0 || (Hashes && States));
+
+    uint32_t Warmup = Count < 2 * GlyphLookupWindow ? Count : 2 * GlyphLookupWindow;
+
+    for(uint32_t Idx = 0; Idx < Warmup; ++Idx)
+    {
+        PrefetchGlyphGroup(Hashes[Idx], Table);
+    }
+
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        if(Idx + 2 * GlyphLookupWindow < Count)
+        {
+            PrefetchGlyphGroup(Hashes[Idx + 2 * GlyphLookupWindow], Table);
+        }
+
+        if(Idx + GlyphLookupWindow < Count)
+        {
+            PrefetchGlyphBuckets(Hashes[Idx + GlyphLookupWindow], Table);
+        }
+
+        States[Idx] = FindGlyphEntryByHash(Hashes[Idx], Table);
+    }
+}
+
+
+// Removes the entry for Hash from the table, or from the one it is growing out of. The returned
+// state describes what was removed so the caller can free its atlas space, Id is GlyphTableInvalidEntry
+// when there was nothing to remove.
+
+static glyph_state
+RemoveGlyphEntry(glyph_hash Hash, glyph_table *Table)
+{
+    glyph_state Result = {.Id = GlyphTableInvalidEntry, .EvictedId = GlyphTableInvalidEntry};
+
+    for(glyph_table *Search = Table; Search; Search = Search->Previous)
+    {
+        glyph_probe Probe = ProbeGlyphTable(Hash, Search);
+
+        if(Probe.EntryIndex != GlyphTableInvalidEntry)
+        {
+            glyph_entry *Entry = GetGlyphEntry(Probe.EntryIndex, Search);
+
+            Result.Id           = Probe.EntryIndex;
+            Result.GlyphIndex   = Entry->GlyphIndex;
+            Result.AtlasPage    = Entry->AtlasPage;
+            Result.Layout       = Entry->Layout;
+            Result.Source       = Entry->Source;
+            Result.IsRasterized = Entry->IsRasterized;
+
+            BeginGlyphTableWrite(Search);
+            TombstoneGlyphEntry(Probe.EntryIndex, Search);
+            EndGlyphTableWrite(Search);
+            break;
+        }
+    }
+
+    return Result;
+}
+
+
+// Past this many tombstones, probes for missing hashes start running long.
+
+static bool
+NeedsGlyphTableCleanup(glyph_table *Table)
+{
+    uint64_t SlotCount = Table->GroupCount * Table->GroupWidth;
+    bool     Result    = !Table->Previous && Table->DeadCount > (SlotCount / 16);
+
+    return Result;
+}
+
+
+// Turns every tombstone back into an empty slot by reinserting the live entries, in LRU order,
+// into the same memory. Ids change, so this only runs between runs. When InvalidateMoved is set
+// (FixedGrid, where the atlas cell follows the slot) entries that changed slot must be rasterized again.
+
+static void
+CleanupGlyphTable(glyph_table *Table, memory_arena *Scratch, bool InvalidateMoved)
+{
+    NTEXT_ASSERT(Table && !Table->Previous);
+
+    memory_region Region = EnterMemoryRegion(Scratch);
+
+    uint32_t     LiveCount  = Table->Count;
+    glyph_entry *Live       = LiveCount ? PushArray<glyph_entry>(Scratch, LiveCount) : 0;
+    glyph_hash  *LiveHashes = LiveCount ? PushArray<glyph_hash> (Scratch, LiveCount) : 0;
+    uint32_t    *LiveIds    = LiveCount ? PushArray<uint32_t>   (Scratch, LiveCount) : 0;
+
+    if(!LiveCount || (Live && LiveHashes && LiveIds))
+    {
+        glyph_lru_link *Sentinel = GetGlyphTableSentinel(Table);
+
+        uint32_t Copied = 0;
+        for(uint32_t Index = Sentinel->NextLRU; Index != Table->SentinelIndex; Index = GetGlyphLink(Index, Table)->NextLRU)
+        {
+            Live[Copied]       = *GetGlyphEntry(Index, Table);
+            LiveHashes[Copied] = Table->Hashes[Index];
+            LiveIds[Copied]    = Index;
+            Copied            += 1;
+        }
+
+        NTEXT_ASSERT(Copied == LiveCount);
+
+        BeginGlyphTableWrite(Table);
+
+        memset(Table->Metadata, GlyphTableEmptyMask, Table->GroupCount * Table->GroupWidth);
+
+        Sentinel->NextLRU = Table->SentinelIndex;
+        Sentinel->PrevLRU = Table->SentinelIndex;
+        Table->Count      = 0;
+        Table->DeadCount  = 0;
+        Table->Epoch     += 1;
+
+        for(uint32_t Idx = 0; Idx < LiveCount; ++Idx)
+        {
+            glyph_probe  Probe = ProbeGlyphTable(LiveHashes[Idx], Table);
+            glyph_entry *Entry = ClaimGlyphSlot(Probe.FreeIndex, LiveHashes[Idx], Table);
+
+            *Entry = Live[Idx];
+
+            if(InvalidateMoved && Probe.FreeIndex != LiveIds[Idx])
+            {
+                Entry->IsRasterized = false;
+                Entry->Source       = {};
+            }
+
+            LinkGlyphEntryAtTail(Probe.FreeIndex, Table);
+        }
+
+        EndGlyphTableWrite(Table);
+    }
+
+    LeaveMemoryRegion(Region);
+}
+
+
+// Starts migrating into a table twice as large, placed in Arena. The caller picks when: doing it
+// between runs keeps the ids handed out during a run stable.
+
+static glyph_table *
+GrowGlyphTable(glyph_table *Table, memory_arena *Arena)
+{
+    NTEXT_ASSERT(Table && !Table->Previous);
+
+    glyph_table_params Params =
+    {
+        .GroupWidth = static_cast<GlyphTableWidth>(Table->GroupWidth),
+        .GroupCount = Table->GroupCount * 2,
+    };
+
+    glyph_table *Result = 0;
+    void        *Memory = PushArena(Arena, GetGlyphTableFootprint(Params), AlignOf(void *));
+
+    if(Memory)
+    {
+        Result = PlaceGlyphTableInMemory(Params, Memory);
+        Result->Previous = Table;
+    }
+
+    return Result;
+}
+
+
+static glyph_state
+UpdateGlyphTableEntry(uint32_t Id, bool IsRasterized, uint16_t GlyphIndex, glyph_layout_info LayoutInfo, rectangle Source, uint16_t AtlasPage, glyph_table *Table)
+{
+    glyph_entry *Entry = GetGlyphEntry(Id, Table);
+    NTEXT_ASSERT(Entry);
+
+    BeginGlyphTableWrite(Table);
+
+    Entry->IsRasterized = IsRasterized;
+    Entry->GlyphIndex   = GlyphIndex;
+    Entry->AtlasPage    = static_cast<uint8_t>(AtlasPage);
+    Entry->Layout       = LayoutInfo;
+    Entry->Source       = Source;
+
+    EndGlyphTableWrite(Table);
+
+    glyph_state State =
+    {
+        .Id           = Id,
+        .GlyphIndex   = GlyphIndex,
+        .AtlasPage    = AtlasPage,
+        .Layout       = LayoutInfo,
+        .Source       = Source,
+        .IsRasterized = IsRasterized,
+        .EvictedId    = GlyphTableInvalidEntry,
+    };
+    
+    return State;
+}
+
+
+// ==================================================================================
+// @Public : NText Context
+// Placeholder: generator and context management
+// ==================================================================================
+
+// LazyAtlas : One alpha bitmap per (codepoint, size).
+// SDFAtlas  : One distance field per codepoint, rasterized at SDFReferenceSize and scaled
+//             by the renderer. Shaped glyphs carry that scale and the run carries the
+//             distance range needed to decode it.
+// FixedGrid : The atlas is a grid of GridCellSizeX * GridCellSizeY cells and every glyph table
+//             slot owns one of them. Meant for monospace fonts, there is no packing at all.
+
+enum class TextStorage
+{
+    None      = 0,
+    LazyAtlas = 1,
+    SDFAtlas  = 2,
+    FixedGrid = 3,
+};
+
+
+// SubpixelBins > 1 caches that many horizontal variants of every glyph (LazyAtlas only).
+// Runs are then assumed to start on a whole pixel.
+// GlyphTableMaxGroupCount lets the glyph table double, up to that many groups (a power of
+// two) instead of evicting. The memory for it is set aside up front. Not available in FixedGrid mode.
+// GlyphTableGroupWidth picks the probe width. Widths the CPU cannot run fall back to 128 bits,
+// and the table keeps 1024 slots whatever the width.
+// AtlasPageCount is how many CacheSizeX * CacheSizeY pages the atlas may open (1 when 0, at most
+// GlyphAtlasMaxPages). A new page is only opened once a glyph fits on none of the open ones.
+// AtlasPacker picks the packing algorithm of every page, see RectanglePacker. Skyline by default.
+
+constexpr uint32_t GlyphAtlasMaxPages = 8;
+
+
+// An atlas page being emptied into another one, see CompactAtlas. Cursor is the next table slot to look at.
+
+struct atlas_compaction
+{
+    bool         IsActive;
+    bool         HasFailed;
+    uint16_t     FromPage;
+    uint16_t     ToPage;
+    uint32_t     Cursor;
+    glyph_table *Table;
+};
+
+
+struct glyph_generator_params
+{
+    ntext::TextStorage TextStorage;
+    uint64_t           FrameMemoryBudget;
+    void              *FrameMemory;
+    uint16_t           CacheSizeX;
+    uint16_t           CacheSizeY;
+    float              SDFReferenceSize;
+    uint16_t           SDFSpread;
+    uint8_t            SubpixelBins;
+    uint16_t           GridCellSizeX;
+    uint16_t           GridCellSizeY;
+    uint32_t           GlyphTableMaxGroupCount;
+    GlyphTableWidth    GlyphTableGroupWidth;
+    uint32_t           AtlasPageCount;
+    RectanglePacker    AtlasPacker;
+};
+
+
+// Codepoints below 256 skip the hash and the probe: each page maps them straight to the state of
+// their glyph for one font key. Only complete glyphs are stored, and a page is dropped as soon as
+// the table it was filled from is swapped or changes epoch. Pages are direct-mapped on the key.
+
+constexpr uint32_t GlyphDirectPageSize  = 256;
+constexpr uint32_t GlyphDirectPageCount = 8;
+
+
+struct glyph_direct_page
+{
+    uint64_t     OwnerKey;
+    glyph_table *Table;
+    uint32_t     Epoch;
+    uint64_t     Valid[GlyphDirectPageSize / 64];
+    glyph_state  States[GlyphDirectPageSize];
+};
+
+
+// Other threads can look glyphs up through a glyph_reader while the thread owning the generator
+// keeps calling FillAtlas. Readers never write to the table: hits are queued on their touch ring
+// and moved to the front of the LRU by the next FillAtlas, a touch whose epoch went stale is dropped.
+// Each ring has one producer (its reader) and one consumer (the writer).
+
+constexpr uint32_t GlyphTouchRingSize   = 256;
+constexpr uint32_t GlyphTableMaxReaders = 16;
+
+
+struct glyph_touch
+{
+    uint32_t Id;
+    uint32_t Epoch;
+};
+
+
+struct glyph_touch_ring
+{
+    glyph_touch       Touches[GlyphTouchRingSize];
+    volatile uint32_t Head;
+    volatile uint32_t Tail;
+};
+
+
+// One generator serves any number of fonts and sizes, FillAtlas keys the cache on both.
+
+struct glyph_generator
+{
+    // Memory
+    memory_arena     *Arena;
+
+    // Systems
+    glyph_table      *GlyphTable;
+    rectangle_packer *Packers[GlyphAtlasMaxPages];
+    uint32_t          AtlasPageCount;
+    uint32_t          AtlasMaxPageCount;
+    atlas_compaction  Compaction;
+    memory_arena     *GlyphTableArena;
+    uint32_t          GlyphTableMaxGroupCount;
+    glyph_direct_page *DirectPages;
+    glyph_touch_ring  *TouchRings[GlyphTableMaxReaders];
+    uint32_t          ReaderCount;
+
+    // Misc
+    ntext::TextStorage TextStorage;
+    uint16_t          CacheSizeX;
+    uint16_t          CacheSizeY;
+    float             SDFReferenceSize;
+    uint16_t          SDFSpread;
+    uint8_t           SubpixelBins;
+    uint16_t          GridCellSizeX;
+    uint16_t          GridCellSizeY;
+    uint16_t          GridColumns;
+};
+
+// Should we add a function to get the static footprint for the glyph generator?
+
+
+static glyph_generator
+CreateGlyphGenerator(glyph_generator_params Params)
+{
+    glyph_generator Generator = {};
+
+    if(Params.FrameMemoryBudget == 0 || Params.FrameMemory == 0 || Params.TextStorage == TextStorage::None)
+    {
+        return Generator;
+    }
+
+    // Arena Initialization
+    {
+        NTEXT_ASSERT(Params.FrameMemory);
+        NTEXT_ASSERT(Params.FrameMemoryBudget);
+
+        Generator.Arena = static_cast<memory_arena *>(Params.FrameMemory);
+        Generator.Arena->Reserved     = Params.FrameMemoryBudget;
+        Generator.Arena->BasePosition = 0;
+        Generator.Arena->Position     = sizeof(memory_arena);
+    }
+
+    // Glyph Table
+    {
+        GlyphTableWidth GroupWidth = GlyphTableWidth::_128Bits;
+        if(Params.GlyphTableGroupWidth != GlyphTableWidth::None && IsGlyphTableWidthSupported(Params.GlyphTableGroupWidth))
+        {
+            GroupWidth = Params.GlyphTableGroupWidth;
+        }
+
+        uint64_t GroupCount = 1024 / static_cast<uint64_t>(GroupWidth);
+
+        // Every slot needs a cell, so the grid bounds the table. The group count has to stay a power of two.
+        if(Params.TextStorage == TextStorage::FixedGrid)
+        {
+            NTEXT_ASSERT(Params.GridCellSizeX && Params.GridCellSizeY);
+
+            uint64_t CellCount = (Params.CacheSizeX / Params.GridCellSizeX) * (Params.CacheSizeY / Params.GridCellSizeY);
+            while(GroupCount > 1 && GroupCount * static_cast<uint64_t>(GroupWidth) > CellCount)
+            {
+                GroupCount /= 2;
+            }
+
+            NTEXT_ASSERT(GroupCount * static_cast<uint64_t>(GroupWidth) <= CellCount);
+        }
+
+        glyph_table_params TableParams =
+        {
+            .GroupWidth = GroupWidth,
+            .GroupCount = GroupCount,
+        };
+
+        uint64_t Footprint = GetGlyphTableFootprint(TableParams);
+        void    *Memory    = PushArena(Generator.Arena, Footprint, AlignOf(void *));
+
+        Generator.GlyphTable = PlaceGlyphTableInMemory(TableParams, Memory);
+
+        NTEXT_ASSERT(Generator.GlyphTable);
+
+        // Grown tables go in their own arena, so they outlive whatever regions the caller opens on ours.
+        // Every size up to the maximum is set aside since the smaller ones are never given back.
+
+        if(Params.TextStorage != TextStorage::FixedGrid && Params.GlyphTableMaxGroupCount > GroupCount)
+        {
+            NTEXT_ASSERT((Params.GlyphTableMaxGroupCount & (Params.GlyphTableMaxGroupCount - 1)) == 0);
+
+            uint64_t GrowthFootprint = 0;
+            for(uint64_t Count = GroupCount * 2; Count <= Params.GlyphTableMaxGroupCount; Count *= 2)
+            {
+                TableParams.GroupCount = Count;
+                GrowthFootprint       += GetGlyphTableFootprint(TableParams) + AlignOf(void *);
+            }
+
+            Generator.GlyphTableArena         = PushSubArena(Generator.Arena, GrowthFootprint);
+            Generator.GlyphTableMaxGroupCount = Params.GlyphTableMaxGroupCount;
+        }
+    }
+
+    // Direct Pages
+    {
+        Generator.DirectPages = PushArray<glyph_direct_page>(Generator.Arena, GlyphDirectPageCount);
+        if(Generator.DirectPages)
+        {
+            memset(Generator.DirectPages, 0, GlyphDirectPageCount * sizeof(glyph_direct_page));
+        }
+    }
+
+    // Packers, one per atlas page. They are small, so every page gets one up front and only the first is open.
+    if(Params.TextStorage != TextStorage::FixedGrid)
+    {
+        uint32_t PageCount = Params.AtlasPageCount ? Params.AtlasPageCount : 1;
+        PageCount = PageCount < GlyphAtlasMaxPages ? PageCount : GlyphAtlasMaxPages;
+
+        for(uint32_t Page = 0; Page < PageCount; ++Page)
+        {
+            uint64_t Footprint = GetRectanglePackerFootprint(Params.AtlasPacker, Params.CacheSizeX, Params.CacheSizeY);
+            void    *Memory    = PushArena(Generator.Arena, Footprint, AlignOf(void *));
+
+            Generator.Packers[Page] = PlaceRectanglePackerInMemory(Params.AtlasPacker, Params.CacheSizeX, Params.CacheSizeY, Memory);
+
+            NTEXT_ASSERT(Generator.Packers[Page]);
+        }
+
+        Generator.AtlasPageCount    = 1;
+        Generator.AtlasMaxPageCount = PageCount;
+    }
+
+    // Constant Forwarding
+    {
+        NTEXT_ASSERT(Params.TextStorage != TextStorage::None);
+
+        Generator.TextStorage = Params.TextStorage;
+        Generator.CacheSizeX  = Params.CacheSizeX;
+        Generator.CacheSizeY  = Params.CacheSizeY;
+
+        if(Params.TextStorage == TextStorage::SDFAtlas)
+        {
+            Generator.SDFReferenceSize = Params.SDFReferenceSize ? Params.SDFReferenceSize : 48.f;
+            Generator.SDFSpread        = Params.SDFSpread        ? Params.SDFSpread        : 6;
+        }
+
+        // Distance fields are resampled anyway, bins would only waste atlas space.
+        if(Params.TextStorage == TextStorage::LazyAtlas && Params.SubpixelBins > 1)
+        {
+            Generator.SubpixelBins = Params.SubpixelBins;
+        }
+
+        if(Params.TextStorage == TextStorage::FixedGrid)
+        {
+            Generator.GridCellSizeX = Params.GridCellSizeX;
+            Generator.GridCellSizeY = Params.GridCellSizeY;
+            Generator.GridColumns   = Params.CacheSizeX / Params.GridCellSizeX;
+        }
+    }
+
+    return Generator;
+}
+
+
+static bool IsValidGlyphGenerator(const glyph_generator &GlyphGenerator)
+{
+    bool Result = (GlyphGenerator.Arena != 0);
+    return Result;
+}
+
+
+// ==================================================================================
+// @Public : NText String Utilities
+// ==================================================================================
+
+struct word_slice
+{
+    uint64_t Start;
+    uint64_t Length;
+};
+
+
+struct word_slice_node
+{
+    word_slice_node *Next;
+    word_slice       Value;
+};
+
+
+struct word_slice_list
+{
+    word_slice_node *First;
+    word_slice_node *Last;
+    uint32_t         Count;
+};
+
+
+enum class TextAnalysis
+{
+    None               = 0,
+    GenerateWordSlices = 1,
+    SkipComplexCheck   = 2, // Rename this to something like IsAsciiUnsafe?
+};
+
+inline TextAnalysis operator|(TextAnalysis A, TextAnalysis B)   {return static_cast<TextAnalysis>(static_cast<int>(A) | static_cast<int>(B));}
+inline TextAnalysis operator&(TextAnalysis A, TextAnalysis B)   {return static_cast<TextAnalysis>(static_cast<int>(A) & static_cast<int>(B));}
+
+
+struct unicode_decode
+{
+    uint32_t Increment;
+    uint32_t Codepoint;
+};
+
+
+struct analysed_text
+{
+    bool             IsComplex;
+    word_slice_list  Words;
+    uint32_t        *Codepoints;
+    uint64_t         CodepointCount;
+    uint64_t         GlyphCount;
+};
+
+
+const static uint8_t UTF8Class[32] = 
+{
+  1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0,0,0,2,2,2,2,3,3,4,5,
+};
+
+
+static unicode_decode 
+UTF8Decode(char *String, uint64_t Maximum)
+{
+    unicode_decode Result = { 1, UINT32_MAX};
+
+    uint8_t Byte      = String[0];
+    uint8_t ByteClass = UTF8Class[Byte >> 3];
+
+    switch (ByteClass)
+    {
+
+    case 1:
+    {
+        Result.Codepoint = Byte;
+    } break;
+
+    case 2:
+    {
+        if (1 < Maximum)
+        {
+            uint8_t ContByte = String[1];
+            if (UTF8Class[ContByte >> 3] == 0)
+            {
+                Result.Codepoint  = (Byte     & 0b00011111) << 6;
+                Result.Codepoint |= (ContByte & 0b00111111) << 0;
+                Result.Increment  = 2;
+            }
+        }
+    } break;
+
+    case 3:
+    {
+        if (2 < Maximum)
+        {
+            uint8_t ContByte[2] = { (uint8_t)String[1], (uint8_t)String[2] };
+            if (UTF8Class[ContByte[0] >> 3] == 0 && UTF8Class[ContByte[1] >> 3] == 0)
+            {
+                Result.Codepoint  = ((Byte        & 0b00001111) << 12);
+                Result.Codepoint |= ((ContByte[0] & 0b00111111) << 6 );
+                Result.Codepoint |= ((ContByte[1] & 0b00111111) << 0 );
+                Result.Increment  = 3;
+            }
+        }
+    } break;
+
+    case 4:
+    {
+        if (3 < Maximum)
+        {
+            uint8_t ContByte[3] = { (uint8_t)String[1], (uint8_t)String[2], (uint8_t)String[3] };
+            if (UTF8Class[ContByte[0] >> 3] == 0 && UTF8Class[ContByte[1] >> 3] == 0 && UTF8Class[ContByte[2] >> 3] == 0)
+            {
+                Result.Codepoint  = (Byte        & 0b00000111) << 18;
+                Result.Codepoint |= (ContByte[0] & 0b00111111) << 12;
+                Result.Codepoint |= (ContByte[1] & 0b00111111) << 6;
+                Result.Codepoint |= (ContByte[2] & 0b00111111) << 0;
+                Result.Increment = 4;
+            }
+        }
+    } break;
+
+    }
+
+    return Result;
+}
+
+
+static analysed_text
+AnalyzeText(char *Data, uint64_t Size, TextAnalysis Flags, glyph_generator &Generator)
+{
+    NTEXT_ASSERT(Data);
+    NTEXT_ASSERT(Size);
+
+    analysed_text Result =
+    {
+        .Codepoints = PushArray<uint32_t>(Generator.Arena, Size),
+    };
+
+    if(Result.Codepoints)
+    {
+        uint64_t DecodedBytes = 0;
+
+        while(DecodedBytes < Size)
+        {
+            unicode_decode Decoded = UTF8Decode(Data + DecodedBytes, Size - DecodedBytes);
+
+            Result.Codepoints[Result.CodepointCount++] = Decoded.Codepoint;
+            DecodedBytes                              += Decoded.Increment;
+        }
+
+        if(!((Flags & TextAnalysis::SkipComplexCheck) != TextAnalysis::None))
+        {
+            char    *At                = Data;
+            uint64_t Remaining         = Size;
+            uint64_t Advance           = 16;
+            __m128i  ComplexByteVector = _mm_set1_epi8(0x80);
+
+            __m128i HasComplex = _mm_setzero_si128();
+            while(Remaining >= Advance)
+            {
+                __m128i Batch = _mm_loadu_si128((__m128i *)At);
+                __m128i TextX = _mm_and_si128(Batch, ComplexByteVector);
+
+                HasComplex = _mm_or_si128(HasComplex, TextX);
+
+                if(_mm_movemask_epi8(HasComplex))
+                {
+                    Result.IsComplex = true;
+                    break;
+                }
+
+                Remaining -= Advance;
+                At        += Advance;
+            }
+
+            if(!Result.IsComplex)
+            {
+                while(Remaining--)
+                {
+                    if(*At == (char)0x80)
+                    {
+                        Result.IsComplex = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if((Flags & TextAnalysis::GenerateWordSlices) != TextAnalysis::None)
+        {
+            // We only handle simple ASCII path for now. Which is fine.
+
+            uint64_t CodepointIdx = 0;
+
+            while(CodepointIdx < Result.CodepointCount)
+            {
+                uint32_t Codepoint = Result.Codepoints[CodepointIdx];
+        
+                if(Codepoint != ' ' && Codepoint != '\t')
+                {
+                    word_slice_node *Node = PushStruct<word_slice_node>(Generator.Arena);
+                    if(Node)
+                    {
+                        word_slice_list &List = Result.Words;
+
+                        Node->Next         = 0;
+                        Node->Value.Start  = CodepointIdx;
+                        Node->Value.Length = 0;
+        
+                        if(!List.First)
+                        {
+                             List.First = Node;
+                        }
+            
+                        if(List.Last)
+                        {
+                            List.Last->Next = Node;
+                        }
+            
+                        List.Last   = Node;
+                        List.Count += 1;
+        
+                        Codepoint = Data[++CodepointIdx];
+                        while(CodepointIdx < Result.CodepointCount && Codepoint != ' ' && Codepoint != '\t')
+                        {
+                            CodepointIdx += 1;
+                            Codepoint     = Result.Codepoints[CodepointIdx];
+                        }
         
+                        Node->Value.Length = CodepointIdx - Node->Value.Start;
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                else
+                {
+                    ++CodepointIdx;
+                }
+            }
+        }
+    }
+
+
+    return Result;
+}
+
+// ==================================================================================
+// @Public : NText Collection
+// ==================================================================================
+
+enum class TextureFormat
+{
+    None      = 0,
+    RGBA      = 1,
+    GreyScale = 2,
+};
+
+
+struct rasterized_glyph
+{
+    rectangle         Source;
+    uint32_t          AtlasPage;
+    rasterized_buffer Buffer;
+};
+
+
+struct rasterized_glyph_node
+{
+    rasterized_glyph_node *Next;
+    rasterized_glyph       Value;
+};
+
+
+struct rasterized_glyph_list
+{
+    rasterized_glyph_node *First;
+    rasterized_glyph_node *Last;
+    uint32_t               Count;
+};
+
+
+// Entries that were pushed out of the cache while filling a run. Source (on AtlasPage) is the atlas
+// area they used, it is free to be overwritten by the update list of the same run.
+
+struct evicted_glyph
+{
+    uint32_t  Id;
+    uint32_t  AtlasPage;
+    rectangle Source;
+};
+
+
+struct evicted_glyph_node
+{
+    evicted_glyph_node *Next;
+    evicted_glyph       Value;
+};
+
+
+struct evicted_glyph_list
+{
+    evicted_glyph_node *First;
+    evicted_glyph_node *Last;
+    uint32_t            Count;
+};
+
+
+// A glyph that CompactAtlas moved. The renderer copies From (on FromPage) to To (on ToPage),
+// the pixels stay the same.
+
+struct atlas_move
+{
+    uint32_t  FromPage;
+    rectangle From;
+    uint32_t  ToPage;
+    rectangle To;
+};
+
+
+struct atlas_move_node
+{
+    atlas_move_node *Next;
+    atlas_move       Value;
+};
+
+
+struct atlas_move_list
+{
+    atlas_move_node *First;
+    atlas_move_node *Last;
+    uint32_t         Count;
+};
+
+
+// Scale maps Source to screen pixels. It is 1 unless the atlas stores size independent glyphs.
+// DistanceRange is 0 for coverage atlases, otherwise see BuildSignedDistanceField.
+// AtlasPage is the layer to sample Source from, always 0 with a single page.
+
+struct shaped_glyph
+{
+    uint16_t          GlyphIndex;
+    uint16_t          AtlasPage;
+    rectangle         Source;
+    glyph_layout_info Layout;
+    float             Scale;
+    uint32_t          ClusterStart;
+    uint32_t          ClusterCount;
+};
+
+
+struct shaped_glyph_run
+{
+    rasterized_glyph_list UpdateList;
+    evicted_glyph_list    EvictedList;
+    shaped_glyph         *Shaped;
+    uint32_t              ShapedCount;
+    float                 DistanceRange;
+};
+
+
+struct word_glyph_cursor
+{
+    shaped_glyph *Glyphs;
+    uint32_t      GlyphCount;
+    uint32_t      GlyphAt;
+};
+
+
+struct word_advance
+{
+    float Advance;
+    float LeadingWhitespaceAdvance;
+};
+
+
+// Everything besides the codepoints that decides what a cached glyph looks like. Size is kept
+// in 1/64th of a pixel and dropped for distance fields, which are shared by every size.
+// (Size << 8 | Bin) is unique per font and the odd multiply keeps it that way.
+
+static uint64_t
+MakeGlyphKey(system_font Font, TextStorage Storage, uint32_t Bin)
+{
+    uint64_t QuantizedSize = Storage == TextStorage::SDFAtlas ? 0 : static_cast<uint64_t>(Font.Size * 64.f + 0.5f);
+    uint64_t Result        = Font.Id ^ (((QuantizedSize << 8) | Bin) * 0x9E3779B97F4A7C15ull);
+
+    return Result;
+}
+
+
+// Returns the page for Key, emptied if it belonged to another key or went stale. Null when the generator has none.
+
+static glyph_direct_page *
+GetGlyphDirectPage(uint64_t Key, glyph_generator &Generator)
+{
+    glyph_direct_page *Result = 0;
+
+    if(Generator.DirectPages)
+    {
+        // Keys are multiplied by a large odd constant, the top bits are the best mixed.
+        Result = Generator.DirectPages + (Key >> 61) % GlyphDirectPageCount;
+
+        glyph_table *Table = Generator.GlyphTable;
+        if(Result->OwnerKey != Key || Result->Table != Table || Result->Epoch != Table->Epoch)
+        {
+            Result->OwnerKey = Key;
+            Result->Table    = Table;
+            Result->Epoch    = Table->Epoch;
+            memset(Result->Valid, 0, sizeof(Result->Valid));
+        }
+    }
+
+    return Result;
+}
+
+
+struct glyph_reader
+{
+    glyph_table       *Table;
+    glyph_touch_ring  *Ring;
+    ntext::TextStorage TextStorage;
+};
+
+
+// Called on the writer thread, before any reader starts and outside of any region opened on the
+// generator arena. Readers see the table the generator had at that point, which is why growth is
+// not allowed with them.
+
+static glyph_reader
+CreateGlyphReader(glyph_generator &Generator)
+{
+    glyph_reader Result = {};
+
+    NTEXT_ASSERT(!Generator.GlyphTableArena);
+    NTEXT_ASSERT(Generator.ReaderCount < GlyphTableMaxReaders);
+
+    glyph_touch_ring *Ring = PushStruct<glyph_touch_ring>(Generator.Arena);
+    if(Ring && Generator.ReaderCount < GlyphTableMaxReaders)
+    {
+        Ring->Head = 0;
+        Ring->Tail = 0;
+
+        Generator.TouchRings[Generator.ReaderCount++] = Ring;
+
+        Result.Table       = Generator.GlyphTable;
+        Result.Ring        = Ring;
+        Result.TextStorage = Generator.TextStorage;
+    }
+
+    return Result;
+}
+
+
+// ProbeGlyphTable for the reader thread: the writer may be changing the table under it, so every
+// group, hash and payload is copied out with relaxed loads and only the copies are looked at.
+// The result means nothing until the sequence was checked again.
+
+static uint32_t
+ProbeGlyphTableRelaxed(glyph_hash Hash, glyph_table *Table, glyph_entry *Entry)
+{
+    uint32_t Result = GlyphTableInvalidEntry;
+
+    glyph_tag Tag        = GetGlyphTagFromHash(Hash);
+    uint32_t  GroupIndex = GetGlyphGroupIndexFromHash(Hash, Table);
+
+    alignas(64) uint8_t Group[64];
+
+    for(uint32_t ProbeCount = 0; ProbeCount < Table->GroupCount && Result == GlyphTableInvalidEntry; ++ProbeCount)
+    {
+        AtomicCopyRelaxed(Group, Table->Metadata + (GroupIndex * Table->GroupWidth), Table->GroupWidth);
+
+        glyph_group_match Match = MatchGlyphGroup(Group, Tag.Value, Table->GroupWidth);
+
+        for(uint64_t TagMask = Match.Tags; TagMask && Result == GlyphTableInvalidEntry; TagMask &= TagMask - 1)
+        {
+            uint32_t   EntryIndex = FindFirstBit64(TagMask) + (GroupIndex * Table->GroupWidth);
+            glyph_hash Stored;
+
+            AtomicCopyRelaxed(&Stored, &Table->Hashes[EntryIndex], sizeof(Stored));
+
+            if(GlyphHashesAreEqual(Hash, Stored))
+            {
+                AtomicCopyRelaxed(Entry, GetGlyphEntry(EntryIndex, Table), sizeof(glyph_entry));
+                Result = EntryIndex;
+            }
+        }
+
+        if(Match.Empty)
+        {
+            break;
+        }
+
+        GroupIndex = (GroupIndex + ProbeCount + 1) & Table->HashMask;
+    }
+
+    return Result;
+}
+
+
+// Safe to call from the reader's thread at any time. Returns false when the glyph is not in the
+// cache or not rasterized yet, that codepoint then has to go through FillAtlas on the writer.
+// Retries while the writer is in the middle of a change: the copy is taken between an acquire load
+// of an even sequence and an acquire fence, and kept only if the sequence did not move in between.
+
+static bool
+ReadGlyphEntryByHash(glyph_hash Hash, glyph_reader &Reader, glyph_state *State)
+{
+    NTEXT_ASSERT(Reader.Table && Reader.Ring && State);
+
+    glyph_table *Table  = Reader.Table;
+    bool         Result = false;
+    uint32_t     Epoch  = 0;
+
+    for(;;)
+    {
+        uint32_t Begin = AtomicLoadAcquire32(&Table->Sequence);
+        if(Begin & 1)
+        {
+            _mm_pause();
+            continue;
+        }
+
+        glyph_entry Entry;
+        uint32_t    EntryIndex = ProbeGlyphTableRelaxed(Hash, Table, &Entry);
+
+        Epoch = AtomicLoadRelaxed32(&Table->Epoch);
+
+        AtomicFenceAcquire();
+
+        if(AtomicLoadRelaxed32(&Table->Sequence) != Begin)
+        {
+            continue;
+        }
+
+        Result = false;
+        if(EntryIndex != GlyphTableInvalidEntry)
+        {
+            State->Id               = EntryIndex;
+            State->GlyphIndex       = Entry.GlyphIndex;
+            State->AtlasPage        = Entry.AtlasPage;
+            State->Layout           = Entry.Layout;
+            State->Source           = Entry.Source;
+            State->IsRasterized     = Entry.IsRasterized;
+            State->EvictedId        = GlyphTableInvalidEntry;
+            State->EvictedAtlasPage = 0;
+            State->EvictedSource    = {};
+
+            Result = Entry.IsRasterized;
+        }
+
+        break;
+    }
+
+    // A full ring only costs LRU accuracy.
+    if(Result)
+    {
+        glyph_touch_ring *Ring = Reader.Ring;
+
+        uint32_t Head = Ring->Head;
+        if(Head - AtomicLoadAcquire32(&Ring->Tail) < GlyphTouchRingSize)
+        {
+            Ring->Touches[Head % GlyphTouchRingSize] = {.Id = State->Id, .Epoch = Epoch};
+            AtomicStoreRelease32(&Ring->Head, Head + 1);
+        }
+    }
+
+    return Result;
+}
+
+
+static bool
+ReadCachedGlyph(uint32_t Codepoint, system_font Font, glyph_reader &Reader, glyph_state *State)
+{
+    glyph_hash Hash   = ComputeSingleGlyphHash(Codepoint, MakeGlyphKey(Font, Reader.TextStorage, 0), DefaultSeed);
+    bool       Result = ReadGlyphEntryByHash(Hash, Reader, State);
+
+    return Result;
+}
+
+
+// Writer side: replays what the readers hit since the last call.
+
+static void
+ApplyGlyphTouches(glyph_generator &Generator)
+{
+    glyph_table *Table = Generator.GlyphTable;
+
+    for(uint32_t ReaderIdx = 0; ReaderIdx < Generator.ReaderCount; ++ReaderIdx)
+    {
+        glyph_touch_ring *Ring = Generator.TouchRings[ReaderIdx];
+
+        uint32_t Head = AtomicLoadAcquire32(&Ring->Head);
+        uint32_t Tail = Ring->Tail;
+
+        for(; Tail != Head; ++Tail)
+        {
+            glyph_touch Touch = Ring->Touches[Tail % GlyphTouchRingSize];
+
+            // Same epoch means nothing left its slot since the reader saw it.
+            if(Touch.Epoch == Table->Epoch)
+            {
+                TouchGlyphEntry(Touch.Id, Table);
+            }
+        }
+
+        AtomicStoreRelease32(&Ring->Tail, Tail);
+    }
+}
+
+
+// Hands the atlas area of an evicted entry back and tells the caller about it. Grid cells belong
+// to their slot and are reused as is, the skyline can only keep count.
+
+static void
+RecordGlyphEviction(glyph_state &State, shaped_glyph_run &Run, glyph_generator &Generator)
+{
+    if(State.EvictedId == GlyphTableInvalidEntry)
+    {
+        return;
+    }
+
+    if(Generator.AtlasPageCount)
+    {
+        ReleasePackedRectangle(State.EvictedSource, Generator.Packers[State.EvictedAtlasPage]);
+    }
+
+    auto *Node = PushStruct<evicted_glyph_node>(Generator.Arena);
+    if(Node)
+    {
+        evicted_glyph_list &List = Run.EvictedList;
+
+        Node->Next         = 0;
+        Node->Value.Id        = State.EvictedId;
+        Node->Value.AtlasPage = State.EvictedAtlasPage;
+        Node->Value.Source    = State.EvictedSource;
+
+        if(!List.First)
+        {
+            List.First = Node;
+        }
+
+        if(List.Last)
+        {
+            List.Last->Next = Node;
+        }
+
+        List.Last   = Node;
+        List.Count += 1;
+    }
+}
+
+
+// Drops a codepoint of a font (every subpixel variant) from the cache, e.g. once that font is
+// unloaded. Returns how many entries went away. The rest is the same as an eviction, except that nobody is told.
+
+static uint32_t
+RemoveCachedGlyph(uint32_t Codepoint, system_font Font, glyph_generator &Generator)
+{
+    uint32_t Result   = 0;
+    uint32_t BinCount = Generator.SubpixelBins > 1 ? Generator.SubpixelBins : 1;
+
+    for(uint32_t Bin = 0; Bin < BinCount; ++Bin)
+    {
+        glyph_hash  Hash  = ComputeSingleGlyphHash(Codepoint, MakeGlyphKey(Font, Generator.TextStorage, Bin), DefaultSeed);
+        glyph_state State = RemoveGlyphEntry(Hash, Generator.GlyphTable);
+
+        if(State.Id != GlyphTableInvalidEntry)
+        {
+            if(Generator.AtlasPageCount)
+            {
+                ReleasePackedRectangle(State.Source, Generator.Packers[State.AtlasPage]);
+            }
+
+            Result += 1;
+        }
+    }
+
+    return Result;
+}
+
+
+// In FixedGrid mode the cell is a function of the table slot, so allocating it cannot fail.
+
+static packed_rectangle
+GetGridCell(uint32_t SlotId, glyph_generator &Generator)
+{
+    uint32_t Column = SlotId % Generator.GridColumns;
+    uint32_t Row    = SlotId / Generator.GridColumns;
+
+    packed_rectangle Result =
+    {
+        .Width     = Generator.GridCellSizeX,
+        .Height    = Generator.GridCellSizeY,
+        .X         = static_cast<uint16_t>(Column * Generator.GridCellSizeX),
+        .Y         = static_cast<uint16_t>(Row    * Generator.GridCellSizeY),
+        .WasPacked = true,
+    };
+
+    return Result;
+}
+
+
+// Tries the open pages, newest first since older ones are the fuller ones, then opens a new one
+// if allowed. Returns the page the rectangle went to. A page being compacted takes nothing new.
+
+static uint16_t
+PackGlyphRectangle(packed_rectangle &Rectangle, glyph_generator &Generator)
+{
+    uint16_t Result = 0;
+
+    for(uint32_t Page = Generator.AtlasPageCount; Page-- > 0 && !Rectangle.WasPacked;)
+    {
+        if(Generator.Compaction.IsActive && Page == Generator.Compaction.FromPage)
+        {
+            continue;
+        }
+
+        PackRectangle(Rectangle, Generator.Packers[Page]);
+        Result = static_cast<uint16_t>(Page);
+    }
+
+    // A glyph that does not fit an empty page never will.
+    bool FitsEmptyPage = Rectangle.Width <= Generator.Packers[0]->Width && Rectangle.Height <= Generator.Packers[0]->Height;
+
+    if(!Rectangle.WasPacked && FitsEmptyPage && Generator.AtlasPageCount < Generator.AtlasMaxPageCount)
+    {
+        Result = static_cast<uint16_t>(Generator.AtlasPageCount++);
+        PackRectangle(Rectangle, Generator.Packers[Result]);
+    }
+
+    return Result;
+}
+
+
+static void
+PackGlyphRectanglesOnPage(uint32_t Page, packed_rectangle *Rectangles, uint16_t *Pages, uint32_t Count, glyph_generator &Generator)
+{
+    PackRectangles(Rectangles, Count, Generator.Packers[Page], Generator.Arena);
+
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        if(Rectangles[Idx].WasPacked && Pages[Idx] == UINT16_MAX)
+        {
+            Pages[Idx] = static_cast<uint16_t>(Page);
+        }
+    }
+}
+
+
+// Same as PackGlyphRectangle for a whole batch of misses, see PackRectangles. Pages[Idx] receives the page
+// Rectangles[Idx] went to, 0 when it was not packed.
+
+static void
+PackGlyphRectangles(packed_rectangle *Rectangles, uint16_t *Pages, uint32_t Count, glyph_generator &Generator)
+{
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        Pages[Idx] = UINT16_MAX;
+    }
+
+    for(uint32_t Page = Generator.AtlasPageCount; Page-- > 0;)
+    {
+        if(!Generator.Compaction.IsActive || Page != Generator.Compaction.FromPage)
+        {
+            PackGlyphRectanglesOnPage(Page, Rectangles, Pages, Count, Generator);
+        }
+    }
+
+    while(Generator.AtlasPageCount < Generator.AtlasMaxPageCount)
+    {
+        // Only open a page if something left would fit an empty one.
+        bool FitsEmptyPage = false;
+        for(uint32_t Idx = 0; Idx < Count && !FitsEmptyPage; ++Idx)
+        {
+            packed_rectangle &Rectangle = Rectangles[Idx];
+
+            FitsEmptyPage = !Rectangle.WasPacked && Rectangle.Width && Rectangle.Height &&
+                            Rectangle.Width  <= Generator.Packers[0]->Width &&
+                            Rectangle.Height <= Generator.Packers[0]->Height;
+        }
+
+        if(!FitsEmptyPage)
+        {
+            break;
+        }
+
+        PackGlyphRectanglesOnPage(Generator.AtlasPageCount++, Rectangles, Pages, Count, Generator);
+    }
+
+    for(uint32_t Idx = 0; Idx < Count; ++Idx)
+    {
+        if(Pages[Idx] == UINT16_MAX)
+        {
+            Pages[Idx] = 0;
+        }
+    }
+}
+
+
+// Rasterizes a glyph the way the atlas stores it: distance fields are converted here and their
+// spread folded into the layout.
+
+static rasterized_buffer
+RasterizeGlyphForAtlas(uint16_t GlyphIndex, float Advance, float SubpixelX, system_font Font, backend_context Backend,
+                       glyph_generator &Generator, glyph_layout_info *Layout)
+{
+    rasterized_buffer Result = RasterizeGlyphToAlphaTexture(GlyphIndex, Advance, SubpixelX, Font, Backend, Generator.Arena);
+
+    if(Generator.TextStorage == TextStorage::SDFAtlas && Result.Data)
+    {
+        Result = BuildSignedDistanceField(Result, Generator.SDFSpread, Generator.Arena);
+
+        Layout->OffsetX -= Generator.SDFSpread;
+        Layout->OffsetY += Generator.SDFSpread;
+    }
+
+    return Result;
+}
+
+
+// Pack what was actually rasterized so the copy into the atlas can never spill over a neighbour.
+// Grid cells are fixed instead, so whatever overflows the cell is cropped, and the rectangle comes back already placed.
+
+static packed_rectangle
+GetGlyphAtlasRectangle(rasterized_buffer &Buffer, uint32_t SlotId, glyph_generator &Generator)
+{
+    packed_rectangle Result =
+    {
+        .Width  = static_cast<uint16_t>(Buffer.Data ? Buffer.Width  : 0),
+        .Height = static_cast<uint16_t>(Buffer.Data ? Buffer.Height : 0),
+    };
+
+    if(Generator.TextStorage == TextStorage::FixedGrid)
+    {
+        packed_rectangle Cell = GetGridCell(SlotId, Generator);
+
+        Buffer.Width  = Buffer.Width  < Cell.Width  ? Buffer.Width  : Cell.Width;
+        Buffer.Height = Buffer.Height < Cell.Height ? Buffer.Height : Cell.Height;
+
+        Result.X         = Cell.X;
+        Result.Y         = Cell.Y;
+        Result.Width     = static_cast<uint16_t>(Buffer.Width);
+        Result.Height    = static_cast<uint16_t>(Buffer.Height);
+        Result.WasPacked = true;
+    }
+
+    return Result;
+}
+
+
+// Queues the bitmap of a placed glyph on the update list. Returns false when it found no place.
+
+static bool
+CommitGlyphToAtlas(rasterized_buffer Buffer, packed_rectangle Rectangle, uint16_t AtlasPage, glyph_generator &Generator,
+                   rasterized_glyph_list &UpdateList, rectangle *Source)
+{
+    if(Rectangle.WasPacked)
+    {
+        // This is just wrong. At least, what we return from the packer is confusing.
+
+        *Source =
+        {
+            .Left   = static_cast<float>(Rectangle.X),
+            .Top    = static_cast<float>(Rectangle.Y),
+            .Right  = static_cast<float>(Rectangle.X + Rectangle.Width ),
+            .Bottom = static_cast<float>(Rectangle.Y + Rectangle.Height),
+        };
+
+        if(Buffer.BytesPerPixel == 1 && Buffer.Data)
+        {
+            auto *Node = PushStruct<rasterized_glyph_node>(Generator.Arena);
+            if(Node)
+            {
+                Node->Next            = 0;
+                Node->Value.Buffer    = Buffer;
+                Node->Value.Source    = *Source;
+                Node->Value.AtlasPage = AtlasPage;
+
+                if(!UpdateList.First)
+                {
+                    UpdateList.First = Node;
+                }
+
+                if(UpdateList.Last)
+                {
+                    UpdateList.Last->Next = Node;
+                }
+
+                UpdateList.Last   = Node;
+                UpdateList.Count += 1;
+            }
+        }
+    }
+
+    return Rectangle.WasPacked;
+}
+
+
+// Rasterizes, converts and places one glyph, queueing its bitmap on the update list.
+// Returns false when the atlas is out of space.
+
+static bool
+RasterizeGlyphIntoAtlas(uint16_t GlyphIndex, float Advance, float SubpixelX, uint32_t SlotId, system_font Font, backend_context Backend,
+                        glyph_generator &Generator, rasterized_glyph_list &UpdateList, glyph_layout_info *Layout, rectangle *Source, uint16_t *AtlasPage)
+{
+    rasterized_buffer Buffer    = RasterizeGlyphForAtlas(GlyphIndex, Advance, SubpixelX, Font, Backend, Generator, Layout);
+    packed_rectangle  Rectangle = GetGlyphAtlasRectangle(Buffer, SlotId, Generator);
+
+    if(Generator.TextStorage != TextStorage::FixedGrid)
+    {
+        *AtlasPage = PackGlyphRectangle(Rectangle, Generator);
+    }
+
+    bool Result = CommitGlyphToAtlas(Buffer, Rectangle, *AtlasPage, Generator, UpdateList, Source);
+    return Result;
+}
+
+
+// TODO: Error checks.
+static shaped_glyph_run
+FillAtlas(analysed_text Analysed, glyph_generator &Generator, system_font Font, backend_context Backend)
+{
+    shaped_glyph_run Run = {};
+    Run.Shaped = PushArray<shaped_glyph>(Generator.Arena, Analysed.CodepointCount);
+
+    // Distance fields are resolved and rasterized at the reference size, through a copy of the
+    // font info that only differs by its scale. Entries store reference layouts that are scaled on the way out.
+
+    bool           IsSDF       = (Generator.TextStorage == TextStorage::SDFAtlas);
+    system_font    RasterFont  = Font;
+    font_face_info RasterInfo  = {};
+    float          OutputScale = 1.f;
+
+    if(IsSDF && IsValidSystemFont(&Font))
+    {
+        RasterInfo        = *Font.Info;
+        RasterInfo.Scale  = Font.Info->Scale * (Generator.SDFReferenceSize / Font.Size);
+        RasterFont.Info   = &RasterInfo;
+        RasterFont.Size   = Generator.SDFReferenceSize;
+        OutputScale       = Font.Size / Generator.SDFReferenceSize;
+        Run.DistanceRange = static_cast<float>(2 * Generator.SDFSpread);
+    }
+
+    ApplyGlyphTouches(Generator);
+
+    // Growth and cleanup only ever happen between runs, the ids handed out during a run have to stay valid.
+    // Starting at 3/4 of the capacity leaves the migration room to finish before anything gets evicted.
+
+    if(Generator.GlyphTableArena && !Generator.GlyphTable->Previous)
+    {
+        glyph_table *Table = Generator.GlyphTable;
+
+        if(Table->Count >= Table->Capacity - (Table->Capacity / 4) && Table->GroupCount < Generator.GlyphTableMaxGroupCount)
+        {
+            glyph_table *Grown = GrowGlyphTable(Table, Generator.GlyphTableArena);
+            if(Grown)
+            {
+                Generator.GlyphTable = Grown;
+            }
+        }
+    }
+
+    if(NeedsGlyphTableCleanup(Generator.GlyphTable))
+    {
+        CleanupGlyphTable(Generator.GlyphTable, Generator.Arena, Generator.TextStorage == TextStorage::FixedGrid);
+
+        // Entries changed slot, whatever the compaction already went past has to be looked at again.
+        Generator.Compaction.Cursor = 0;
+    }
+
+    // Fonts and sizes share the table and the atlas, they only differ by key.
+
+    uint64_t FontKey = MakeGlyphKey(Font, Generator.TextStorage, 0);
+
+    // Nothing the run uses may be evicted before the run is drawn, its atlas area would be handed out
+    // again. Glyphs that find the table pinned all the way are shaped, but left out of the atlas.
+
+    PinGlyphTable(Generator.GlyphTable, Generator.Arena);
+
+    if(!Analysed.IsComplex)
+    {
+        uint32_t *MissCodepoints = PushArray<uint32_t>(Generator.Arena, Analysed.CodepointCount);
+        uint32_t *MissIds        = PushArray<uint32_t>(Generator.Arena, Analysed.CodepointCount);
+        uint32_t *PendingShaped  = PushArray<uint32_t>(Generator.Arena, Analysed.CodepointCount);
+        uint32_t *PendingMisses  = PushArray<uint32_t>(Generator.Arena, Analysed.CodepointCount);
+        uint32_t  MissCount      = 0;
+        uint32_t  PendingCount   = 0;
+
+        // Resolve every codepoint against the cache first and only remember the misses.
+        // A codepoint that repeats within the run is only resolved once (by id, or by codepoint
+        // for the ones that did not get an entry).
+
+        glyph_table       *Table = Generator.GlyphTable;
+        glyph_direct_page *Page  = GetGlyphDirectPage(FontKey, Generator);
+
+        glyph_state *States       = PushArray<glyph_state>(Generator.Arena, Analysed.CodepointCount);
+        glyph_hash  *Hashes       = PushArray<glyph_hash> (Generator.Arena, Analysed.CodepointCount);
+        glyph_state *HashedStates = PushArray<glyph_state>(Generator.Arena, Analysed.CodepointCount);
+        uint32_t    *HashedIdx    = PushArray<uint32_t>   (Generator.Arena, Analysed.CodepointCount);
+        uint32_t     HashedCount  = 0;
+
+        // Direct hits are done right away. Everything else is hashed and looked up as one batch.
+
+        for(uint32_t Idx = 0; Idx < Analysed.CodepointCount; ++Idx)
+        {
+            uint32_t Codepoint = Analysed.Codepoints[Idx];
+
+            if(Page && Codepoint < GlyphDirectPageSize && (Page->Valid[Codepoint / 64] & (1ull << (Codepoint % 64))))
+            {
+                States[Idx] = Page->States[Codepoint];
+                TouchGlyphEntry(States[Idx].Id, Table);
+            }
+            else
+            {
+                Hashes[HashedCount]    = ComputeSingleGlyphHash(Codepoint, FontKey, DefaultSeed);
+                HashedIdx[HashedCount] = Idx;
+                HashedCount           += 1;
+            }
+        }
+
+        FindGlyphEntriesByHashBatch(Hashes, HashedCount, HashedStates, Table);
+
+        // Any eviction bumps the epoch, the page is only filled if the batch did not cause one.
+        bool CanFillPage = Page && Page->Epoch == Table->Epoch;
+
+        for(uint32_t HashedIndex = 0; HashedIndex < HashedCount; ++HashedIndex)
+        {
+            glyph_state &State     = HashedStates[HashedIndex];
+            uint32_t     Idx       = HashedIdx[HashedIndex];
+            uint32_t     Codepoint = Analysed.Codepoints[Idx];
+
+            RecordGlyphEviction(State, Run, Generator);
+
+            if(CanFillPage && State.IsRasterized && Codepoint < GlyphDirectPageSize)
+            {
+                Page->States[Codepoint]      = State;
+                Page->Valid[Codepoint / 64] |= (1ull << (Codepoint % 64));
+            }
+
+            States[Idx] = State;
+        }
+
+        for(uint32_t Idx = 0; Idx < Analysed.CodepointCount; ++Idx)
+        {
+            uint32_t    Codepoint = Analysed.Codepoints[Idx];
+            glyph_state State     = States[Idx];
+
             if(!State.IsRasterized)
             {
-                os_glyph_info Info = FindGlyphInformation(Codepoint, Font);
-        
-                // This cast is wrong/dangerous. Should probably round up or allow floating points in the packer?
-        
-                packed_rectangle Rectangle =
+                uint32_t MissIdx = 0;
+                while(MissIdx < MissCount && (MissIds[MissIdx] != State.Id ||
+                      (State.Id == GlyphTableInvalidEntry && MissCodepoints[MissIdx] != Codepoint)))
+                {
+                    ++MissIdx;
+                }
+
+                if(MissIdx == MissCount)
+                {
+                    MissCodepoints[MissCount] = Codepoint;
+                    MissIds[MissCount]        = State.Id;
+                    MissCount                += 1;
+                }
+
+                PendingShaped[PendingCount] = Run.ShapedCount;
+                PendingMisses[PendingCount] = MissIdx;
+                PendingCount               += 1;
+            }
+
+            Run.Shaped[Run.ShapedCount++] =
+            {
+                .GlyphIndex   = State.GlyphIndex,
+                .AtlasPage    = State.AtlasPage,
+                .Source       = State.Source,
+                .Layout       = State.Layout,
+                .Scale        = OutputScale,
+                .ClusterStart = Idx,
+                .ClusterCount = 1,
+            };
+        }
+
+        if(MissCount)
+        {
+            os_glyph_info_batch Infos = PushGlyphInfoBatch(MissCount, Generator.Arena);
+            FindGlyphInformationBatch(MissCodepoints, MissCount, RasterFont, &Infos);
+
+            // Everything is rasterized first so the misses can be packed together, largest first.
+
+            glyph_layout_info *Layouts    = PushArray<glyph_layout_info>(Generator.Arena, MissCount);
+            rasterized_buffer *Buffers    = PushArray<rasterized_buffer>(Generator.Arena, MissCount);
+            packed_rectangle  *Rectangles = PushArray<packed_rectangle> (Generator.Arena, MissCount);
+            uint16_t          *Pages      = PushArray<uint16_t>         (Generator.Arena, MissCount);
+            rectangle         *Sources    = PushArray<rectangle>        (Generator.Arena, MissCount);
+
+            for(uint32_t MissIdx = 0; MissIdx < MissCount; ++MissIdx)
+            {
+                Layouts[MissIdx] =
                 {
-                    .Width  = static_cast<uint16_t>(Info.SizeX),
-                    .Height = static_cast<uint16_t>(Info.SizeY),
+                    .Advance = Infos.Advances[MissIdx],
+                    .OffsetX = Infos.OffsetsX[MissIdx],
+                    .OffsetY = Infos.OffsetsY[MissIdx],
                 };
-        
-                PackRectangle(Rectangle, Generator.Packer);
-        
-                if(Rectangle.WasPacked)
+
+                Buffers[MissIdx]    = {};
+                Rectangles[MissIdx] = {};
+                Pages[MissIdx]      = 0;
+                Sources[MissIdx]    = {};
+
+                bool HasEntry = MissIds[MissIdx] != GlyphTableInvalidEntry;
+                if(HasEntry && Infos.SizesX[MissIdx] > 0.f && Infos.SizesY[MissIdx] > 0.f)
+                {
+                    Buffers[MissIdx]    = RasterizeGlyphForAtlas(Infos.GlyphIndices[MissIdx], Infos.Advances[MissIdx], 0.f, RasterFont, Backend, Generator, &Layouts[MissIdx]);
+                    Rectangles[MissIdx] = GetGlyphAtlasRectangle(Buffers[MissIdx], MissIds[MissIdx], Generator);
+                }
+            }
+
+            if(Generator.TextStorage != TextStorage::FixedGrid)
+            {
+                PackGlyphRectangles(Rectangles, Pages, MissCount, Generator);
+            }
+
+            for(uint32_t MissIdx = 0; MissIdx < MissCount; ++MissIdx)
+            {
+                if(MissIds[MissIdx] == GlyphTableInvalidEntry)
+                {
+                    continue;
+                }
+
+                // Glyphs without ink (spaces) are complete as soon as we know their layout.
+
+                bool IsRasterized = true;
+
+                if(Infos.SizesX[MissIdx] > 0.f && Infos.SizesY[MissIdx] > 0.f)
+                {
+                    IsRasterized = CommitGlyphToAtlas(Buffers[MissIdx], Rectangles[MissIdx], Pages[MissIdx], Generator, Run.UpdateList, &Sources[MissIdx]);
+                }
+
+                UpdateGlyphTableEntry(MissIds[MissIdx], IsRasterized, Infos.GlyphIndices[MissIdx], Layouts[MissIdx], Sources[MissIdx], Pages[MissIdx],
+                                      Generator.GlyphTable);
+            }
+
+            for(uint32_t Idx = 0; Idx < PendingCount; ++Idx)
+            {
+                uint32_t      MissIdx = PendingMisses[Idx];
+                shaped_glyph &Glyph   = Run.Shaped[PendingShaped[Idx]];
+
+                Glyph.GlyphIndex = Infos.GlyphIndices[MissIdx];
+                Glyph.AtlasPage  = Pages[MissIdx];
+                Glyph.Source     = Sources[MissIdx];
+                Glyph.Layout     = Layouts[MissIdx];
+            }
+        }
+
+        // Now that every advance is known, walk the pen and swap inked glyphs for the variant of the bin they land in.
+        // The bin's shift is taken out of OffsetX since the bitmap already carries it. When rounding carries into the
+        // next pixel (bin 0 again) nothing is taken out, and the renderer rounding the pen gives that pixel.
+        // The pen starts at 0: variants are only right for runs drawn from a whole pixel.
+
+        if(Generator.SubpixelBins > 1)
+        {
+            float Bins = static_cast<float>(Generator.SubpixelBins);
+            float PenX = 0.f;
+
+            for(uint32_t Idx = 0; Idx < Run.ShapedCount; ++Idx)
+            {
+                shaped_glyph &Glyph = Run.Shaped[Idx];
+
+                float    Fraction = PenX - floorf(PenX);
+                uint32_t Step     = static_cast<uint32_t>(Fraction * Bins + 0.5f);
+                uint32_t Bin      = Step % Generator.SubpixelBins;
+
+                PenX += Glyph.Layout.Advance;
+
+                if(Glyph.Source.Right <= Glyph.Source.Left)
                 {
-                    // This is just wrong. At least, what we return from the packer is confusing.
-        
-                    rectangle Source =
-                    {
-                        .Left   = static_cast<float>(Rectangle.X),
-                        .Top    = static_cast<float>(Rectangle.Y),
-                        .Right  = static_cast<float>(Rectangle.X + Rectangle.Width ),
-                        .Bottom = static_cast<float>(Rectangle.Y + Rectangle.Height),
-                    };
-        
-                    rasterized_buffer Buffer = RasterizeGlyphToAlphaTexture(Info.GlyphIndex, Info.Advance, Font, Backend, Generator.Arena);
-        
-                    if(Buffer.BytesPerPixel == 1 && Buffer.Data)
+                    continue;
+                }
+
+                if(Bin)
+                {
+                    uint32_t    Codepoint = Analysed.Codepoints[Glyph.ClusterStart];
+                    glyph_hash  Hash      = ComputeSingleGlyphHash(Codepoint, MakeGlyphKey(Font, Generator.TextStorage, Bin), DefaultSeed);
+                    glyph_state State     = FindGlyphEntryByHash(Hash, Generator.GlyphTable);
+
+                    RecordGlyphEviction(State, Run, Generator);
+
+                    if(State.Id != GlyphTableInvalidEntry && !State.IsRasterized)
                     {
-                        auto *Node = PushStruct<rasterized_glyph_node>(Generator.Arena);
-                        if(Node)
-                        {
-                            rasterized_glyph_list &List = Run.UpdateList;
-        
-                            Node->Value.Buffer = Buffer;
-                            Node->Value.Source = Source;
-        
-                            if(!List.First)
-                            {
-                                List.First = Node;
-                            }
-        
-                            if(List.Last)
-                            {
-                                List.Last->Next = Node;
-                            }
-        
-                            List.Last   = Node;
-                            List.Count += 1;
-                        }
+                        // Same glyph, same origin. Only the outline moves right inside the bitmap.
+
+                        glyph_layout_info Layout = Glyph.Layout;
+                        rectangle         Source    = {};
+                        uint16_t          AtlasPage = 0;
+
+                        State.IsRasterized = RasterizeGlyphIntoAtlas(Glyph.GlyphIndex, Layout.Advance, static_cast<float>(Bin) / Bins, State.Id, RasterFont,
+                                                                     Backend, Generator, Run.UpdateList, &Layout, &Source, &AtlasPage);
+                        State.Source       = Source;
+                        State.AtlasPage    = AtlasPage;
+
+                        UpdateGlyphTableEntry(State.Id, State.IsRasterized, Glyph.GlyphIndex, Layout, Source, AtlasPage, Generator.GlyphTable);
                     }
-        
-                    glyph_layout_info LayoutInfo =
+
+                    // Out of atlas space: the whole pixel variant is still better than nothing, as it is.
+                    if(State.IsRasterized)
                     {
-                        .Advance = Info.Advance,
-                        .OffsetX = Info.OffsetX,
-                        .OffsetY = Info.OffsetY,
-                    };
-        
-                    State = UpdateGlyphTableEntry(State.Id, 1, Info.GlyphIndex, LayoutInfo, Source, Generator.GlyphTable);
+                        Glyph.Source          = State.Source;
+                        Glyph.AtlasPage       = State.AtlasPage;
+                        Glyph.Layout.OffsetX -= static_cast<float>(Bin) / Bins;
+                    }
                 }
             }
-        
-            Run.Shaped[Run.ShapedCount++] = 
+        }
+
+        if(IsSDF)
+        {
+            for(uint32_t Idx = 0; Idx < Run.ShapedCount; ++Idx)
             {
-                .GlyphIndex   = State.GlyphIndex,
-                .Source       = State.Source,
-                .Layout       = State.Layout,
-                .ClusterStart = Idx,
-                .ClusterCount = 1,
-            };
+                Run.Shaped[Idx].Layout.Advance *= OutputScale;
+                Run.Shaped[Idx].Layout.OffsetX *= OutputScale;
+                Run.Shaped[Idx].Layout.OffsetY *= OutputScale;
+            }
+
+            // The copy may have resolved glyph index pages, the table they were written to is shared.
+            for(uint32_t Idx = 0; Idx < sizeof(RasterInfo.ResolvedPages) / sizeof(uint64_t); ++Idx)
+            {
+                Font.Info->ResolvedPages[Idx] |= RasterInfo.ResolvedPages[Idx];
+            }
         }
     }
     else
@@ -1544,6 +6183,7 @@ FillAtlas(analysed_text Analysed, glyph_generator &Generator, system_font Font,
         NTEXT_ASSERT(!"TODO: Implement Complex String Parsing");
     }
 
+    UnpinGlyphTable(Generator.GlyphTable);
 
     return Run;
 }
@@ -1582,4 +6222,522 @@ AdvanceWord(word_glyph_cursor &Cursor, const word_slice &Slice)
 }
 
 
+// ==================================================================================
+// @Public : NText Atlas Compaction
+// The skyline never gets back what is freed under it, so a page slowly fills with holes.
+// Compaction moves the live glyphs of such a page into an empty one, a few per call,
+// and hands the emptied page back to the packer.
+// ==================================================================================
+
+// The open page with the most released area, if that is at least a quarter of a page. -1 otherwise.
+
+static int32_t
+PickAtlasPageToCompact(glyph_generator &Generator)
+{
+    int32_t  Result = -1;
+    uint64_t Best   = 0;
+
+    for(uint32_t Page = 0; Page < Generator.AtlasPageCount; ++Page)
+    {
+        rectangle_packer *Packer    = Generator.Packers[Page];
+        uint64_t          Threshold = (static_cast<uint64_t>(Packer->Width) * Packer->Height) / 4;
+
+        if(Packer->ReleasedArea >= Threshold && Packer->ReleasedArea > Best)
+        {
+            Best   = Packer->ReleasedArea;
+            Result = static_cast<int32_t>(Page);
+        }
+    }
+
+    return Result;
+}
+
+
+// Needs an empty page to move into: an open one that is empty or one that was never opened.
+
+static bool
+BeginAtlasCompaction(uint32_t Page, glyph_generator &Generator)
+{
+    atlas_compaction &Compaction = Generator.Compaction;
+
+    if(Compaction.IsActive || Page >= Generator.AtlasPageCount)
+    {
+        return false;
+    }
+
+    int32_t ToPage = -1;
+    for(uint32_t Candidate = 0; Candidate < Generator.AtlasPageCount && ToPage < 0; ++Candidate)
+    {
+        if(Candidate != Page && IsRectanglePackerEmpty(Generator.Packers[Candidate]))
+        {
+            ToPage = static_cast<int32_t>(Candidate);
+        }
+    }
+
+    if(ToPage < 0 && Generator.AtlasPageCount < Generator.AtlasMaxPageCount)
+    {
+        ToPage = static_cast<int32_t>(Generator.AtlasPageCount++);
+    }
+
+    if(ToPage < 0)
+    {
+        return false;
+    }
+
+    Compaction =
+    {
+        .IsActive  = true,
+        .HasFailed = false,
+        .FromPage  = static_cast<uint16_t>(Page),
+        .ToPage    = static_cast<uint16_t>(ToPage),
+        .Cursor    = 0,
+        .Table     = Generator.GlyphTable,
+    };
+
+    return true;
+}
+
+
+// Moves up to Budget glyphs and returns the copies the renderer has to make before drawing runs
+// shaped from now on, and before applying their update lists. Runs shaped earlier may point at the old places.
+// Every move releases its old place on the source page, which takes nothing new until the compaction is over.
+// Once every slot was visited the source page is reset, unless the target page ran out of space on the way:
+// then the page stays as it is, with whatever was moved out of it released. Nothing happens while the table is growing.
+
+static atlas_move_list
+CompactAtlas(uint32_t Budget, glyph_generator &Generator)
+{
+    atlas_move_list   Result     = {};
+    atlas_compaction &Compaction = Generator.Compaction;
+    glyph_table      *Table      = Generator.GlyphTable;
+
+    if(!Compaction.IsActive || Table->Previous)
+    {
+        return Result;
+    }
+
+    if(Compaction.Table != Table)
+    {
+        Compaction.Table  = Table;
+        Compaction.Cursor = 0;
+    }
+
+    rectangle_packer *Target    = Generator.Packers[Compaction.ToPage];
+    uint64_t          SlotCount = Table->GroupCount * Table->GroupWidth;
+
+    BeginGlyphTableWrite(Table);
+
+    for(; Compaction.Cursor < SlotCount && Result.Count < Budget; ++Compaction.Cursor)
+    {
+        uint8_t      Meta  = Table->Metadata[Compaction.Cursor];
+        glyph_entry *Entry = GetGlyphEntry(Compaction.Cursor, Table);
+
+        bool IsLive = (Meta & (GlyphTableEmptyMask | GlyphTableDeadMask)) == 0;
+        if(!IsLive || Entry->AtlasPage != Compaction.FromPage || !Entry->IsRasterized || Entry->Source.Right <= Entry->Source.Left)
+        {
+            continue;
+        }
+
+        packed_rectangle Rectangle =
+        {
+            .Width  = static_cast<uint16_t>(Entry->Source.Right  - Entry->Source.Left),
+            .Height = static_cast<uint16_t>(Entry->Source.Bottom - Entry->Source.Top),
+        };
+
+        PackRectangle(Rectangle, Target);
+
+        if(!Rectangle.WasPacked)
+        {
+            Compaction.HasFailed = true;
+            continue;
+        }
+
+        rectangle To =
+        {
+            .Left   = static_cast<float>(Rectangle.X),
+            .Top    = static_cast<float>(Rectangle.Y),
+            .Right  = static_cast<float>(Rectangle.X + Rectangle.Width),
+            .Bottom = static_cast<float>(Rectangle.Y + Rectangle.Height),
+        };
+
+        auto *Node = PushStruct<atlas_move_node>(Generator.Arena);
+        if(!Node)
+        {
+            ReleasePackedRectangle(To, Target);
+            break;
+        }
+
+        Node->Next           = 0;
+        Node->Value.FromPage = Compaction.FromPage;
+        Node->Value.From     = Entry->Source;
+        Node->Value.ToPage   = Compaction.ToPage;
+        Node->Value.To       = To;
+
+        ReleasePackedRectangle(Entry->Source, Generator.Packers[Compaction.FromPage]);
+
+        Entry->Source    = To;
+        Entry->AtlasPage = static_cast<uint8_t>(Compaction.ToPage);
+
+        if(!Result.First)
+        {
+            Result.First = Node;
+        }
+
+        if(Result.Last)
+        {
+            Result.Last->Next = Node;
+        }
+
+        Result.Last   = Node;
+        Result.Count += 1;
+    }
+
+    // Anything caching entries (the direct pages) has to look them up again.
+    if(Result.Count)
+    {
+        Table->Epoch += 1;
+    }
+
+    EndGlyphTableWrite(Table);
+
+    if(Compaction.Cursor == SlotCount)
+    {
+        if(!Compaction.HasFailed)
+        {
+            ResetRectanglePacker(Generator.Packers[Compaction.FromPage]);
+        }
+
+        Compaction.IsActive = false;
+    }
+
+    return Result;
+}
+
+
+// ==================================================================================
+// @Public : NText Glyph Cache Snapshots
+// Warm starts. The glyph table, the packer and the atlas pixels go to one file that
+// is mapped and copied back on the next start, so nothing needs to be rasterized again.
+// ==================================================================================
+
+// Key is up to the caller. It should cover whatever the cached glyphs depend on outside of the
+// generator, usually the fonts (ComputeFontId) and sizes in use. Entries are already keyed on font and
+// size, so a glyph the next run never asks for costs nothing but its slot.
+//
+// The sections follow the header back to back, in this order: metadata, hashes, LRU links,
+// payloads, the packer state of every open page (see GetRectanglePackerState), atlas pixels.
+
+constexpr uint32_t GlyphCacheMagic   = 0x4347544E; // 'NTGC'
+constexpr uint32_t GlyphCacheVersion = 4;
+
+
+struct glyph_cache_header
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t HashKind;
+    uint32_t EntrySize;
+    uint64_t Key;
+
+    uint32_t TextStorage;
+    uint32_t SubpixelBins;
+    float    SDFReferenceSize;
+    uint32_t SDFSpread;
+    uint32_t GridCellSizeX;
+    uint32_t GridCellSizeY;
+
+    uint64_t GroupWidth;
+    uint64_t GroupCount;
+    uint32_t Count;
+    uint32_t DeadCount;
+
+    uint32_t PackerKind;
+    uint32_t PackerWidth;
+    uint32_t PackerHeight;
+    uint32_t AtlasPageCount;
+    uint32_t AtlasMaxPageCount;
+    uint32_t PackerCounts[GlyphAtlasMaxPages];
+    uint64_t ReleasedAreas[GlyphAtlasMaxPages];
+
+    uint64_t AtlasSize;
+};
+
+
+// Once LoadGlyphCache succeeded, AtlasPixels (AtlasSize bytes, every page in whatever format was saved)
+// has to be uploaded before the first draw. It points into File, which the caller unmaps after that.
+
+struct glyph_cache_snapshot
+{
+    bool           IsLoaded;
+    const uint8_t *AtlasPixels;
+    uint64_t       AtlasSize;
+    mapped_file    File;
+};
+
+
+static bool
+DoesGlyphCacheMatchGenerator(const glyph_cache_header &Header, glyph_generator &Generator)
+{
+    rectangle_packer *Packer = Generator.Packers[0];
+
+    bool Result = Header.Magic             == GlyphCacheMagic                              &&
+                  Header.Version           == GlyphCacheVersion                            &&
+                  Header.HashKind          == GlyphHashKind                                &&
+                  Header.EntrySize         == sizeof(glyph_entry)                          &&
+                  Header.TextStorage       == static_cast<uint32_t>(Generator.TextStorage) &&
+                  Header.SubpixelBins      == Generator.SubpixelBins                       &&
+                  Header.SDFReferenceSize  == Generator.SDFReferenceSize                   &&
+                  Header.SDFSpread         == Generator.SDFSpread                          &&
+                  Header.GridCellSizeX     == Generator.GridCellSizeX                      &&
+                  Header.GridCellSizeY     == Generator.GridCellSizeY                      &&
+                  Header.GroupWidth        == Generator.GlyphTable->GroupWidth             &&
+                  Header.PackerKind        == (Packer ? static_cast<uint32_t>(Packer->Kind) : 0u) &&
+                  Header.PackerWidth       == (Packer ? Packer->Width  : 0u)               &&
+                  Header.PackerHeight      == (Packer ? Packer->Height : 0u)               &&
+                  Header.AtlasMaxPageCount == Generator.AtlasMaxPageCount                  &&
+                  Header.AtlasPageCount    <= Generator.AtlasMaxPageCount;
+
+    return Result;
+}
+
+
+// AtlasPixels is the caller's copy of the atlas, since the library never sees it whole.
+// A growing table is drained first.
+
+static bool
+SaveGlyphCache(const char *Path, uint64_t Key, glyph_generator &Generator, const void *AtlasPixels, uint64_t AtlasSize)
+{
+    NTEXT_ASSERT(IsValidGlyphGenerator(Generator));
+
+    glyph_table      *Table  = Generator.GlyphTable;
+    rectangle_packer *Packer = Generator.Packers[0];
+
+    if(Table->Previous)
+    {
+        MigrateGlyphEntries(Table, Table->Previous->Count);
+    }
+
+    uint64_t SlotCount = Table->GroupCount * Table->GroupWidth;
+
+    glyph_cache_header Header =
+    {
+        .Magic             = GlyphCacheMagic,
+        .Version           = GlyphCacheVersion,
+        .HashKind          = GlyphHashKind,
+        .EntrySize         = sizeof(glyph_entry),
+        .Key               = Key,
+        .TextStorage       = static_cast<uint32_t>(Generator.TextStorage),
+        .SubpixelBins      = Generator.SubpixelBins,
+        .SDFReferenceSize  = Generator.SDFReferenceSize,
+        .SDFSpread         = Generator.SDFSpread,
+        .GridCellSizeX     = Generator.GridCellSizeX,
+        .GridCellSizeY     = Generator.GridCellSizeY,
+        .GroupWidth        = Table->GroupWidth,
+        .GroupCount        = Table->GroupCount,
+        .Count             = Table->Count,
+        .DeadCount         = Table->DeadCount,
+        .PackerKind        = Packer ? static_cast<uint32_t>(Packer->Kind) : 0u,
+        .PackerWidth       = Packer ? Packer->Width  : 0u,
+        .PackerHeight      = Packer ? Packer->Height : 0u,
+        .AtlasPageCount    = Generator.AtlasPageCount,
+        .AtlasMaxPageCount = Generator.AtlasMaxPageCount,
+        .AtlasSize         = AtlasPixels ? AtlasSize : 0u,
+    };
+
+    file_chunk Chunks[5 + 2 * GlyphAtlasMaxPages + 1] =
+    {
+        {&Header,          sizeof(Header)},
+        {Table->Metadata,  SlotCount * sizeof(uint8_t)},
+        {Table->Hashes,    SlotCount * sizeof(glyph_hash)},
+        {Table->Links,     (SlotCount + 1) * sizeof(glyph_lru_link)},
+        {Table->Buckets,   SlotCount * sizeof(glyph_entry)},
+    };
+    uint32_t ChunkCount = 5;
+
+    for(uint32_t Page = 0; Page < Generator.AtlasPageCount; ++Page)
+    {
+        rectangle_packer *PagePacker = Generator.Packers[Page];
+
+        Header.ReleasedAreas[Page] = PagePacker->ReleasedArea;
+        ChunkCount                += GetRectanglePackerState(PagePacker, &Chunks[ChunkCount], &Header.PackerCounts[Page]);
+    }
+
+    Chunks[ChunkCount++] = {AtlasPixels, Header.AtlasSize};
+
+    bool Result = WriteFileFromChunks(Path, Chunks, ChunkCount);
+    return Result;
+}
+
+
+// The table sections are copied as they are, so anything they index with has to be in range before that:
+// every LRU link, the full and dead counts, the atlas page of every payload and the source of every
+// rasterized one, which has to lie in a CacheSizeX * CacheSizeY page. Sections follow Header in the file.
+
+static bool
+IsGlyphCacheTableValid(const glyph_cache_header &Header, const uint8_t *Sections, uint16_t CacheSizeX, uint16_t CacheSizeY)
+{
+    uint64_t SlotCount = Header.GroupCount * Header.GroupWidth;
+    uint32_t PageCount = Header.AtlasPageCount ? Header.AtlasPageCount : 1;
+
+    const uint8_t *Metadata = Sections;
+    const uint8_t *Links    = Metadata + SlotCount * sizeof(uint8_t) + SlotCount * sizeof(glyph_hash);
+    const uint8_t *Buckets  = Links    + (SlotCount + 1) * sizeof(glyph_lru_link);
+
+    uint64_t FullCount = 0;
+    uint64_t DeadCount = 0;
+
+    for(uint64_t Idx = 0; Idx < SlotCount; ++Idx)
+    {
+        uint8_t Meta = Metadata[Idx];
+
+        FullCount += (Meta & (GlyphTableEmptyMask | GlyphTableDeadMask)) == 0;
+        DeadCount += (Meta & GlyphTableDeadMask) != 0;
+    }
+
+    bool Result = FullCount == Header.Count && DeadCount == Header.DeadCount;
+
+    for(uint64_t Idx = 0; Result && Idx <= SlotCount; ++Idx)
+    {
+        glyph_lru_link Link;
+        memcpy(&Link, Links + Idx * sizeof(glyph_lru_link), sizeof(Link));
+
+        Result = Link.PrevLRU <= SlotCount && Link.NextLRU <= SlotCount;
+    }
+
+    for(uint64_t Idx = 0; Result && Idx < SlotCount; ++Idx)
+    {
+        glyph_entry Entry;
+        memcpy(&Entry, Buckets + Idx * sizeof(glyph_entry), sizeof(Entry));
+
+        Result = Entry.AtlasPage < PageCount;
+
+        if(Result && Entry.IsRasterized && (Metadata[Idx] & (GlyphTableEmptyMask | GlyphTableDeadMask)) == 0)
+        {
+            rectangle Source = Entry.Source;
+
+            Result = Source.Left >= 0.f && Source.Top >= 0.f && Source.Left <= Source.Right && Source.Top <= Source.Bottom &&
+                     Source.Right <= CacheSizeX && Source.Bottom <= CacheSizeY;
+        }
+    }
+
+    return Result;
+}
+
+
+// Replaces the content of the generator with the snapshot at Path, if it was saved by a generator
+// created with the same parameters and under the same Key. A table larger than the current one
+// is only accepted when the generator could have grown to it. Call it before the first FillAtlas.
+
+static glyph_cache_snapshot
+LoadGlyphCache(const char *Path, uint64_t Key, glyph_generator &Generator)
+{
+    NTEXT_ASSERT(IsValidGlyphGenerator(Generator));
+
+    glyph_cache_snapshot Result = {};
+
+    mapped_file File = MapFileReadOnly(Path);
+    if(!File.Data || File.Size < sizeof(glyph_cache_header))
+    {
+        UnmapFile(&File);
+        return Result;
+    }
+
+    glyph_cache_header Header;
+    memcpy(&Header, File.Data, sizeof(Header));
+
+    uint64_t SlotCount    = Header.GroupCount * Header.GroupWidth;
+    uint64_t MetadataSize = SlotCount * sizeof(uint8_t);
+    uint64_t HashesSize   = SlotCount * sizeof(glyph_hash);
+    uint64_t LinksSize    = (SlotCount + 1) * sizeof(glyph_lru_link);
+    uint64_t BucketsSize  = SlotCount * sizeof(glyph_entry);
+    uint64_t PackersSize  = 0;
+
+    for(uint32_t Page = 0; Page < Header.AtlasPageCount && Page < GlyphAtlasMaxPages; ++Page)
+    {
+        PackersSize += GetRectanglePackerStateSize(static_cast<RectanglePacker>(Header.PackerKind), Header.PackerCounts[Page]);
+    }
+
+    uint64_t ExpectedSize = sizeof(Header) + MetadataSize + HashesSize + LinksSize + BucketsSize + PackersSize + Header.AtlasSize;
+
+    glyph_table *Table    = Generator.GlyphTable;
+    bool         IsValid  = Header.Key == Key && DoesGlyphCacheMatchGenerator(Header, Generator) && File.Size == ExpectedSize;
+
+    IsValid = IsValid && !Table->Previous && Header.GroupCount && (Header.GroupCount & (Header.GroupCount - 1)) == 0;
+    IsValid = IsValid && (Header.GroupCount == Table->GroupCount || Header.GroupCount <= Generator.GlyphTableMaxGroupCount);
+    IsValid = IsValid && Header.Count <= SlotCount;
+    IsValid = IsValid && IsGlyphCacheTableValid(Header, File.Data + sizeof(Header), Generator.CacheSizeX, Generator.CacheSizeY);
+
+    const uint8_t *PackerState = File.Data + sizeof(Header) + MetadataSize + HashesSize + LinksSize + BucketsSize;
+    for(uint32_t Page = 0; IsValid && Page < Header.AtlasPageCount; ++Page)
+    {
+        rectangle_packer *Packer = Generator.Packers[Page];
+
+        IsValid      = IsRectanglePackerStateValid(PackerState, Header.PackerCounts[Page], Packer->Kind, Packer->Width, Packer->Height);
+        PackerState += GetRectanglePackerStateSize(Packer->Kind, Header.PackerCounts[Page]);
+    }
+
+    // Same as growing, without the migration.
+    if(IsValid && Header.GroupCount != Table->GroupCount)
+    {
+        IsValid = false;
+
+        if(Generator.GlyphTableArena && Header.GroupCount > Table->GroupCount && Header.GroupCount <= Generator.GlyphTableMaxGroupCount)
+        {
+            glyph_table_params Params = {.GroupWidth = static_cast<GlyphTableWidth>(Header.GroupWidth), .GroupCount = Header.GroupCount};
+            void              *Memory = PushArena(Generator.GlyphTableArena, GetGlyphTableFootprint(Params), AlignOf(void *));
+
+            if(Memory)
+            {
+                glyph_table *Loaded = PlaceGlyphTableInMemory(Params, Memory);
+
+                Loaded->Epoch        = Table->Epoch + 1;
+                Generator.GlyphTable = Loaded;
+                Table                = Loaded;
+                IsValid              = true;
+            }
+        }
+    }
+
+    if(IsValid)
+    {
+        uint8_t *At = File.Data + sizeof(Header);
+
+        BeginGlyphTableWrite(Table);
+
+        memcpy(Table->Metadata, At, MetadataSize); At += MetadataSize;
+        memcpy(Table->Hashes,   At, HashesSize);   At += HashesSize;
+        memcpy(Table->Links,    At, LinksSize);    At += LinksSize;
+        memcpy(Table->Buckets,  At, BucketsSize);  At += BucketsSize;
+
+        Table->Count     = Header.Count;
+        Table->DeadCount = Header.DeadCount;
+        Table->Epoch    += 1;
+
+        EndGlyphTableWrite(Table);
+
+        for(uint32_t Page = 0; Page < Header.AtlasPageCount; ++Page)
+        {
+            rectangle_packer *Packer = Generator.Packers[Page];
+
+            At                  += LoadRectanglePackerState(At, Header.PackerCounts[Page], Packer);
+            Packer->ReleasedArea = Header.ReleasedAreas[Page];
+        }
+
+        Generator.AtlasPageCount = Header.AtlasPageCount;
+        Generator.Compaction     = {};
+
+        Result.IsLoaded    = true;
+        Result.AtlasPixels = At;
+        Result.AtlasSize   = Header.AtlasSize;
+        Result.File        = File;
+    }
+    else
+    {
+        UnmapFile(&File);
+    }
+
+    return Result;
+}
+
+
 } // namespace ntext
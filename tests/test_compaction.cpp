@@ -0,0 +1,342 @@
+// Compacting a page moves its live glyphs to another one and accounts for the area they leave. When
+// every glyph moved, the page is empty again. When the target page runs out of space half way, the
+// page keeps what did not move, and the place of everything that did is released: counted in
+// ReleasedArea, or back on the free list of the packers that have one. Either way every glyph still
+// shows the pixels it was rasterized with.
+
+#include "../bench/bench.h"
+
+using namespace ntext;
+
+constexpr uint16_t TestPageSize  = 256;
+constexpr uint32_t TestPageCount = 3;
+constexpr uint64_t TestPageArea  = static_cast<uint64_t>(TestPageSize) * TestPageSize;
+
+
+struct test_atlas
+{
+    uint8_t Pages[TestPageCount][TestPageArea];
+};
+
+
+struct test_generator
+{
+    glyph_generator Generator;
+    system_font     Font;
+    test_atlas     *Atlas;
+};
+
+
+static test_generator
+CreateTestGenerator(RectanglePacker Packer, const char *FontPath, backend_context Backend)
+{
+    glyph_generator_params Params =
+    {
+        .TextStorage       = TextStorage::LazyAtlas,
+        .FrameMemoryBudget = 64ull << 20,
+        .FrameMemory       = malloc(64ull << 20),
+        .CacheSizeX        = TestPageSize,
+        .CacheSizeY        = TestPageSize,
+        .AtlasPageCount    = TestPageCount,
+        .AtlasPacker       = Packer,
+    };
+
+    test_generator Result = {};
+    Result.Generator = CreateGlyphGenerator(Params);
+    Result.Font      = LoadFontFromFile(FontPath, 20.f, Result.Generator.Arena, Backend);
+    Result.Atlas     = static_cast<test_atlas *>(calloc(1, sizeof(test_atlas)));
+
+    return Result;
+}
+
+
+static void
+ReleaseTestGenerator(test_generator &Test, backend_context Backend)
+{
+    ReleaseFont(&Test.Font, Backend);
+    free(Test.Atlas);
+    free(Test.Generator.Arena);
+}
+
+
+static void
+ApplyUpdateList(rasterized_glyph_list &List, test_atlas *Atlas)
+{
+    for(rasterized_glyph_node *Node = List.First; Node; Node = Node->Next)
+    {
+        rasterized_buffer &Buffer = Node->Value.Buffer;
+        uint32_t           Stride = Buffer.Stride ? Buffer.Stride : Buffer.Width;
+        uint8_t           *Plane  = Atlas->Pages[Node->Value.AtlasPage];
+
+        for(uint32_t Y = 0; Y < Buffer.Height; ++Y)
+        {
+            uint64_t Offset = (static_cast<uint64_t>(Node->Value.Source.Top) + Y) * TestPageSize + static_cast<uint64_t>(Node->Value.Source.Left);
+            memcpy(Plane + Offset, static_cast<uint8_t *>(Buffer.Data) + (Y * Stride), Buffer.Width);
+        }
+    }
+}
+
+
+// Sums the areas the moves leave on their source page.
+
+static uint64_t
+ApplyMoveList(atlas_move_list &List, test_atlas *Atlas)
+{
+    uint64_t Result = 0;
+
+    for(atlas_move_node *Node = List.First; Node; Node = Node->Next)
+    {
+        atlas_move &Move   = Node->Value;
+        uint32_t    Width  = static_cast<uint32_t>(Move.From.Right  - Move.From.Left);
+        uint32_t    Height = static_cast<uint32_t>(Move.From.Bottom - Move.From.Top);
+
+        for(uint32_t Y = 0; Y < Height; ++Y)
+        {
+            uint64_t From = (static_cast<uint64_t>(Move.From.Top) + Y) * TestPageSize + static_cast<uint64_t>(Move.From.Left);
+            uint64_t To   = (static_cast<uint64_t>(Move.To.Top)   + Y) * TestPageSize + static_cast<uint64_t>(Move.To.Left);
+            memcpy(Atlas->Pages[Move.ToPage] + To, Atlas->Pages[Move.FromPage] + From, Width);
+        }
+
+        Result += static_cast<uint64_t>(Width) * Height;
+    }
+
+    return Result;
+}
+
+
+// Codepoints U+0021 + [First, First + Count) every Step, each once.
+
+static int
+EncodeTestText(uint32_t First, uint32_t Count, uint32_t Step, char *Out)
+{
+    int Result = 0;
+    for(uint32_t Idx = First; Idx < First + Count; Idx += Step)
+    {
+        uint32_t Codepoint = 0x21 + Idx;
+
+        if(Codepoint < 0x80)
+        {
+            Out[Result++] = static_cast<char>(Codepoint);
+        }
+        else
+        {
+            Out[Result++] = static_cast<char>(0xC0 | (Codepoint >> 6));
+            Out[Result++] = static_cast<char>(0x80 | (Codepoint & 0x3F));
+        }
+    }
+
+    return Result;
+}
+
+
+static shaped_glyph_run
+FillTestAtlas(char *Text, int TextSize, test_generator &Test, backend_context Backend)
+{
+    analysed_text    Analysed = AnalyzeText(Text, TextSize, TextAnalysis::SkipComplexCheck, Test.Generator);
+    shaped_glyph_run Result   = FillAtlas(Analysed, Test.Generator, Test.Font, Backend);
+
+    ApplyUpdateList(Result.UpdateList, Test.Atlas);
+
+    return Result;
+}
+
+
+// What a page has left to give: the released area, plus the free list of the packers that keep one
+// (Guillotine rectangles never overlap, so their areas add up).
+
+static uint64_t
+GetReclaimableArea(rectangle_packer *Packer)
+{
+    uint64_t Result = Packer->ReleasedArea;
+
+    if(Packer->Kind == RectanglePacker::Guillotine)
+    {
+        for(uint32_t Idx = 0; Idx < Packer->FreeCount; ++Idx)
+        {
+            Result += static_cast<uint64_t>(Packer->FreeRects[Idx].Width) * Packer->FreeRects[Idx].Height;
+        }
+    }
+
+    return Result;
+}
+
+
+// Every glyph of Run has to show, in Atlas, what Expected showed in ExpectedAtlas.
+
+static uint32_t
+CountImageMismatches(shaped_glyph_run &Run, test_atlas *Atlas, shaped_glyph_run &Expected, test_atlas *ExpectedAtlas)
+{
+    uint32_t Result = Run.ShapedCount != Expected.ShapedCount;
+
+    for(uint32_t Idx = 0; !Result && Idx < Run.ShapedCount; ++Idx)
+    {
+        shaped_glyph &Glyph = Run.Shaped[Idx];
+        shaped_glyph &Want  = Expected.Shaped[Idx];
+
+        uint32_t Width  = static_cast<uint32_t>(Glyph.Source.Right  - Glyph.Source.Left);
+        uint32_t Height = static_cast<uint32_t>(Glyph.Source.Bottom - Glyph.Source.Top);
+
+        bool IsSame = Width  == static_cast<uint32_t>(Want.Source.Right  - Want.Source.Left) &&
+                      Height == static_cast<uint32_t>(Want.Source.Bottom - Want.Source.Top);
+
+        for(uint32_t Y = 0; IsSame && Y < Height; ++Y)
+        {
+            const uint8_t *Row     = Atlas->Pages[Glyph.AtlasPage] +
+                                     (static_cast<uint64_t>(Glyph.Source.Top) + Y) * TestPageSize + static_cast<uint64_t>(Glyph.Source.Left);
+            const uint8_t *WantRow = ExpectedAtlas->Pages[Want.AtlasPage] +
+                                     (static_cast<uint64_t>(Want.Source.Top) + Y) * TestPageSize + static_cast<uint64_t>(Want.Source.Left);
+
+            IsSame = memcmp(Row, WantRow, Width) == 0;
+        }
+
+        Result += !IsSame;
+    }
+
+    return Result;
+}
+
+
+// Fills two pages, evicts every other glyph of the first 300 and compacts the first page. With
+// FillTarget, 300 other glyphs are shaped right after the compaction began: they land on the target
+// page, newest first, and leave it too little room for everything the source page holds.
+
+static uint32_t
+CheckCompaction(RectanglePacker PackerKind, bool FillTarget, const char *FontPath, backend_context Backend)
+{
+    test_generator Test = CreateTestGenerator(PackerKind, FontPath, Backend);
+
+    static char Text[600 * 2];
+    int         TextSize = EncodeTestText(0, 500, 1, Text);
+    FillTestAtlas(Text, TextSize, Test, Backend);
+
+    for(uint32_t Idx = 0; Idx < 300; Idx += 2)
+    {
+        RemoveCachedGlyph(0x21 + Idx, Test.Font, Test.Generator);
+    }
+
+    static char Kept[600 * 2];
+    int         KeptSize = EncodeTestText(1, 299, 2, Kept);
+    KeptSize += EncodeTestText(300, 200, 1, Kept + KeptSize);
+
+    uint32_t Failures = 0;
+
+    // Moves copy out of the source page without clearing it, the old run can be checked against this copy.
+    static test_atlas Before;
+    shaped_glyph_run  Expected = FillTestAtlas(Kept, KeptSize, Test, Backend);
+    memcpy(&Before, Test.Atlas, sizeof(Before));
+
+    glyph_generator &Generator = Test.Generator;
+    uint32_t         FromPage  = 0;
+
+    if(Expected.UpdateList.Count || !BeginAtlasCompaction(FromPage, Generator))
+    {
+        printf("%u: the compaction could not start\n", static_cast<uint32_t>(PackerKind));
+        Failures += 1;
+    }
+
+    if(FillTarget)
+    {
+        static char Other[300 * 2];
+        int         OtherSize = EncodeTestText(500, 300, 1, Other);
+        FillTestAtlas(Other, OtherSize, Test, Backend);
+    }
+
+    rectangle_packer *Source     = Generator.Packers[FromPage];
+    uint64_t          Reclaimed  = GetReclaimableArea(Source);
+    uint64_t          MovedArea  = 0;
+    uint32_t          MoveCount  = 0;
+
+    while(!Failures && Generator.Compaction.IsActive)
+    {
+        atlas_move_list Moves = CompactAtlas(16, Generator);
+
+        for(atlas_move_node *Node = Moves.First; Node; Node = Node->Next)
+        {
+            Failures += Node->Value.FromPage != FromPage || Node->Value.ToPage != Generator.Compaction.ToPage;
+        }
+
+        MovedArea += ApplyMoveList(Moves, Test.Atlas);
+        MoveCount += Moves.Count;
+    }
+
+    bool HasFailed = Generator.Compaction.HasFailed;
+
+    if(HasFailed != FillTarget || !MoveCount)
+    {
+        printf("%u: expected the compaction to %s, it moved %u glyphs and %s\n", static_cast<uint32_t>(PackerKind),
+               FillTarget ? "fail" : "succeed", MoveCount, HasFailed ? "failed" : "succeeded");
+        Failures += 1;
+    }
+
+    if(!HasFailed && (!IsRectanglePackerEmpty(Source) || Source->ReleasedArea))
+    {
+        printf("%u: the source page was not reset\n", static_cast<uint32_t>(PackerKind));
+        Failures += 1;
+    }
+
+    // MaxRects keeps overlapping free rectangles, only the area counted as released can be checked there.
+    bool IsAreaExact = PackerKind != RectanglePacker::MaxRects;
+
+    if(HasFailed && IsAreaExact && GetReclaimableArea(Source) != Reclaimed + MovedArea)
+    {
+        printf("%u: %llu reclaimable after moving %llu out, %llu before\n", static_cast<uint32_t>(PackerKind),
+               static_cast<unsigned long long>(GetReclaimableArea(Source)), static_cast<unsigned long long>(MovedArea),
+               static_cast<unsigned long long>(Reclaimed));
+        Failures += 1;
+    }
+
+    // Whatever moved, every glyph kept has its pixels where the table now points.
+    shaped_glyph_run After = FillTestAtlas(Kept, KeptSize, Test, Backend);
+
+    uint32_t Mismatches = CountImageMismatches(After, Test.Atlas, Expected, &Before);
+    uint32_t LeftOnPage = 0;
+
+    for(uint32_t Idx = 0; Idx < After.ShapedCount; ++Idx)
+    {
+        LeftOnPage += After.Shaped[Idx].AtlasPage == FromPage && After.Shaped[Idx].Source.Right > After.Shaped[Idx].Source.Left;
+    }
+
+    if(Mismatches || (!HasFailed && LeftOnPage))
+    {
+        printf("%u: %u glyphs do not match, %u left on the source page\n", static_cast<uint32_t>(PackerKind), Mismatches, LeftOnPage);
+        Failures += 1;
+    }
+
+    printf("packer %u, %s target: %u moves, %llu texels moved, %u left on the source page, %u failures\n",
+           static_cast<uint32_t>(PackerKind), FillTarget ? "full" : "empty", MoveCount,
+           static_cast<unsigned long long>(MovedArea), LeftOnPage, Failures);
+
+    ReleaseTestGenerator(Test, Backend);
+
+    return Failures;
+}
+
+
+int main()
+{
+    const char     *FontPath = NTEXT_BENCH_FONT_DIR "DejaVuSans.ttf";
+    backend_context Backend  = InitializeBackendContext();
+
+    memory_arena *Probe     = CreateBenchArena(16ull << 20);
+    system_font   ProbeFont = Probe ? LoadFontFromFile(FontPath, 16.f, Probe, Backend) : system_font{};
+
+    if(!IsValidSystemFont(&ProbeFont))
+    {
+        printf("skipped: %s could not be loaded\n", FontPath);
+        return 0;
+    }
+
+    ReleaseFont(&ProbeFont, Backend);
+    free(Probe);
+
+    RectanglePacker Packers[] = {RectanglePacker::Skyline, RectanglePacker::Shelf, RectanglePacker::Guillotine, RectanglePacker::MaxRects};
+
+    uint32_t Failures = 0;
+    for(RectanglePacker Packer : Packers)
+    {
+        Failures += CheckCompaction(Packer, false, FontPath, Backend);
+        Failures += CheckCompaction(Packer, true,  FontPath, Backend);
+    }
+
+    return Failures ? 1 : 0;
+}
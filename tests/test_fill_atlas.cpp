@@ -0,0 +1,287 @@
+// A run holding more unique glyphs than the glyph table can keep must not evict itself: every
+// shaped glyph with a source has to find its own pixels there once the update list is applied, and
+// its layout has to match a generator large enough to hold the whole run. Glyphs that did not fit
+// keep their advance and get no source. With subpixel bins, a glyph whose variant did not fit is
+// the whole-pixel glyph with its whole-pixel layout.
+
+#include "../bench/bench.h"
+
+using namespace ntext;
+
+constexpr uint16_t TestAtlasSize  = 2048;
+constexpr uint32_t TestAtlasPages = 2;
+constexpr uint32_t TestGlyphCount = 1400;
+
+
+struct test_atlas
+{
+    uint8_t *Pages[TestAtlasPages];
+};
+
+
+struct test_generator
+{
+    glyph_generator Generator;
+    system_font     Font;
+    test_atlas      Atlas;
+};
+
+
+static test_generator
+CreateTestGenerator(uint32_t MaxGroupCount, uint8_t SubpixelBins, const char *FontPath, backend_context Backend)
+{
+    glyph_generator_params Params =
+    {
+        .TextStorage             = TextStorage::LazyAtlas,
+        .FrameMemoryBudget       = 256ull << 20,
+        .FrameMemory             = malloc(256ull << 20),
+        .CacheSizeX              = TestAtlasSize,
+        .CacheSizeY              = TestAtlasSize,
+        .SubpixelBins            = SubpixelBins,
+        .GlyphTableMaxGroupCount = MaxGroupCount,
+        .AtlasPageCount          = TestAtlasPages,
+    };
+
+    test_generator Result = {};
+    Result.Generator = CreateGlyphGenerator(Params);
+    Result.Font      = LoadFontFromFile(FontPath, 16.f, Result.Generator.Arena, Backend);
+
+    for(uint32_t Page = 0; Page < TestAtlasPages; ++Page)
+    {
+        Result.Atlas.Pages[Page] = static_cast<uint8_t *>(calloc(TestAtlasSize, TestAtlasSize));
+    }
+
+    return Result;
+}
+
+
+static void
+ReleaseTestGenerator(test_generator &Test, backend_context Backend)
+{
+    ReleaseFont(&Test.Font, Backend);
+
+    for(uint32_t Page = 0; Page < TestAtlasPages; ++Page)
+    {
+        free(Test.Atlas.Pages[Page]);
+    }
+
+    free(Test.Generator.Arena);
+}
+
+
+static void
+ApplyUpdateList(rasterized_glyph_list &List, test_atlas &Atlas)
+{
+    for(rasterized_glyph_node *Node = List.First; Node; Node = Node->Next)
+    {
+        rasterized_buffer &Buffer = Node->Value.Buffer;
+        uint32_t           Stride = Buffer.Stride ? Buffer.Stride : Buffer.Width;
+        uint8_t           *Plane  = Atlas.Pages[Node->Value.AtlasPage];
+
+        for(uint32_t Y = 0; Y < Buffer.Height; ++Y)
+        {
+            uint64_t Offset = (static_cast<uint64_t>(Node->Value.Source.Top) + Y) * TestAtlasSize + static_cast<uint64_t>(Node->Value.Source.Left);
+            memcpy(Plane + Offset, static_cast<uint8_t *>(Buffer.Data) + (Y * Stride), Buffer.Width);
+        }
+    }
+}
+
+
+static bool
+IsSameGlyphImage(const shaped_glyph &Glyph, test_atlas &Atlas, const shaped_glyph &Expected, test_atlas &ExpectedAtlas)
+{
+    uint32_t Width  = static_cast<uint32_t>(Glyph.Source.Right  - Glyph.Source.Left);
+    uint32_t Height = static_cast<uint32_t>(Glyph.Source.Bottom - Glyph.Source.Top);
+
+    bool Result = Width  == static_cast<uint32_t>(Expected.Source.Right  - Expected.Source.Left) &&
+                  Height == static_cast<uint32_t>(Expected.Source.Bottom - Expected.Source.Top);
+
+    for(uint32_t Y = 0; Result && Y < Height; ++Y)
+    {
+        const uint8_t *Row         = Atlas.Pages[Glyph.AtlasPage] +
+                                     (static_cast<uint64_t>(Glyph.Source.Top) + Y) * TestAtlasSize + static_cast<uint64_t>(Glyph.Source.Left);
+        const uint8_t *ExpectedRow = ExpectedAtlas.Pages[Expected.AtlasPage] +
+                                     (static_cast<uint64_t>(Expected.Source.Top) + Y) * TestAtlasSize + static_cast<uint64_t>(Expected.Source.Left);
+
+        Result = memcmp(Row, ExpectedRow, Width) == 0;
+    }
+
+    return Result;
+}
+
+
+static int
+EncodeUtf8(uint32_t Codepoint, char *Out)
+{
+    int Result = 0;
+
+    if(Codepoint < 0x80)
+    {
+        Out[Result++] = static_cast<char>(Codepoint);
+    }
+    else if(Codepoint < 0x800)
+    {
+        Out[Result++] = static_cast<char>(0xC0 | (Codepoint >> 6));
+        Out[Result++] = static_cast<char>(0x80 | (Codepoint & 0x3F));
+    }
+    else
+    {
+        Out[Result++] = static_cast<char>(0xE0 | (Codepoint >> 12));
+        Out[Result++] = static_cast<char>(0x80 | ((Codepoint >> 6) & 0x3F));
+        Out[Result++] = static_cast<char>(0x80 | (Codepoint & 0x3F));
+    }
+
+    return Result;
+}
+
+
+// Codepoints U+0021 + [First, First + Count), each once.
+
+static int
+EncodeTestText(uint32_t First, uint32_t Count, char *Out)
+{
+    int Result = 0;
+    for(uint32_t Idx = First; Idx < First + Count; ++Idx)
+    {
+        Result += EncodeUtf8(0x21 + Idx, Out + Result);
+    }
+
+    return Result;
+}
+
+
+static shaped_glyph_run
+FillTestAtlas(char *Text, int TextSize, test_generator &Test, backend_context Backend)
+{
+    analysed_text    Analysed = AnalyzeText(Text, TextSize, TextAnalysis::SkipComplexCheck, Test.Generator);
+    shaped_glyph_run Result   = FillAtlas(Analysed, Test.Generator, Test.Font, Backend);
+
+    ApplyUpdateList(Result.UpdateList, Test.Atlas);
+
+    return Result;
+}
+
+
+// The reference warms up on runs of 200 codepoints and grows in between, then takes the whole text
+// twice: the first time adds the variants of the pen positions of that text, the second must only hit.
+
+static shaped_glyph_run
+ShapeReference(char *Text, int TextSize, test_generator &Reference, backend_context Backend)
+{
+    static char Chunk[200 * 3];
+    for(uint32_t First = 0; First < TestGlyphCount; First += 200)
+    {
+        int ChunkSize = EncodeTestText(First, 200, Chunk);
+        FillTestAtlas(Chunk, ChunkSize, Reference, Backend);
+    }
+
+    FillTestAtlas(Text, TextSize, Reference, Backend);
+
+    shaped_glyph_run Result = FillTestAtlas(Text, TextSize, Reference, Backend);
+    return Result;
+}
+
+
+static bool
+IsSameGlyph(const shaped_glyph &Glyph, test_atlas &Atlas, const shaped_glyph &Expected, test_atlas &ExpectedAtlas)
+{
+    bool Result = Glyph.Layout.OffsetX == Expected.Layout.OffsetX && Glyph.Layout.OffsetY == Expected.Layout.OffsetY &&
+                  IsSameGlyphImage(Glyph, Atlas, Expected, ExpectedAtlas);
+    return Result;
+}
+
+
+static uint32_t
+CheckOverfullRun(uint8_t SubpixelBins, const char *FontPath, backend_context Backend)
+{
+    // The default table keeps 896 glyphs, the references grow until they hold the whole run.
+    test_generator Small     = CreateTestGenerator(0,   SubpixelBins, FontPath, Backend);
+    test_generator Reference = CreateTestGenerator(512, SubpixelBins, FontPath, Backend);
+    test_generator Whole     = CreateTestGenerator(512, 1,            FontPath, Backend);
+
+    // Every codepoint once, then the first hundred again so some of the run hits what it inserted itself.
+    static char Text[(TestGlyphCount + 100) * 3];
+    int         TextSize = EncodeTestText(0, TestGlyphCount, Text);
+    TextSize += EncodeTestText(0, 100, Text + TextSize);
+
+    shaped_glyph_run Expected      = ShapeReference(Text, TextSize, Reference, Backend);
+    shaped_glyph_run ExpectedWhole = ShapeReference(Text, TextSize, Whole, Backend);
+
+    // Fill the small table with other glyphs first, the run has to evict those and only those.
+    static char Other[600 * 3];
+    int         OtherSize = EncodeTestText(TestGlyphCount, 600, Other);
+    FillTestAtlas(Other, OtherSize, Small, Backend);
+
+    shaped_glyph_run Run = FillTestAtlas(Text, TextSize, Small, Backend);
+
+    uint32_t Failures  = 0;
+    uint32_t Uncached  = 0;
+    uint32_t Fallbacks = 0;
+
+    if(Expected.UpdateList.Count || ExpectedWhole.UpdateList.Count || Run.ShapedCount != Expected.ShapedCount)
+    {
+        printf("the references did not hold the whole run\n");
+        Failures += 1;
+    }
+
+    for(uint32_t Idx = 0; Idx < Run.ShapedCount && Failures < 10; ++Idx)
+    {
+        shaped_glyph &Glyph     = Run.Shaped[Idx];
+        shaped_glyph &Want      = Expected.Shaped[Idx];
+        shaped_glyph &WantWhole = ExpectedWhole.Shaped[Idx];
+
+        bool IsValid = Glyph.GlyphIndex == Want.GlyphIndex && Glyph.Layout.Advance == Want.Layout.Advance;
+        if(Glyph.Source.Right > Glyph.Source.Left)
+        {
+            bool IsVariant = IsSameGlyph(Glyph, Small.Atlas, Want, Reference.Atlas);
+            bool IsWhole   = !IsVariant && IsSameGlyph(Glyph, Small.Atlas, WantWhole, Whole.Atlas);
+
+            IsValid    = IsValid && (IsVariant || IsWhole);
+            Fallbacks += IsWhole;
+        }
+        else
+        {
+            Uncached += Want.Source.Right > Want.Source.Left;
+        }
+
+        if(!IsValid)
+        {
+            printf("bins %u: glyph %u (U+%04X) does not match the reference\n", SubpixelBins, Idx, 0x21 + (Glyph.ClusterStart % TestGlyphCount));
+            Failures += 1;
+        }
+    }
+
+    printf("bins %u: %u glyphs, %u evicted, %u left out of the atlas, %u whole-pixel fallbacks, %u failures\n",
+           SubpixelBins, Run.ShapedCount, Run.EvictedList.Count, Uncached, Fallbacks, Failures);
+
+    ReleaseTestGenerator(Small, Backend);
+    ReleaseTestGenerator(Reference, Backend);
+    ReleaseTestGenerator(Whole, Backend);
+
+    return Failures;
+}
+
+
+int main()
+{
+    const char     *FontPath = NTEXT_BENCH_FONT_DIR "DejaVuSans.ttf";
+    backend_context Backend  = InitializeBackendContext();
+
+    memory_arena *Probe     = CreateBenchArena(16ull << 20);
+    system_font   ProbeFont = Probe ? LoadFontFromFile(FontPath, 16.f, Probe, Backend) : system_font{};
+
+    if(!IsValidSystemFont(&ProbeFont))
+    {
+        printf("skipped: %s could not be loaded\n", FontPath);
+        return 0;
+    }
+
+    ReleaseFont(&ProbeFont, Backend);
+    free(Probe);
+
+    uint32_t Failures = 0;
+    Failures += CheckOverfullRun(1, FontPath, Backend);
+    Failures += CheckOverfullRun(4, FontPath, Backend);
+
+    return Failures ? 1 : 0;
+}
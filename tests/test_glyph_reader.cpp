@@ -0,0 +1,246 @@
+// Readers on other threads look glyphs up while the writer keeps evicting and inserting them. The
+// writer goes over more codepoints than the table keeps, so slots change hands all the time. Every
+// hit a reader gets has to be the whole entry of its own codepoint, as a single threaded generator
+// large enough for all of them shapes it: a copy torn by the writer shows up as a mismatch.
+
+#include "../bench/bench.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace ntext;
+
+constexpr uint32_t TestGlyphCount  = 3000;
+constexpr uint32_t TestChunkSize   = 100;
+constexpr uint32_t TestPassCount   = 12;
+constexpr uint32_t TestReaderCount = 4;
+
+
+struct expected_glyph
+{
+    uint16_t          GlyphIndex;
+    uint16_t          Width;
+    uint16_t          Height;
+    glyph_layout_info Layout;
+};
+
+
+struct reader_result
+{
+    uint64_t Hits;
+    uint64_t Misses;
+    uint64_t Mismatches;
+};
+
+
+static glyph_generator
+CreateTestGenerator(uint32_t MaxGroupCount)
+{
+    glyph_generator_params Params =
+    {
+        .TextStorage             = TextStorage::LazyAtlas,
+        .FrameMemoryBudget       = 256ull << 20,
+        .FrameMemory             = malloc(256ull << 20),
+        .CacheSizeX              = 2048,
+        .CacheSizeY              = 2048,
+        .GlyphTableMaxGroupCount = MaxGroupCount,
+        .AtlasPageCount          = 2,
+        .AtlasPacker             = RectanglePacker::Guillotine,
+    };
+
+    glyph_generator Result = CreateGlyphGenerator(Params);
+    return Result;
+}
+
+
+static uint32_t
+GetTestCodepoint(uint32_t Idx)
+{
+    uint32_t Result = 0x21 + Idx;
+    return Result;
+}
+
+
+// Codepoints [First, First + Count) of the test range as UTF-8.
+
+static int
+EncodeTestText(uint32_t First, uint32_t Count, char *Out)
+{
+    int Result = 0;
+    for(uint32_t Idx = First; Idx < First + Count; ++Idx)
+    {
+        uint32_t Codepoint = GetTestCodepoint(Idx);
+
+        if(Codepoint < 0x80)
+        {
+            Out[Result++] = static_cast<char>(Codepoint);
+        }
+        else if(Codepoint < 0x800)
+        {
+            Out[Result++] = static_cast<char>(0xC0 | (Codepoint >> 6));
+            Out[Result++] = static_cast<char>(0x80 | (Codepoint & 0x3F));
+        }
+        else
+        {
+            Out[Result++] = static_cast<char>(0xE0 | (Codepoint >> 12));
+            Out[Result++] = static_cast<char>(0x80 | ((Codepoint >> 6) & 0x3F));
+            Out[Result++] = static_cast<char>(0x80 | (Codepoint & 0x3F));
+        }
+    }
+
+    return Result;
+}
+
+
+// Shapes the chunk starting at First and hands every glyph to Visit along with its codepoint index.
+// Without the complex check every codepoint gives exactly one glyph, in order.
+
+template <typename Visitor> static void
+ShapeTestChunk(uint32_t First, glyph_generator &Generator, system_font Font, backend_context Backend, Visitor Visit)
+{
+    static char Text[TestChunkSize * 3];
+    int         TextSize = EncodeTestText(First, TestChunkSize, Text);
+
+    memory_region Region = EnterMemoryRegion(Generator.Arena);
+
+    analysed_text    Analysed = AnalyzeText(Text, TextSize, TextAnalysis::SkipComplexCheck, Generator);
+    shaped_glyph_run Run      = FillAtlas(Analysed, Generator, Font, Backend);
+
+    for(uint32_t Idx = 0; Idx < Run.ShapedCount; ++Idx)
+    {
+        Visit(First + Idx, Run.Shaped[Idx]);
+    }
+
+    LeaveMemoryRegion(Region);
+}
+
+
+static bool
+IsExpectedGlyph(const glyph_state &State, const expected_glyph &Expected)
+{
+    bool Result = State.GlyphIndex                               == Expected.GlyphIndex    &&
+                  static_cast<uint16_t>(State.Source.Right  - State.Source.Left) == Expected.Width  &&
+                  static_cast<uint16_t>(State.Source.Bottom - State.Source.Top)  == Expected.Height &&
+                  State.Layout.Advance                           == Expected.Layout.Advance &&
+                  State.Layout.OffsetX                           == Expected.Layout.OffsetX &&
+                  State.Layout.OffsetY                           == Expected.Layout.OffsetY;
+    return Result;
+}
+
+
+int main()
+{
+    const char     *FontPath = NTEXT_BENCH_FONT_DIR "DejaVuSans.ttf";
+    backend_context Backend  = InitializeBackendContext();
+
+    // The reference grows until it holds every codepoint, so it never evicts.
+    glyph_generator Reference     = CreateTestGenerator(512);
+    system_font     ReferenceFont = LoadFontFromFile(FontPath, 16.f, Reference.Arena, Backend);
+
+    if(!IsValidSystemFont(&ReferenceFont))
+    {
+        printf("skipped: %s could not be loaded\n", FontPath);
+        return 0;
+    }
+
+    static expected_glyph Expected[TestGlyphCount];
+
+    for(uint32_t First = 0; First < TestGlyphCount; First += TestChunkSize)
+    {
+        ShapeTestChunk(First, Reference, ReferenceFont, Backend, [](uint32_t Idx, const shaped_glyph &Glyph)
+        {
+            Expected[Idx] =
+            {
+                .GlyphIndex = Glyph.GlyphIndex,
+                .Width      = static_cast<uint16_t>(Glyph.Source.Right  - Glyph.Source.Left),
+                .Height     = static_cast<uint16_t>(Glyph.Source.Bottom - Glyph.Source.Top),
+                .Layout     = Glyph.Layout,
+            };
+        });
+    }
+
+    // The default table keeps 896 glyphs and cannot grow, readers are not allowed with growth.
+    glyph_generator Generator = CreateTestGenerator(0);
+    system_font     Font      = LoadFontFromFile(FontPath, 16.f, Generator.Arena, Backend);
+
+    glyph_reader      Readers[TestReaderCount];
+    reader_result     Results[TestReaderCount] = {};
+    std::thread       Threads[TestReaderCount];
+    std::atomic<bool> IsDone{false};
+
+    for(uint32_t ReaderIdx = 0; ReaderIdx < TestReaderCount; ++ReaderIdx)
+    {
+        Readers[ReaderIdx] = CreateGlyphReader(Generator);
+    }
+
+    for(uint32_t ReaderIdx = 0; ReaderIdx < TestReaderCount; ++ReaderIdx)
+    {
+        Threads[ReaderIdx] = std::thread([&, ReaderIdx]()
+        {
+            reader_result &Result = Results[ReaderIdx];
+            uint64_t       Seed   = 0x9E3779B97F4A7C15ull * (ReaderIdx + 1);
+
+            while(!IsDone.load(std::memory_order_relaxed))
+            {
+                Seed ^= Seed << 13;
+                Seed ^= Seed >> 7;
+                Seed ^= Seed << 17;
+
+                uint32_t    Idx   = static_cast<uint32_t>(Seed % TestGlyphCount);
+                glyph_state State = {};
+
+                if(ReadCachedGlyph(GetTestCodepoint(Idx), Font, Readers[ReaderIdx], &State))
+                {
+                    Result.Hits       += 1;
+                    Result.Mismatches += !IsExpectedGlyph(State, Expected[Idx]);
+                }
+                else
+                {
+                    Result.Misses += 1;
+                }
+            }
+        });
+    }
+
+    uint64_t WriterMismatches = 0;
+
+    for(uint32_t Pass = 0; Pass < TestPassCount; ++Pass)
+    {
+        for(uint32_t First = 0; First < TestGlyphCount; First += TestChunkSize)
+        {
+            ShapeTestChunk(First, Generator, Font, Backend, [&](uint32_t Idx, const shaped_glyph &Glyph)
+            {
+                // Glyphs the atlas had no room for come back without a source, only the rest is compared.
+                bool HasSource = Glyph.Source.Right > Glyph.Source.Left;
+
+                WriterMismatches += Glyph.GlyphIndex != Expected[Idx].GlyphIndex ||
+                                    (HasSource && static_cast<uint16_t>(Glyph.Source.Right - Glyph.Source.Left) != Expected[Idx].Width);
+            });
+        }
+    }
+
+    IsDone.store(true, std::memory_order_relaxed);
+
+    reader_result Total = {};
+    for(uint32_t ReaderIdx = 0; ReaderIdx < TestReaderCount; ++ReaderIdx)
+    {
+        Threads[ReaderIdx].join();
+
+        Total.Hits       += Results[ReaderIdx].Hits;
+        Total.Misses     += Results[ReaderIdx].Misses;
+        Total.Mismatches += Results[ReaderIdx].Mismatches;
+    }
+
+    printf("%u readers: %llu hits, %llu misses, %llu torn or wrong, writer %llu wrong\n", TestReaderCount,
+           static_cast<unsigned long long>(Total.Hits), static_cast<unsigned long long>(Total.Misses),
+           static_cast<unsigned long long>(Total.Mismatches), static_cast<unsigned long long>(WriterMismatches));
+
+    ReleaseFont(&Font, Backend);
+    ReleaseFont(&ReferenceFont, Backend);
+    free(Generator.Arena);
+    free(Reference.Arena);
+
+    // Readers that never hit tested nothing.
+    bool IsValid = Total.Hits && !Total.Mismatches && !WriterMismatches;
+    return IsValid ? 0 : 1;
+}
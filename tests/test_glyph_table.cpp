@@ -0,0 +1,497 @@
+// The glyph table on its own, without fonts. Key K is stored with GlyphIndex K, so every hit can be
+// checked against the key it was looked up with. After each scenario the table has to be consistent:
+// the counts match the metadata, the LRU list goes over every live slot once, and every live entry is
+// found again by its own hash.
+
+#include "../bench/bench.h"
+
+using namespace ntext;
+
+constexpr uint64_t TestKeySpace = 0x0000000C00000001ull;
+
+
+static glyph_hash
+GetTestHash(uint32_t Key)
+{
+    glyph_hash Result = ComputeSingleGlyphHash(Key, TestKeySpace, DefaultSeed);
+    return Result;
+}
+
+
+static glyph_table *
+CreateTestTable(uint64_t GroupCount, memory_arena *Arena)
+{
+    glyph_table_params Params = {.GroupWidth = GlyphTableWidth::_128Bits, .GroupCount = GroupCount};
+    void              *Memory = PushArena(Arena, GetGlyphTableFootprint(Params), AlignOf(void *));
+
+    glyph_table *Result = PlaceGlyphTableInMemory(Params, Memory);
+    return Result;
+}
+
+
+// Looks Key up the way FillAtlas does: a new entry gets its payload right away.
+
+static glyph_state
+LookupTestKey(uint32_t Key, glyph_table *Table)
+{
+    glyph_state Result = FindGlyphEntryByHash(GetTestHash(Key), Table);
+
+    if(Result.Id != GlyphTableInvalidEntry && !Result.IsRasterized)
+    {
+        UpdateGlyphTableEntry(Result.Id, true, static_cast<uint16_t>(Key), {}, {}, 0, Table);
+    }
+
+    return Result;
+}
+
+
+// Whether Key is in the table or in the one it grows out of, without touching the LRU.
+
+static bool
+HasTestKey(uint32_t Key, glyph_table *Table)
+{
+    bool Result = false;
+
+    for(glyph_table *Search = Table; Search && !Result; Search = Search->Previous)
+    {
+        glyph_probe Probe = ProbeGlyphTable(GetTestHash(Key), Search);
+        Result = Probe.EntryIndex != GlyphTableInvalidEntry && GetGlyphEntry(Probe.EntryIndex, Search)->GlyphIndex == Key;
+    }
+
+    return Result;
+}
+
+
+static uint32_t
+CheckTableConsistency(const char *Scenario, glyph_table *Table)
+{
+    uint32_t Failures = 0;
+
+    for(glyph_table *Check = Table; Check; Check = Check->Previous)
+    {
+        uint64_t SlotCount = Check->GroupCount * Check->GroupWidth;
+        uint32_t FullCount = 0;
+        uint32_t DeadCount = 0;
+
+        for(uint64_t Idx = 0; Idx < SlotCount; ++Idx)
+        {
+            uint8_t Meta   = Check->Metadata[Idx];
+            bool    IsFull = (Meta & (GlyphTableEmptyMask | GlyphTableDeadMask)) == 0;
+
+            FullCount += IsFull;
+            DeadCount += (Meta & GlyphTableDeadMask) != 0;
+
+            // Every live entry is reachable through its own hash and holds its own key.
+            if(IsFull)
+            {
+                glyph_probe Probe = ProbeGlyphTable(Check->Hashes[Idx], Check);
+                uint32_t    Key   = GetGlyphEntry(Idx, Check)->GlyphIndex;
+
+                if(Probe.EntryIndex != Idx || !GlyphHashesAreEqual(Check->Hashes[Idx], GetTestHash(Key)))
+                {
+                    printf("%s: slot %llu (key %u) is not reachable\n", Scenario, static_cast<unsigned long long>(Idx), Key);
+                    Failures += 1;
+                }
+            }
+        }
+
+        uint32_t Linked = 0;
+        for(uint32_t Index = GetGlyphTableSentinel(Check)->NextLRU; Index != Check->SentinelIndex && Linked <= FullCount;
+            Index = Check->Links[Index].NextLRU)
+        {
+            bool IsFull = (Check->Metadata[Index] & (GlyphTableEmptyMask | GlyphTableDeadMask)) == 0;
+            Failures   += !IsFull;
+            Linked     += 1;
+        }
+
+        if(FullCount != Check->Count || DeadCount != Check->DeadCount || Linked != Check->Count)
+        {
+            printf("%s: count %u dead %u linked %u, the metadata holds %u live and %u dead\n", Scenario,
+                   Check->Count, Check->DeadCount, Linked, FullCount, DeadCount);
+            Failures += 1;
+        }
+    }
+
+    return Failures;
+}
+
+
+// Grows a table holding 100 keys and keeps looking keys up while the entries migrate: old keys have to
+// hit with their own payload wherever they are, new ones go in the new table, and nothing is evicted
+// since the larger table has room for all of them.
+
+static uint32_t
+CheckGrowth(memory_arena *Arena)
+{
+    memory_region Region = EnterMemoryRegion(Arena);
+
+    glyph_table *Table    = CreateTestTable(8, Arena);
+    uint32_t     Failures = 0;
+
+    for(uint32_t Key = 0; Key < 100; ++Key)
+    {
+        LookupTestKey(Key, Table);
+    }
+
+    Table = GrowGlyphTable(Table, Arena);
+
+    uint32_t MidMigration = 0;
+    for(uint32_t Step = 0; Step < 200; ++Step)
+    {
+        // Old keys oldest first: those migrate last, so the first ones are still in the previous table.
+        uint32_t    Key   = Step % 2 ? Step / 2 : 100 + Step / 2;
+        bool        IsOld = Key < 100;
+        glyph_state State = LookupTestKey(Key, Table);
+
+        MidMigration += Table->Previous != 0;
+
+        // Both tables at once, half way through.
+        if(Step == 2 && Table->Previous)
+        {
+            Failures += CheckTableConsistency("growth, migrating", Table);
+        }
+
+        bool IsValid = State.Id != GlyphTableInvalidEntry && State.EvictedId == GlyphTableInvalidEntry &&
+                       State.IsRasterized == IsOld && (!IsOld || State.GlyphIndex == Key);
+        if(!IsValid)
+        {
+            printf("growth: key %u came back as id %u, glyph %u, evicting %u\n", Key, State.Id, State.GlyphIndex, State.EvictedId);
+            Failures += 1;
+        }
+    }
+
+    if(!MidMigration || Table->Previous)
+    {
+        printf("growth: %u lookups during the migration, %s\n", MidMigration, Table->Previous ? "still migrating" : "done");
+        Failures += 1;
+    }
+
+    for(uint32_t Key = 0; Key < 200; ++Key)
+    {
+        if(!HasTestKey(Key, Table))
+        {
+            printf("growth: key %u was lost\n", Key);
+            Failures += 1;
+        }
+    }
+
+    Failures += CheckTableConsistency("growth", Table);
+
+    printf("growth: %u lookups while migrating, %u failures\n", MidMigration, Failures);
+
+    LeaveMemoryRegion(Region);
+
+    return Failures;
+}
+
+
+// Keys in LRU order, most recent first. Returns how many.
+
+static uint32_t
+GetTestKeysByRecency(glyph_table *Table, uint32_t *Keys, uint32_t MaxCount)
+{
+    uint32_t Result = 0;
+
+    for(uint32_t Index = GetGlyphTableSentinel(Table)->NextLRU; Index != Table->SentinelIndex && Result < MaxCount;
+        Index = Table->Links[Index].NextLRU)
+    {
+        Keys[Result++] = GetGlyphEntry(Index, Table)->GlyphIndex;
+    }
+
+    return Result;
+}
+
+
+// Removes a third of the keys and puts them back, twenty times over in a table small enough that
+// probe sequences cross each other's tombstones. Removed keys have to be gone, the others found across
+// the tombstones, and the keys that come back are new entries that evict nothing.
+
+static uint32_t
+CheckTombstones(memory_arena *Arena)
+{
+    memory_region Region = EnterMemoryRegion(Arena);
+
+    glyph_table *Table    = CreateTestTable(4, Arena);
+    uint32_t     Failures = 0;
+    uint32_t     MaxDead  = 0;
+
+    for(uint32_t Key = 0; Key < 50; ++Key)
+    {
+        LookupTestKey(Key, Table);
+    }
+
+    for(uint32_t Round = 0; Round < 20 && !Failures; ++Round)
+    {
+        for(uint32_t Key = 0; Key < 50; ++Key)
+        {
+            if((Key + Round) % 3 == 0)
+            {
+                glyph_state Removed = RemoveGlyphEntry(GetTestHash(Key), Table);
+                glyph_state Again   = RemoveGlyphEntry(GetTestHash(Key), Table);
+
+                if(Removed.Id == GlyphTableInvalidEntry || Removed.GlyphIndex != Key || Again.Id != GlyphTableInvalidEntry)
+                {
+                    printf("tombstones: removing key %u gave id %u (glyph %u), then id %u\n", Key, Removed.Id, Removed.GlyphIndex, Again.Id);
+                    Failures += 1;
+                }
+            }
+        }
+
+        MaxDead = Table->DeadCount > MaxDead ? Table->DeadCount : MaxDead;
+
+        for(uint32_t Key = 0; Key < 50; ++Key)
+        {
+            bool IsRemoved = (Key + Round) % 3 == 0;
+            if(HasTestKey(Key, Table) == IsRemoved)
+            {
+                printf("tombstones: round %u, key %u is %s\n", Round, Key, IsRemoved ? "still there" : "missing");
+                Failures += 1;
+            }
+        }
+
+        Failures += CheckTableConsistency("tombstones, removed", Table);
+
+        for(uint32_t Key = 0; Key < 50; ++Key)
+        {
+            if((Key + Round) % 3 == 0)
+            {
+                glyph_state State = LookupTestKey(Key, Table);
+                if(State.Id == GlyphTableInvalidEntry || State.IsRasterized || State.EvictedId != GlyphTableInvalidEntry)
+                {
+                    printf("tombstones: key %u came back as id %u, %s, evicting %u\n", Key, State.Id,
+                           State.IsRasterized ? "stale" : "new", State.EvictedId);
+                    Failures += 1;
+                }
+            }
+        }
+
+        Failures += CheckTableConsistency("tombstones, reinserted", Table);
+    }
+
+    printf("tombstones: up to %u dead slots, %u failures\n", MaxDead, Failures);
+
+    LeaveMemoryRegion(Region);
+
+    return Failures;
+}
+
+
+// Cleanup rebuilds the table in place: the tombstones go, every live key stays reachable and
+// the LRU order is the same as before.
+
+static uint32_t
+CheckCleanup(memory_arena *Arena)
+{
+    memory_region Region = EnterMemoryRegion(Arena);
+
+    glyph_table *Table    = CreateTestTable(8, Arena);
+    uint32_t     Failures = 0;
+
+    for(uint32_t Key = 0; Key < 100; ++Key)
+    {
+        LookupTestKey(Key, Table);
+    }
+
+    for(uint32_t Key = 0; Key < 100; ++Key)
+    {
+        if(Key % 5 < 2)
+        {
+            RemoveGlyphEntry(GetTestHash(Key), Table);
+        }
+    }
+
+    // Shuffle the recency a little, so the order kept is not just the insertion order.
+    for(uint32_t Key = 50; Key < 60; ++Key)
+    {
+        if(Key % 5 >= 2)
+        {
+            LookupTestKey(Key, Table);
+        }
+    }
+
+    uint32_t Before[100];
+    uint32_t After[100];
+    uint32_t BeforeCount = GetTestKeysByRecency(Table, Before, 100);
+    uint32_t Epoch       = Table->Epoch;
+
+    if(!NeedsGlyphTableCleanup(Table))
+    {
+        printf("cleanup: %u dead slots do not call for a cleanup\n", Table->DeadCount);
+        Failures += 1;
+    }
+
+    CleanupGlyphTable(Table, Arena, false);
+
+    uint32_t AfterCount = GetTestKeysByRecency(Table, After, 100);
+
+    if(Table->DeadCount || Table->Count != 60 || Table->Epoch == Epoch || AfterCount != BeforeCount ||
+       memcmp(Before, After, BeforeCount * sizeof(uint32_t)) != 0)
+    {
+        printf("cleanup: %u live, %u dead, %u keys in LRU order against %u before\n", Table->Count, Table->DeadCount, AfterCount, BeforeCount);
+        Failures += 1;
+    }
+
+    for(uint32_t Key = 0; Key < 100; ++Key)
+    {
+        if(HasTestKey(Key, Table) != (Key % 5 >= 2))
+        {
+            printf("cleanup: key %u is %s\n", Key, Key % 5 >= 2 ? "missing" : "back");
+            Failures += 1;
+        }
+    }
+
+    Failures += CheckTableConsistency("cleanup", Table);
+
+    printf("cleanup: %u keys kept, %u failures\n", AfterCount, Failures);
+
+    LeaveMemoryRegion(Region);
+
+    return Failures;
+}
+
+
+static bool
+IsSameGlyphState(const glyph_state &A, const glyph_state &B)
+{
+    bool Result = A.Id == B.Id && A.GlyphIndex == B.GlyphIndex && A.IsRasterized == B.IsRasterized && A.EvictedId == B.EvictedId;
+    return Result;
+}
+
+
+// Slots that are not live hold whatever the memory held, only the live ones and the sentinel are compared.
+
+static bool
+IsSameGlyphTable(glyph_table *A, glyph_table *B)
+{
+    uint64_t SlotCount = A->GroupCount * A->GroupWidth;
+
+    bool Result = A->GroupCount == B->GroupCount && A->Count == B->Count && A->DeadCount == B->DeadCount &&
+                  (A->Previous != 0) == (B->Previous != 0) && memcmp(A->Metadata, B->Metadata, SlotCount) == 0 &&
+                  memcmp(GetGlyphTableSentinel(A), GetGlyphTableSentinel(B), sizeof(glyph_lru_link)) == 0;
+
+    for(uint64_t Idx = 0; Result && Idx < SlotCount; ++Idx)
+    {
+        if((A->Metadata[Idx] & (GlyphTableEmptyMask | GlyphTableDeadMask)) == 0)
+        {
+            Result = GlyphHashesAreEqual(A->Hashes[Idx], B->Hashes[Idx]) &&
+                     memcmp(&A->Links[Idx],   &B->Links[Idx],   sizeof(glyph_lru_link)) == 0 &&
+                     memcmp(&A->Buckets[Idx], &B->Buckets[Idx], sizeof(glyph_entry))    == 0;
+        }
+    }
+
+    return Result;
+}
+
+
+// The batch lookup has to do exactly what the same lookups one by one do, evictions included. Two
+// identical tables take the same random keys (more than they hold), one in batches of 1 to 40, the other
+// one at a time, and both get the same payloads once the batch is done. Half way, both grow and the
+// batches go on during the migration.
+
+static uint32_t
+CheckBatchLookup(memory_arena *Arena)
+{
+    memory_region Region = EnterMemoryRegion(Arena);
+
+    glyph_table *Batched  = CreateTestTable(4, Arena);
+    glyph_table *Scalar   = CreateTestTable(4, Arena);
+    uint32_t     Failures = 0;
+    uint32_t     Evicted  = 0;
+    uint64_t     Seed     = 0x9E3779B97F4A7C15ull;
+
+    uint32_t    Keys[40];
+    glyph_hash  Hashes[40];
+    glyph_state BatchStates[40];
+    glyph_state ScalarStates[40];
+
+    for(uint32_t Round = 0; Round < 200 && !Failures; ++Round)
+    {
+        if(Round == 100)
+        {
+            Batched = GrowGlyphTable(Batched, Arena);
+            Scalar  = GrowGlyphTable(Scalar,  Arena);
+        }
+
+        Seed ^= Seed << 13;
+        Seed ^= Seed >> 7;
+        Seed ^= Seed << 17;
+
+        uint32_t Count = 1 + static_cast<uint32_t>(Seed % 40);
+
+        for(uint32_t Idx = 0; Idx < Count; ++Idx)
+        {
+            Seed ^= Seed << 13;
+            Seed ^= Seed >> 7;
+            Seed ^= Seed << 17;
+
+            Keys[Idx]   = static_cast<uint32_t>(Seed % 120);
+            Hashes[Idx] = GetTestHash(Keys[Idx]);
+        }
+
+        FindGlyphEntriesByHashBatch(Hashes, Count, BatchStates, Batched);
+
+        for(uint32_t Idx = 0; Idx < Count; ++Idx)
+        {
+            ScalarStates[Idx] = FindGlyphEntryByHash(Hashes[Idx], Scalar);
+
+            if(!IsSameGlyphState(BatchStates[Idx], ScalarStates[Idx]))
+            {
+                printf("batch: round %u, key %u gave id %u (evicting %u) against %u (evicting %u) one by one\n", Round, Keys[Idx],
+                       BatchStates[Idx].Id, BatchStates[Idx].EvictedId, ScalarStates[Idx].Id, ScalarStates[Idx].EvictedId);
+                Failures += 1;
+            }
+
+            Evicted += ScalarStates[Idx].EvictedId != GlyphTableInvalidEntry;
+        }
+
+        // Like FillAtlas, payloads are written once the lookups are done. A key seen twice is only new once.
+        for(uint32_t Idx = 0; Idx < Count; ++Idx)
+        {
+            if(!ScalarStates[Idx].IsRasterized && ScalarStates[Idx].Id != GlyphTableInvalidEntry)
+            {
+                UpdateGlyphTableEntry(BatchStates[Idx].Id,  true, static_cast<uint16_t>(Keys[Idx]), {}, {}, 0, Batched);
+                UpdateGlyphTableEntry(ScalarStates[Idx].Id, true, static_cast<uint16_t>(Keys[Idx]), {}, {}, 0, Scalar);
+            }
+        }
+
+        if(!IsSameGlyphTable(Batched, Scalar) || (Batched->Previous && !IsSameGlyphTable(Batched->Previous, Scalar->Previous)))
+        {
+            printf("batch: round %u, the tables differ\n", Round);
+            Failures += 1;
+        }
+    }
+
+    Failures += CheckTableConsistency("batch", Batched);
+
+    if(!Evicted)
+    {
+        printf("batch: nothing was evicted\n");
+        Failures += 1;
+    }
+
+    printf("batch: %u evictions, %u failures\n", Evicted, Failures);
+
+    LeaveMemoryRegion(Region);
+
+    return Failures;
+}
+
+
+int main()
+{
+    memory_arena *Arena = CreateBenchArena(16ull << 20);
+    if(!Arena)
+    {
+        return 1;
+    }
+
+    uint32_t Failures = 0;
+    Failures += CheckGrowth(Arena);
+    Failures += CheckTombstones(Arena);
+    Failures += CheckCleanup(Arena);
+    Failures += CheckBatchLookup(Arena);
+
+    free(Arena);
+
+    return Failures ? 1 : 0;
+}
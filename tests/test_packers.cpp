@@ -0,0 +1,194 @@
+// Every packer has to keep what it places inside the page and apart from everything else it placed.
+// The recorded glyph sizes (glyph_sizes.h) are packed one at a time and in batches, with a third of
+// the live rectangles released every round so the free-list packers reuse space. Their free lists are
+// checked as well: in bounds, clear of every live rectangle, and for MaxRects none inside another.
+
+#include "../bench/bench.h"
+
+using namespace ntext;
+
+constexpr uint16_t TestPageSize   = 512;
+constexpr uint32_t TestRoundCount = 8;
+constexpr uint32_t TestRoundSize  = 400;
+constexpr uint32_t TestMaxLive    = TestRoundCount * TestRoundSize;
+
+
+static bool
+DoRectanglesOverlap(uint32_t AX, uint32_t AY, uint32_t AWidth, uint32_t AHeight,
+                    uint32_t BX, uint32_t BY, uint32_t BWidth, uint32_t BHeight)
+{
+    bool Result = AX < BX + BWidth && BX < AX + AWidth && AY < BY + BHeight && BY < AY + AHeight;
+    return Result;
+}
+
+
+static uint32_t
+CheckPackerState(rectangle_packer *Packer, packed_rectangle *Live, uint32_t LiveCount)
+{
+    uint32_t Failures = 0;
+
+    for(uint32_t Idx = 0; Idx < LiveCount; ++Idx)
+    {
+        packed_rectangle &Rectangle = Live[Idx];
+
+        bool IsInside = Rectangle.X + Rectangle.Width <= Packer->Width && Rectangle.Y + Rectangle.Height <= Packer->Height;
+        if(!IsInside)
+        {
+            printf("%u: rectangle %u (%u,%u %ux%u) is out of the page\n", static_cast<uint32_t>(Packer->Kind), Idx,
+                   Rectangle.X, Rectangle.Y, Rectangle.Width, Rectangle.Height);
+            Failures += 1;
+        }
+
+        for(uint32_t Other = Idx + 1; Other < LiveCount; ++Other)
+        {
+            packed_rectangle &With = Live[Other];
+
+            if(DoRectanglesOverlap(Rectangle.X, Rectangle.Y, Rectangle.Width, Rectangle.Height, With.X, With.Y, With.Width, With.Height))
+            {
+                printf("%u: rectangles %u and %u overlap\n", static_cast<uint32_t>(Packer->Kind), Idx, Other);
+                Failures += 1;
+            }
+        }
+    }
+
+    bool HasFreeList = Packer->Kind == RectanglePacker::Guillotine || Packer->Kind == RectanglePacker::MaxRects;
+
+    for(uint32_t Idx = 0; HasFreeList && Idx < Packer->FreeCount; ++Idx)
+    {
+        free_rectangle Free = Packer->FreeRects[Idx];
+
+        if(!Free.Width || !Free.Height || Free.X + Free.Width > Packer->Width || Free.Y + Free.Height > Packer->Height)
+        {
+            printf("%u: free rectangle %u (%u,%u %ux%u) is empty or out of the page\n", static_cast<uint32_t>(Packer->Kind), Idx,
+                   Free.X, Free.Y, Free.Width, Free.Height);
+            Failures += 1;
+        }
+
+        for(uint32_t Other = 0; Other < LiveCount; ++Other)
+        {
+            packed_rectangle &With = Live[Other];
+
+            if(DoRectanglesOverlap(Free.X, Free.Y, Free.Width, Free.Height, With.X, With.Y, With.Width, With.Height))
+            {
+                printf("%u: free rectangle %u overlaps rectangle %u\n", static_cast<uint32_t>(Packer->Kind), Idx, Other);
+                Failures += 1;
+            }
+        }
+
+        for(uint32_t Other = 0; Packer->Kind == RectanglePacker::MaxRects && Other < Packer->FreeCount; ++Other)
+        {
+            if(Other != Idx && IsFreeRectangleInside(Free, Packer->FreeRects[Other]))
+            {
+                printf("%u: free rectangle %u is inside free rectangle %u\n", static_cast<uint32_t>(Packer->Kind), Idx, Other);
+                Failures += 1;
+            }
+        }
+    }
+
+    return Failures;
+}
+
+
+// Every round offers TestRoundSize new rectangles, then releases every third live one.
+
+static uint32_t
+CheckPacker(RectanglePacker Kind, bool Batch, memory_arena *Arena)
+{
+    memory_region Region = EnterMemoryRegion(Arena);
+
+    void             *Memory  = PushArena(Arena, GetRectanglePackerFootprint(Kind, TestPageSize, TestPageSize), AlignOf(rectangle_packer));
+    rectangle_packer *Packer  = PlaceRectanglePackerInMemory(Kind, TestPageSize, TestPageSize, Memory);
+    packed_rectangle *Live    = PushArray<packed_rectangle>(Arena, TestMaxLive);
+    packed_rectangle *Offered = PushArray<packed_rectangle>(Arena, TestRoundSize);
+
+    uint32_t LiveCount   = 0;
+    uint32_t PackedCount = 0;
+    uint32_t Failures    = 0;
+
+    for(uint32_t Round = 0; Round < TestRoundCount && !Failures; ++Round)
+    {
+        SampleGlyphSizes(Offered, TestRoundSize, 0x9E3779B97F4A7C15ull + Round);
+
+        if(Batch)
+        {
+            PackRectangles(Offered, TestRoundSize, Packer, Arena);
+        }
+        else
+        {
+            for(uint32_t Idx = 0; Idx < TestRoundSize; ++Idx)
+            {
+                PackRectangle(Offered[Idx], Packer);
+            }
+        }
+
+        for(uint32_t Idx = 0; Idx < TestRoundSize; ++Idx)
+        {
+            if(Offered[Idx].WasPacked)
+            {
+                Live[LiveCount++] = Offered[Idx];
+                PackedCount      += 1;
+            }
+        }
+
+        Failures += CheckPackerState(Packer, Live, LiveCount);
+
+        uint32_t Kept = 0;
+        for(uint32_t Idx = 0; Idx < LiveCount; ++Idx)
+        {
+            packed_rectangle &Rectangle = Live[Idx];
+
+            if(Idx % 3 == Round % 3)
+            {
+                rectangle Source =
+                {
+                    .Left   = static_cast<float>(Rectangle.X),
+                    .Top    = static_cast<float>(Rectangle.Y),
+                    .Right  = static_cast<float>(Rectangle.X + Rectangle.Width),
+                    .Bottom = static_cast<float>(Rectangle.Y + Rectangle.Height),
+                };
+
+                ReleasePackedRectangle(Source, Packer);
+            }
+            else
+            {
+                Live[Kept++] = Rectangle;
+            }
+        }
+
+        LiveCount = Kept;
+        Failures += CheckPackerState(Packer, Live, LiveCount);
+    }
+
+    printf("packer %u, %s: %u rectangles packed, %u failures\n", static_cast<uint32_t>(Kind), Batch ? "batch" : "one at a time",
+           PackedCount, Failures);
+
+    // A packer that placed nothing proves nothing.
+    Failures += PackedCount == 0;
+
+    LeaveMemoryRegion(Region);
+
+    return Failures;
+}
+
+
+int main()
+{
+    memory_arena *Arena = CreateBenchArena(64ull << 20);
+    if(!Arena)
+    {
+        return 1;
+    }
+
+    RectanglePacker Kinds[] = {RectanglePacker::Skyline, RectanglePacker::Shelf, RectanglePacker::Guillotine, RectanglePacker::MaxRects};
+
+    uint32_t Failures = 0;
+    for(RectanglePacker Kind : Kinds)
+    {
+        Failures += CheckPacker(Kind, false, Arena);
+        Failures += CheckPacker(Kind, true,  Arena);
+    }
+
+    free(Arena);
+
+    return Failures ? 1 : 0;
+}
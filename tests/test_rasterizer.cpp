@@ -0,0 +1,182 @@
+// The SIMD coverage resolve (SSE2, or AVX2 when the build has it) must write the same bytes as
+// the scalar loop, on real glyph rows and on random ones, for every width and tail length.
+// Built twice by CMake, with and without -mavx2.
+
+#include "../bench/bench.h"
+
+using namespace ntext;
+
+static uint32_t TestSeed = 0x9E3779B9u;
+
+static float
+GetTestRandom(void)
+{
+    TestSeed ^= TestSeed << 13;
+    TestSeed ^= TestSeed >> 17;
+    TestSeed ^= TestSeed << 5;
+
+    float Result = static_cast<float>(TestSeed >> 8) / static_cast<float>(1u << 24);
+    return Result;
+}
+
+
+static uint64_t
+CompareCoverageRow(const float *Row, uint32_t Width, uint8_t *Simd, uint8_t *Scalar)
+{
+    ResolveTrueTypeCoverageRow(Row, Simd, Width);
+    ResolveTrueTypeCoverageRowScalar(Row, Scalar, 0, Width, 0);
+
+    uint64_t Result = 0;
+    for(uint32_t X = 0; X < Width; ++X)
+    {
+        Result += Simd[X] != Scalar[X];
+    }
+
+    return Result;
+}
+
+
+// Same steps as RasterizeGlyphToAlphaTexture up to the resolve.
+
+static uint64_t
+CompareGlyphRows(truetype_font *Face, uint16_t GlyphIndex, float Scale, float SubpixelX, uint64_t *PixelCount, memory_arena *Arena)
+{
+    uint64_t Result = 0;
+
+    memory_region Region = EnterMemoryRegion(Arena);
+
+    truetype_pixel_box Box    = GetTrueTypeGlyphPixelBox(Face, GlyphIndex, Scale, SubpixelX);
+    uint32_t           Width  = static_cast<uint32_t>(Box.X1 - Box.X0);
+    uint32_t           Height = static_cast<uint32_t>(Box.Y1 - Box.Y0);
+
+    if(Width > 0 && Height > 0)
+    {
+        truetype_transform Transform =
+        {
+            .A = Scale, .B = 0.f, .C = 0.f, .D = -Scale,
+            .E = static_cast<float>(-Box.X0) + SubpixelX,
+            .F = static_cast<float>(-Box.Y0),
+        };
+
+        truetype_edge_list List = {};
+        List.Capacity = CountTrueTypeGlyphPoints(Face, GlyphIndex, 0) * TrueTypeMaxCurveSteps;
+        List.Edges    = List.Capacity ? PushArray<truetype_edge>(Arena, List.Capacity) : 0;
+
+        if(!List.Edges || !DecodeTrueTypeGlyph(Face, GlyphIndex, Transform, 0, &List, Arena))
+        {
+            List.Count = 0;
+        }
+
+        uint32_t RowStride    = Width + 2;
+        float   *Accumulation = PushArrayAligned<float>(Arena, RowStride * Height, 32);
+        uint8_t *Simd         = PushArray<uint8_t>(Arena, Width);
+        uint8_t *Scalar       = PushArray<uint8_t>(Arena, Width);
+
+        memset(Accumulation, 0, RowStride * Height * sizeof(float));
+        for(uint32_t Idx = 0; Idx < List.Count; ++Idx)
+        {
+            AccumulateTrueTypeEdge(List.Edges[Idx], Accumulation, Width, Height);
+        }
+
+        for(uint32_t Y = 0; Y < Height; ++Y)
+        {
+            Result += CompareCoverageRow(Accumulation + (Y * RowStride), Width, Simd, Scalar);
+        }
+
+        *PixelCount += static_cast<uint64_t>(Width) * Height;
+    }
+
+    LeaveMemoryRegion(Region);
+
+    return Result;
+}
+
+
+int main()
+{
+#if defined(__AVX2__)
+    if(!__builtin_cpu_supports("avx2"))
+    {
+        printf("skipped: the CPU has no AVX2\n");
+        return 0;
+    }
+    const char *Path = "avx2";
+#else
+    const char *Path = "sse2";
+#endif
+
+    memory_arena *Arena = CreateBenchArena(64ull << 20);
+    if(!Arena)
+    {
+        return 1;
+    }
+
+    uint64_t Mismatches = 0;
+    uint64_t PixelCount = 0;
+
+    // Random rows: cell values that sum past +-1 and back, every width up to a few vector lengths.
+    {
+        float   Row[80];
+        uint8_t Simd[80];
+        uint8_t Scalar[80];
+
+        for(uint32_t Round = 0; Round < 2000; ++Round)
+        {
+            for(uint32_t Width = 1; Width <= 80; ++Width)
+            {
+                for(uint32_t X = 0; X < Width; ++X)
+                {
+                    Row[X] = (GetTestRandom() - 0.5f) * ((Round & 1) ? 0.5f : 3.f);
+                }
+
+                Mismatches += CompareCoverageRow(Row, Width, Simd, Scalar);
+                PixelCount += Width;
+            }
+        }
+    }
+
+    // Glyph rows, where exact halves and whole coverages are common.
+    const char *Faces[] = {NTEXT_BENCH_FONT_DIR "DejaVuSans.ttf", NTEXT_BENCH_FONT_DIR "DejaVuSerif-Bold.ttf"};
+    float       Sizes[] = {12.f, 24.f, 48.f, 72.f};
+
+    backend_context Backend   = InitializeBackendContext();
+    uint32_t        FaceCount = 0;
+
+    for(const char *FacePath : Faces)
+    {
+        for(float Size : Sizes)
+        {
+            memory_region Region = EnterMemoryRegion(Arena);
+
+            system_font Font = LoadFontFromFile(FacePath, Size, Arena, Backend);
+            if(IsValidSystemFont(&Font))
+            {
+                truetype_font *Face  = Font.FontFace;
+                float          Scale = Font.Info->Scale;
+
+                for(uint32_t GlyphIndex = 0; GlyphIndex < Face->GlyphCount; GlyphIndex += (Size > 24.f ? 3 : 1))
+                {
+                    Mismatches += CompareGlyphRows(Face, static_cast<uint16_t>(GlyphIndex), Scale, 0.f, &PixelCount, Arena);
+                    Mismatches += CompareGlyphRows(Face, static_cast<uint16_t>(GlyphIndex), Scale, 0.25f, &PixelCount, Arena);
+                }
+
+                ReleaseFont(&Font, Backend);
+                FaceCount += 1;
+            }
+
+            LeaveMemoryRegion(Region);
+        }
+    }
+
+    if(!FaceCount)
+    {
+        printf("no fonts in %s, only random rows were checked\n", NTEXT_BENCH_FONT_DIR);
+    }
+
+    printf("%s: %llu pixels (%u font sizes), %llu mismatches\n", Path,
+           static_cast<unsigned long long>(PixelCount), FaceCount, static_cast<unsigned long long>(Mismatches));
+
+    free(Arena);
+
+    return Mismatches ? 1 : 0;
+}